@@ -50,7 +50,7 @@ bool fileIsEmpty(const std::string fileName) {
 
 bool fileCompare(const std::string leftFileName, const std::string rightFileName) {
     ifstream leftFile, rightFile;
-    char leftRead, rightRead;
+    char leftRead = 0, rightRead = 0;
     bool result;
 
     // Open the two files.
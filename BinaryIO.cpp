@@ -0,0 +1,244 @@
+/**
+ * @file BinaryIO.cpp
+ * @brief This file will contain the definitions of the functions in BinaryIO.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include "BinaryIO.h"
+
+namespace {
+    void encodeBytes(char *buffer, uint64_t value, int nrOfBytes) {
+        for (int i = 0; i < nrOfBytes; ++i) {
+            buffer[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    uint64_t decodeBytes(const char *buffer, int nrOfBytes) {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(buffer);
+        uint64_t value = 0;
+        for (int i = 0; i < nrOfBytes; ++i) {
+            value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    void writeBytes(std::ostream &outStream, uint64_t value, int nrOfBytes) {
+        char bytes[8];
+        encodeBytes(bytes, value, nrOfBytes);
+        outStream.write(bytes, nrOfBytes);
+    }
+
+    bool readBytes(std::istream &inStream, uint64_t &value, int nrOfBytes) {
+        char bytes[8];
+        if (!inStream.read(bytes, nrOfBytes)) {
+            return false;
+        }
+        value = decodeBytes(bytes, nrOfBytes);
+        return true;
+    }
+}
+
+void BinaryIO::writeUInt8(std::ostream &outStream, uint8_t value) {
+    writeBytes(outStream, value, 1);
+}
+
+void BinaryIO::writeInt32(std::ostream &outStream, int32_t value) {
+    writeBytes(outStream, static_cast<uint32_t>(value), 4);
+}
+
+void BinaryIO::writeUInt32(std::ostream &outStream, uint32_t value) {
+    writeBytes(outStream, value, 4);
+}
+
+void BinaryIO::writeUInt64(std::ostream &outStream, uint64_t value) {
+    writeBytes(outStream, value, 8);
+}
+
+void BinaryIO::writeDouble(std::ostream &outStream, double value) {
+    writeBytes(outStream, doubleToBits(value), 8);
+}
+
+void BinaryIO::writeString(std::ostream &outStream, const std::string &value) {
+    writeUInt32(outStream, value.size());
+    outStream.write(value.data(), value.size());
+}
+
+bool BinaryIO::readUInt8(std::istream &inStream, uint8_t &value) {
+    uint64_t bytes;
+    if (!readBytes(inStream, bytes, 1)) {
+        return false;
+    }
+    value = static_cast<uint8_t>(bytes);
+    return true;
+}
+
+bool BinaryIO::readInt32(std::istream &inStream, int32_t &value) {
+    uint64_t bytes;
+    if (!readBytes(inStream, bytes, 4)) {
+        return false;
+    }
+    value = static_cast<int32_t>(static_cast<uint32_t>(bytes));
+    return true;
+}
+
+bool BinaryIO::readUInt32(std::istream &inStream, uint32_t &value) {
+    uint64_t bytes;
+    if (!readBytes(inStream, bytes, 4)) {
+        return false;
+    }
+    value = static_cast<uint32_t>(bytes);
+    return true;
+}
+
+bool BinaryIO::readUInt64(std::istream &inStream, uint64_t &value) {
+    return readBytes(inStream, value, 8);
+}
+
+bool BinaryIO::readDouble(std::istream &inStream, double &value) {
+    uint64_t bits;
+    if (!readBytes(inStream, bits, 8)) {
+        return false;
+    }
+    value = bitsToDouble(bits);
+    return true;
+}
+
+bool BinaryIO::readString(std::istream &inStream, std::string &value) {
+    uint32_t length;
+    if (!readUInt32(inStream, length)) {
+        return false;
+    }
+    // In stukken gelezen, zodat een beschadigde lengte niet in een keer gealloceerd wordt
+    value.clear();
+    char buffer[4096];
+    while (length > 0) {
+        uint32_t part = length < sizeof(buffer) ? length : sizeof(buffer);
+        if (!inStream.read(buffer, part)) {
+            return false;
+        }
+        value.append(buffer, part);
+        length -= part;
+    }
+    return true;
+}
+
+void BinaryIO::writeVarUInt(std::ostream &outStream, uint64_t value) {
+    while (value >= 0x80) {
+        writeUInt8(outStream, static_cast<uint8_t>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    writeUInt8(outStream, static_cast<uint8_t>(value));
+}
+
+bool BinaryIO::readVarUInt(std::istream &inStream, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!readUInt8(inStream, byte)) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    // Meer dan 64 bits kan niet door writeVarUInt geschreven zijn
+    return false;
+}
+
+void BinaryIO::writeTrimmedUInt64(std::ostream &outStream, uint64_t value) {
+    int trailing = 0;
+    int nrOfBytes = 0;
+    if (value != 0) {
+        while ((value & 0xff) == 0) {
+            value >>= 8;
+            ++trailing;
+        }
+        for (uint64_t rest = value; rest != 0; rest >>= 8) {
+            ++nrOfBytes;
+        }
+    }
+    writeUInt8(outStream, static_cast<uint8_t>(trailing << 4 | nrOfBytes));
+    writeBytes(outStream, value, nrOfBytes);
+}
+
+bool BinaryIO::readTrimmedUInt64(std::istream &inStream, uint64_t &value) {
+    uint8_t sizes;
+    if (!readUInt8(inStream, sizes)) {
+        return false;
+    }
+    int trailing = sizes >> 4;
+    int nrOfBytes = sizes & 0x0f;
+    if (trailing + nrOfBytes > 8 or (nrOfBytes == 0 and trailing != 0) or !readBytes(inStream, value, nrOfBytes)) {
+        return false;
+    }
+    value <<= 8 * trailing;
+    return true;
+}
+
+void BinaryIO::encodeUInt32(char *buffer, uint32_t value) {
+    encodeBytes(buffer, value, 4);
+}
+
+void BinaryIO::encodeInt32(char *buffer, int32_t value) {
+    encodeBytes(buffer, static_cast<uint32_t>(value), 4);
+}
+
+void BinaryIO::encodeUInt64(char *buffer, uint64_t value) {
+    encodeBytes(buffer, value, 8);
+}
+
+void BinaryIO::encodeDouble(char *buffer, double value) {
+    encodeBytes(buffer, doubleToBits(value), 8);
+}
+
+uint32_t BinaryIO::decodeUInt32(const char *buffer) {
+    return static_cast<uint32_t>(decodeBytes(buffer, 4));
+}
+
+int32_t BinaryIO::decodeInt32(const char *buffer) {
+    return static_cast<int32_t>(decodeUInt32(buffer));
+}
+
+uint64_t BinaryIO::decodeUInt64(const char *buffer) {
+    return decodeBytes(buffer, 8);
+}
+
+double BinaryIO::decodeDouble(const char *buffer) {
+    return bitsToDouble(decodeBytes(buffer, 8));
+}
+
+uint64_t BinaryIO::doubleToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double BinaryIO::bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint32_t BinaryIO::StringSection::add(const std::string &value) {
+    std::tr1::unordered_map<std::string, uint32_t>::const_iterator found = offsets.find(value);
+    if (found != offsets.end()) {
+        return found->second;
+    }
+    uint32_t offset = data.size();
+    data += value;
+    offsets[value] = offset;
+    return offset;
+}
+
+const std::string &BinaryIO::StringSection::getData() const {
+    return data;
+}
+
+bool BinaryIO::validString(uint32_t offset, uint32_t length, uint64_t stringSize) {
+    return (uint64_t) offset + length <= stringSize;
+}
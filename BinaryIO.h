@@ -0,0 +1,117 @@
+/**
+ * @file BinaryIO.h
+ * @brief Functions to write and read numbers and strings in a binary stream.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_BINARYIO_H
+#define ANTROPSE_BINARYIO_H
+
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <tr1/unordered_map>
+
+/**
+ * Numbers are written in little endian, independent of the machine. A double is written as the 64 bits of its IEEE 754
+ * representation, so it's read back exactly. A string is written as its length (32 bits), followed by its characters.
+ *
+ * The read functions return false when the stream ends before the value has been read completely. The encode and
+ * decode functions do the same on a buffer in memory, e.g. a file that has been mapped in memory.
+ */
+namespace BinaryIO {
+    void writeUInt8(std::ostream &outStream, uint8_t value);
+
+    void writeInt32(std::ostream &outStream, int32_t value);
+
+    void writeUInt32(std::ostream &outStream, uint32_t value);
+
+    void writeUInt64(std::ostream &outStream, uint64_t value);
+
+    void writeDouble(std::ostream &outStream, double value);
+
+    void writeString(std::ostream &outStream, const std::string &value);
+
+    bool readUInt8(std::istream &inStream, uint8_t &value);
+
+    bool readInt32(std::istream &inStream, int32_t &value);
+
+    bool readUInt32(std::istream &inStream, uint32_t &value);
+
+    bool readUInt64(std::istream &inStream, uint64_t &value);
+
+    bool readDouble(std::istream &inStream, double &value);
+
+    bool readString(std::istream &inStream, std::string &value);
+
+    /**
+     * Write a number in 7 bits per byte, the highest bit of a byte tells whether another byte follows. A number below
+     * 128 takes one byte.
+     */
+    void writeVarUInt(std::ostream &outStream, uint64_t value);
+
+    bool readVarUInt(std::istream &inStream, uint64_t &value);
+
+    /**
+     * Write a number without its zero bytes at both ends: a byte with the number of zero bytes at the end (high four
+     * bits) and the number of bytes in between (low four bits), followed by those bytes. 0 takes one byte.
+     */
+    void writeTrimmedUInt64(std::ostream &outStream, uint64_t value);
+
+    bool readTrimmedUInt64(std::istream &inStream, uint64_t &value);
+
+    void encodeUInt32(char *buffer, uint32_t value);
+
+    void encodeInt32(char *buffer, int32_t value);
+
+    void encodeUInt64(char *buffer, uint64_t value);
+
+    void encodeDouble(char *buffer, double value);
+
+    uint32_t decodeUInt32(const char *buffer);
+
+    int32_t decodeInt32(const char *buffer);
+
+    uint64_t decodeUInt64(const char *buffer);
+
+    double decodeDouble(const char *buffer);
+
+    /**
+     * @return The 64 bits of the IEEE 754 representation of a double
+     */
+    uint64_t doubleToBits(double value);
+
+    /**
+     * @return The double with this IEEE 754 representation
+     */
+    double bitsToDouble(uint64_t bits);
+
+    /**
+     * The string section of a binary file: every distinct string is stored once and referred to by its offset and its
+     * length, e.g. the type of every vehicle
+     */
+    class StringSection {
+    public:
+        /**
+         * @return The offset of value in the section, it's added at the end when it's not in the section yet
+         */
+        uint32_t add(const std::string &value);
+
+        const std::string &getData() const;
+
+    private:
+        std::string data;
+        std::tr1::unordered_map<std::string, uint32_t> offsets;
+    };
+
+    /**
+     * @return true when the string at offset with length characters lies inside a string section of stringSize bytes
+     */
+    bool validString(uint32_t offset, uint32_t length, uint64_t stringSize);
+}
+
+#endif //ANTROPSE_BINARYIO_H
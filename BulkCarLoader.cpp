@@ -0,0 +1,120 @@
+/**
+ * @file BulkCarLoader.cpp
+ * @brief This file will contain the definitions of the functions in BulkCarLoader.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <climits>
+#include "BulkCarLoader.h"
+#include "CONST.h"
+#include "DesignByContract.h"
+#include "Road.h"
+#include "RoadGraph.h"
+#include "Vehicle.h"
+
+bool BulkCarLoader::CarOrder::operator()(const Vehicle *left, const Vehicle *right) const {
+    // Op de naam van de weg, zoals RoadNetwork::addCar
+    const Road *leftRoad = roads->findRoad(left->getCurrentRoad()->getName());
+    const Road *rightRoad = roads->findRoad(right->getCurrentRoad()->getName());
+    if (leftRoad != rightRoad) {
+        return roads->comesBefore(leftRoad, rightRoad);
+    }
+    return left->getCurrentPosition() < right->getCurrentPosition();
+}
+
+BulkCarLoader::BulkCarLoader(const RoadGraph &roads, const std::vector<Vehicle *> &cars) : roads(roads),
+                                                                                             nextRank(ULONG_MAX) {
+    CarOrder carOrder;
+    carOrder.roads = &roads;
+    records = std::map<Vehicle *, std::list<Vehicle *>::iterator, CarOrder>(carOrder);
+
+    Vehicle *largest = NULL;
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        std::list<Vehicle *>::iterator car = order.insert(order.end(), cars[i]);
+        if (largest == NULL or carOrder(largest, cars[i])) {
+            largest = cars[i];
+            records[cars[i]] = car;
+        }
+    }
+
+    // Van voor naar achter, zodat wagens op dezelfde positie hun plaats in de rij houden
+    const std::vector<Road *> &allRoads = roads.getRoads();
+    for (unsigned int i = 0; i < allRoads.size(); ++i) {
+        for (Vehicle *car = allRoads[i]->getLastVehicle(); car != NULL; car = car->getVehicleBehind()) {
+            queues[allRoads[i]][QueueKey(car->getCurrentPosition(), nextRank--)] = car;
+        }
+    }
+    _initCheck = this;
+}
+
+bool BulkCarLoader::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+bool BulkCarLoader::add(Vehicle *car) {
+    REQUIRE(properlyInitialized(), "The loader must be properly initialized");
+
+    // addCar weigert een wagen op dezelfde plaats als een wagen die hij in de lijst tegenkomt voor de eerste grotere
+    // wagen. Zo'n wagen is groter dan alles voor hem.
+    if (records.find(car) != records.end()) {
+        return false;
+    }
+
+    // Dezelfde afstanden als RoadNetwork::checkSpaceOnRoad. Een nieuwe wagen komt achter de wagens op dezelfde positie
+    // in de rij, en die delen hun voorganger.
+    RoadQueue &queue = queues[car->getCurrentRoad()];
+    double position = car->getCurrentPosition();
+    RoadQueue::iterator ahead = queue.upper_bound(QueueKey(position, ULONG_MAX));
+    if (ahead != queue.end() and
+        ahead->first.first - ahead->second->getLength() - position < CONST::MIN_FOLLOWING_DISTANCE) {
+        return false;
+    }
+    RoadQueue::iterator behind = queue.lower_bound(QueueKey(position, 0));
+    if (behind != queue.begin()) {
+        --behind;
+        if (position - car->getLength() - behind->first.first < CONST::MIN_FOLLOWING_DISTANCE) {
+            return false;
+        }
+    }
+    changedRoads.insert(car->getCurrentRoad());
+    queue[QueueKey(position, nextRank--)] = car;
+
+    // De eerste grotere wagen in de lijst is de eerste grotere van de wagens die groter zijn dan alles voor hen. Alles
+    // voor de nieuwe wagen is kleiner, dus hij is zelf zo'n wagen, en de wagen die hij voorbijsteekt niet meer.
+    std::map<Vehicle *, std::list<Vehicle *>::iterator, CarOrder>::iterator larger = records.upper_bound(car);
+    std::list<Vehicle *>::iterator place = order.end();
+    if (larger != records.end()) {
+        place = larger->second;
+        if (place != order.begin()) {
+            --place;
+            std::map<Vehicle *, std::list<Vehicle *>::iterator, CarOrder>::iterator passed = records.find(*place);
+            if (passed != records.end() and passed->second == place) {
+                records.erase(passed);
+            }
+        }
+    }
+    records[car] = order.insert(place, car);
+    return true;
+}
+
+void BulkCarLoader::finish(std::vector<Vehicle *> &cars) {
+    REQUIRE(properlyInitialized(), "The loader must be properly initialized");
+
+    cars.assign(order.begin(), order.end());
+
+    // De rij van elke weg waar een wagen bij kwam opnieuw opbouwen, van voor naar achter: elke wagen komt dan meteen
+    // achteraan de rij
+    for (std::set<Road *>::iterator it = changedRoads.begin(); it != changedRoads.end(); ++it) {
+        Road *road = *it;
+        while (road->getFirstVehicle() != NULL) {
+            road->exitVehicle(road->getFirstVehicle());
+        }
+        RoadQueue &queue = queues[road];
+        for (RoadQueue::reverse_iterator car = queue.rbegin(); car != queue.rend(); ++car) {
+            road->enterVehicle(car->second);
+        }
+    }
+}
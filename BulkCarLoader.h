@@ -0,0 +1,104 @@
+/**
+ * @file BulkCarLoader.h
+ * @brief This header file will contain the BulkCarLoader class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_BULKCARLOADER_H
+#define ANTROPSE_BULKCARLOADER_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <tr1/unordered_map>
+
+class Road;
+
+class RoadGraph;
+
+class Vehicle;
+
+/**
+ * Adds many cars to a network in O(log N) per car, with the same result as RoadNetwork::addCar for every car
+ *
+ * RoadNetwork::addCar looks for the place of a new car in the list of cars by walking over the list. It checks the
+ * spacing to the neighbours of the car in the queue of its road. The loader keeps, for every road, the positions of its
+ * cars in an ordered map, so the spacing to the car ahead and behind is checked with one lookup. Like addCar, a car on
+ * the same position as another car is only refused when addCar would meet that car before the place of the new car. The
+ * place in the list is found on the cars that are larger than every car before them in the list (on the order of their
+ * road in the network and their position): addCar puts a car right before the car that precedes the first larger car,
+ * and that first larger car is always one of those. The order of the roads that are already in the network doesn't
+ * change when a road is added, so a road can be added while loading.
+ *
+ * The queues of the roads and the list of cars of the network are only filled in finish.
+ */
+class BulkCarLoader {
+public:
+    /**
+     * @param roads The roads of the network
+     * @param cars The cars that are already in the network, in the order of the network
+     */
+    BulkCarLoader(const RoadGraph &roads, const std::vector<Vehicle *> &cars);
+
+    /**
+     * Add a car, when it keeps enough distance from the cars on its road
+     *
+     * @param car A car on a road of the network, which isn't in the network yet
+     *
+     * @return true when the car has been added, false when RoadNetwork::addCar would refuse it because of its position
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The loader must be properly initialized");
+     */
+    bool add(Vehicle *car);
+
+    /**
+     * Put the cars that have been added in the queues of their road
+     *
+     * @param cars The list of cars of the network, replaced by all cars in the order RoadNetwork::addCar would give
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The loader must be properly initialized");
+     */
+    void finish(std::vector<Vehicle *> &cars);
+
+    bool properlyInitialized() const;
+
+private:
+    /**
+     * The order in which RoadNetwork::addCar sorts cars: on the place of their road in the network, then on position
+     */
+    struct CarOrder {
+        const RoadGraph *roads;
+
+        bool operator()(const Vehicle *left, const Vehicle *right) const;
+    };
+
+    const RoadGraph &roads;
+    std::list<Vehicle *> order; /**< All cars, in the order of the list of cars of the network */
+    std::map<Vehicle *, std::list<Vehicle *>::iterator, CarOrder> records; /**< The cars larger than all cars before
+                                                                                 * them in the order */
+    /**
+     * A car in the queue of a road: its position, and a rank that goes down for every car added to the queue, so cars
+     * on the same position are in the order of the queue
+     */
+    typedef std::pair<double, unsigned long> QueueKey;
+    typedef std::map<QueueKey, Vehicle *> RoadQueue;
+
+    std::tr1::unordered_map<const Road *, RoadQueue> queues; /**< The cars on every road, from the back to the front */
+    unsigned long nextRank;
+    std::set<Road *> changedRoads; /**< The roads on which a car has been added */
+
+    BulkCarLoader *_initCheck;
+
+    BulkCarLoader(const BulkCarLoader &);
+
+    BulkCarLoader &operator=(const BulkCarLoader &);
+};
+
+
+#endif //ANTROPSE_BULKCARLOADER_H
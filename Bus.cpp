@@ -28,7 +28,7 @@ std::string Bus::getType() const {
     return "BUS";
 }
 
-Bus::Bus() : Vehicle() {}
+Bus::Bus() : Vehicle(), waitingTime(0) {}
 
 double Bus::getLength() const {
     return CONST::BUS_LENGTH;
@@ -62,32 +62,32 @@ void Bus::checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &errSt
 //    std::cout << "Waiting time (" << licensePlate << ") : " << waitingTime << std::endl;
     REQUIRE(properlyInitialized(), "The vehicle must be properly initialized");
     REQUIRE(roadNetwork->properlyInitialized(), "The roadnetwork must be properly initialized");
-    REQUIRE(roadNetwork->check(), "The roadnetwork must be in a valid state");
+    REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be in a valid state");
 
-    if (getType() == "BUS" and (currentRoad->getNextBusStop(getCurrentPosition()) - getCurrentPosition()) <
-                               CONST::METERS_BEFORE_SLOWING_DOWN and
-        currentRoad->getNextBusStop(getCurrentPosition()) - getCurrentPosition() >= 0) {
+    double nextBusStop = currentRoad->getNextBusStop(getCurrentPosition(), currentFeature);
+    if (getType() == "BUS" and (nextBusStop - getCurrentPosition()) < CONST::METERS_BEFORE_SLOWING_DOWN and
+        nextBusStop - getCurrentPosition() >= 0) {
         if (waitingTime < CONST::BUS_STOP_WAITING_TIME) {
-            double newSpeedup = calculateSlowDownForPosition(currentRoad->getNextBusStop(getCurrentPosition()));
+            double newSpeedup = calculateSlowDownForPosition(nextBusStop);
 //            std::cout << "Berekende versnelling: " << newSpeedup << std::endl;
 
             if (slowingDownForTrafficLight or slowingDownForPreviousCar) {
-                currentSpeedup = currentSpeedup < newSpeedup ? currentSpeedup : newSpeedup;
+                setStateSpeedup(stateSpeedup() < newSpeedup ? stateSpeedup() : newSpeedup);
             } else {
-                currentSpeedup = newSpeedup;
+                setStateSpeedup(newSpeedup);
                 slowingDownForVehicleSpecific = true;
             }
 
-            if (currentSpeedup < getMinSpeedup()) {
+            if (stateSpeedup() < getMinSpeedup()) {
                 errStream << "Impossible to slow down before the bus stop" << std::endl;
                 updateCurrentSpeedup(1, roadNetwork);
-            } else if (currentSpeedup > getMaxSpeedup()) {
-                currentSpeedup = getMaxSpeedup();
+            } else if (stateSpeedup() > getMaxSpeedup()) {
+                setStateSpeedup(getMaxSpeedup());
             }
         }
 //        if(getCurrentPosition() == currentRoad->getNextBusStop(getCurrentPosition())){
-        if (getCurrentPosition() + CONST::ALMOST_ZERO > currentRoad->getNextBusStop(getCurrentPosition())) {
-            waitingTime++;
+        if (getCurrentPosition() + CONST::ALMOST_ZERO > nextBusStop) {
+            waitingTime += stepTime;
             if (getCurrentSpeed() > CONST::ALMOST_ZERO) {
                 if (waitingTime > CONST::BUS_STOP_WAITING_TIME) {
                     // De bushalte wordt verlaten, normaal dus dat je sneller rijdt
@@ -105,10 +105,27 @@ void Bus::checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &errSt
         }
     }
 
-    ENSURE(roadNetwork->check(), "The roadnetwork stays correct");
+    ENSURE_FULL(roadNetwork->check(), "The roadnetwork stays correct");
 }
 
 char Bus::getShortName() {
     return 'B';
 }
 
+double Bus::getSpecificState() const {
+    return waitingTime;
+}
+
+void Bus::setSpecificState(double specificState) {
+    waitingTime = specificState;
+}
+
+double Bus::getNextSpecificPosition() {
+    REQUIRE(properlyInitialized(), "The vehicle must be properly initialized");
+    REQUIRE(currentRoad != NULL, "De bus moet op een weg staan");
+    double nextBusStop = currentRoad->getNextBusStop(getCurrentPosition(), currentFeature);
+    if (nextBusStop == -1) {
+        return -1;
+    }
+    return nextBusStop - CONST::METERS_BEFORE_SLOWING_DOWN;
+}
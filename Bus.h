@@ -70,17 +70,33 @@ public:
      * @pre
      * REQUIRE(properlyInitialized(), "The vehicle must be properly initialized");
      * REQUIRE(roadNetwork->properlyInitialized(), "The roadnetwork must be properly initialized");
-     * REQUIRE(roadNetwork->check(), "The roadnetwork must be in a valid state");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be in a valid state");
      *
      * @post
-     * ENSURE(roadNetwork->check(), "The roadnetwork stays correct");
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork stays correct");
      */
     virtual void checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &errStream);
 
+    /**
+     * @return The position from which the bus slows down for the next bus stop on its road, -1 when there is none
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle must be properly initialized");
+     * REQUIRE(currentRoad != NULL, "De bus moet op een weg staan");
+     */
+    virtual double getNextSpecificPosition();
+
+    /**
+     * @return The time in s the bus has been standing at the bus stop
+     */
+    virtual double getSpecificState() const;
+
+    virtual void setSpecificState(double specificState);
+
     virtual char getShortName();
 
 private:
-    int waitingTime;
+    double waitingTime; /**< The time in s the bus has been standing at the bus stop */
 };
 
 
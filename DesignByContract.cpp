@@ -0,0 +1,27 @@
+//============================================================================
+// Name        : DesignByContract.cpp
+// Author      : Serge Demeyer
+// Version     :
+// Copyright   : Project Software Engineering - BA1 Informatica - Serge Demeyer - University of Antwerp
+// Description : Run time settings for design by contract in C++
+//============================================================================
+
+#include "DesignByContract.h"
+
+int DesignByContract::level = CONTRACT_LEVEL;
+
+unsigned int DesignByContract::sampleInterval = 0;
+
+unsigned long DesignByContract::tick = 0;
+
+void DesignByContract::setLevel(int newLevel) {
+    level = newLevel > CONTRACT_LEVEL ? CONTRACT_LEVEL : newLevel;
+}
+
+void DesignByContract::setSampleInterval(unsigned int ticks) {
+    sampleInterval = ticks;
+}
+
+void DesignByContract::nextTick() {
+    tick++;
+}
@@ -6,10 +6,96 @@
 // Description : Declarations for design by contract in C++
 //============================================================================
 
+#ifndef ANTROPSE_DESIGNBYCONTRACT_H
+#define ANTROPSE_DESIGNBYCONTRACT_H
+
 #include <assert.h>
 
+// Contract levels
+//  CONTRACT_OFF: no contracts are checked at all, the macros compile to nothing
+//  CONTRACT_CHEAP: only REQUIRE and ENSURE are checked, these must be O(1)
+//  CONTRACT_FULL: REQUIRE_FULL and ENSURE_FULL are checked as well, these check invariants of the whole network
+#define CONTRACT_OFF 0
+#define CONTRACT_CHEAP 1
+#define CONTRACT_FULL 2
+
+// The build time level is the highest level that can be enabled at run time
+#ifndef CONTRACT_LEVEL
+#define CONTRACT_LEVEL CONTRACT_FULL
+#endif
+
+namespace DesignByContract {
+    extern int level; /**< The run time contract level, at most CONTRACT_LEVEL */
+    extern unsigned int sampleInterval; /**< Check the full contracts every sampleInterval ticks, 0 to disable */
+    extern unsigned long tick; /**< The number of ticks seen by the sampling */
+
+    /**
+     * Change the run time contract level
+     *
+     * @param newLevel One of CONTRACT_OFF, CONTRACT_CHEAP or CONTRACT_FULL. Levels above CONTRACT_LEVEL are lowered to
+     * CONTRACT_LEVEL, because those contracts aren't compiled in.
+     */
+    void setLevel(int newLevel);
+
+    /**
+     * Check the full contracts once every few ticks when the run time level is CONTRACT_CHEAP
+     *
+     * @param ticks The number of ticks between two sampled checks, 0 to never check the full contracts
+     */
+    void setSampleInterval(unsigned int ticks);
+
+    /**
+     * Advance the sampling of the full contracts by one tick, called once per simulation iteration
+     */
+    void nextTick();
+
+    /**
+     * @return true when the full contracts must be checked right now
+     */
+    inline bool fullChecksEnabled() {
+        return level >= CONTRACT_FULL or
+               (level >= CONTRACT_CHEAP and sampleInterval != 0 and tick % sampleInterval == 0);
+    }
+}
+
+// Disabled contracts are never evaluated, but still compiled so the variables they use are not reported as unused
+#define CONTRACT_IGNORE(assertion) \
+    ((void) sizeof(!(assertion)))
+
+#if CONTRACT_LEVEL >= CONTRACT_CHEAP
+
+#define REQUIRE(assertion, what) \
+    if (DesignByContract::level >= CONTRACT_CHEAP and !(assertion)) __assert (what, __FILE__, __LINE__)
+
+#define ENSURE(assertion, what) \
+    if (DesignByContract::level >= CONTRACT_CHEAP and !(assertion)) __assert (what, __FILE__, __LINE__)
+
+#else
+
 #define REQUIRE(assertion, what) \
-    if (!(assertion)) __assert (what, __FILE__, __LINE__)
+    CONTRACT_IGNORE(assertion)
 
 #define ENSURE(assertion, what) \
-    if (!(assertion)) __assert (what, __FILE__, __LINE__)
+    CONTRACT_IGNORE(assertion)
+
+#endif
+
+#if CONTRACT_LEVEL >= CONTRACT_FULL
+
+#define REQUIRE_FULL(assertion, what) \
+    if (DesignByContract::fullChecksEnabled() and !(assertion)) __assert (what, __FILE__, __LINE__)
+
+#define ENSURE_FULL(assertion, what) \
+    if (DesignByContract::fullChecksEnabled() and !(assertion)) __assert (what, __FILE__, __LINE__)
+
+#else
+
+#define REQUIRE_FULL(assertion, what) \
+    CONTRACT_IGNORE(assertion)
+
+#define ENSURE_FULL(assertion, what) \
+    CONTRACT_IGNORE(assertion)
+
+#endif
+
+#endif //ANTROPSE_DESIGNBYCONTRACT_H
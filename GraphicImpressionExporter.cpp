@@ -13,8 +13,8 @@ void GraphicImpressionExporter::sectionStart(std::ostream &onStream, const std::
     NetworkExporter::sectionStart(onStream, sectionTitle);
 }
 
-void GraphicImpressionExporter::roadNetworkStart(std::ostream &onStream) {
-    NetworkExporter::roadNetworkStart(onStream);
+void GraphicImpressionExporter::roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork) {
+    NetworkExporter::roadNetworkStart(onStream, roadNetwork);
 }
 
 void GraphicImpressionExporter::roadsStart(std::ostream &onStream) {
@@ -22,40 +22,55 @@ void GraphicImpressionExporter::roadsStart(std::ostream &onStream) {
 }
 
 void GraphicImpressionExporter::roadAdd(std::ostream &onStream, const Road *road, RoadNetwork &roadNetwork) {
-    onStream << road->getName() << " \t | \t";
+    // Enkel de lichten en de voertuigen veranderen van iteratie tot iteratie, die worden over het sjabloon gezet
+    const RoadTemplate &roadTemplate = getTemplate(road);
+    frame = roadTemplate.text;
+    char *roadString = &frame[roadTemplate.roadStart];
+    int roadLenght = frame.size() - roadTemplate.roadStart;
 
-    int roadLenght = road->getLength() / SCALE_LENGTH;
-    std::string roadString;
-    for (int i = 0; i < roadLenght; ++i) {
-        roadString += "=";
+    const std::map<double, TrafficLight *> &trafficLights = road->getTrafficLights();
+    for (std::map<double, TrafficLight *>::const_iterator trafficLight = trafficLights.begin();
+         trafficLight != trafficLights.end(); ++trafficLight) {
+        int trafficLightPosition = (*trafficLight).first / SCALE_LENGTH;
+        char colorTL = TrafficLight::getColorChar(roadNetwork.getTrafficLightColor((*trafficLight).second));
+        if (trafficLightPosition < roadLenght) {
+            roadString[trafficLightPosition] = colorTL;
+        }
     }
 
-    const std::set<double> busStops = road->getBusStops();
-    for (std::set<double>::const_iterator busStop = busStops.begin(); busStop != busStops.end(); ++busStop) {
-        int busStopPosition = (*busStop) / SCALE_LENGTH;
-        roadString[busStopPosition] = 'P';
+    // Enkel de voertuigen in de rij van deze weg, van achter naar voor: bij twee voertuigen in hetzelfde stuk wordt het
+    // voorste getekend
+    for (Vehicle *vehicle = road->getFirstVehicle(); vehicle != NULL; vehicle = vehicle->getVehicleAhead()) {
+        int vehiclePosition = vehicle->getCurrentPosition() / SCALE_LENGTH;
+        if (vehiclePosition < roadLenght) {
+            roadString[vehiclePosition] = vehicle->getShortName();
+        }
     }
 
-    const std::map<double, TrafficLight *> trafficLights = road->getTrafficLights();
-    for (std::map<double, TrafficLight *>::const_iterator trafficLight = trafficLights.begin();
-         trafficLight != trafficLights.end(); ++trafficLight) {
-        int trafficLightPosition = (*trafficLight).first / SCALE_LENGTH;
-        char colorTL = (*trafficLight).second->getColorChar(roadNetwork.getIteration());
-        roadString[trafficLightPosition] = colorTL;
+    onStream << frame << std::endl;
+}
+
+const GraphicImpressionExporter::RoadTemplate &GraphicImpressionExporter::getTemplate(const Road *road) {
+    RoadTemplate &roadTemplate = templates[road];
+    if (!roadTemplate.text.empty() and roadTemplate.revision == road->getRevision()) {
+        return roadTemplate;
     }
 
-    for (std::vector<Vehicle *>::const_iterator vehicle = roadNetwork.getCars().begin();
-         vehicle != roadNetwork.getCars().end();
-         ++vehicle) {
+    roadTemplate.revision = road->getRevision();
+    roadTemplate.text = road->getName() + " \t | \t";
+    roadTemplate.roadStart = roadTemplate.text.size();
 
-        if ((*vehicle)->getCurrentRoad() != road) {
-            continue;
+    int roadLenght = road->getLength() / SCALE_LENGTH;
+    roadTemplate.text.append(roadLenght, '=');
+
+    const std::set<double> &busStops = road->getBusStops();
+    for (std::set<double>::const_iterator busStop = busStops.begin(); busStop != busStops.end(); ++busStop) {
+        int busStopPosition = (*busStop) / SCALE_LENGTH;
+        if (busStopPosition < roadLenght) {
+            roadTemplate.text[roadTemplate.roadStart + busStopPosition] = 'P';
         }
-        int vehiclePosition = (*vehicle)->getCurrentPosition() / SCALE_LENGTH;
-        roadString[vehiclePosition] = (*vehicle)->getShortName();
     }
-
-    onStream << roadString << std::endl;
+    return roadTemplate;
 }
 
 void GraphicImpressionExporter::roadsEnd(std::ostream &onStream) {
@@ -6,13 +6,15 @@
 #define ANTROPSE_GRAPHICIMPRESSIONEXPORTER_H
 
 
+#include <string>
+#include <tr1/unordered_map>
 #include "NetworkExporter.h"
 
 class GraphicImpressionExporter : public NetworkExporter {
 protected:
     virtual void sectionStart(std::ostream &onStream, const std::string sectionTitle);
 
-    virtual void roadNetworkStart(std::ostream &onStream);
+    virtual void roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork);
 
     virtual void roadsStart(std::ostream &onStream);
 
@@ -29,6 +31,21 @@ protected:
     virtual void sectionEnd(std::ostream &onStream);
 
     virtual void roadNetworkEnd(std::ostream &onStream);
+
+private:
+    /**
+     * The parts of a road that only change when the road changes: the name, the road itself and the bus stops
+     */
+    struct RoadTemplate {
+        unsigned long revision; /**< Road::getRevision of the road when the template was made */
+        std::string text;
+        std::string::size_type roadStart; /**< The place in text where the road starts */
+    };
+
+    const RoadTemplate &getTemplate(const Road *road);
+
+    std::tr1::unordered_map<const Road *, RoadTemplate> templates; /**< The templates of all roads exported until now */
+    std::string frame; /**< The line of the road that is being exported, reused for every road */
 };
 
 
@@ -0,0 +1,112 @@
+/**
+ * @file MappedFile.cpp
+ * @brief This file will contain the definitions of the functions in MappedFile.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+#include "DesignByContract.h"
+
+MappedFile::MappedFile() : data(NULL), size(0), mapped(false), opened(false) {
+    _initCheck = this;
+    ENSURE(properlyInitialized() and !isOpen(), "The file must be properly initialized and closed");
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+bool MappedFile::open(const std::string &fileName) {
+    REQUIRE(properlyInitialized(), "The file must be properly initialized");
+    close();
+
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    bool result = openDescriptor(file);
+    ::close(file);
+
+    ENSURE(isOpen() == result, "The file must be open after a successful open");
+    return result;
+}
+
+bool MappedFile::open(std::FILE *file) {
+    REQUIRE(properlyInitialized(), "The file must be properly initialized");
+    REQUIRE(file != NULL, "The file must be open");
+    close();
+
+    bool result = openDescriptor(fileno(file));
+
+    ENSURE(isOpen() == result, "The file must be open after a successful open");
+    return result;
+}
+
+bool MappedFile::openDescriptor(int file) {
+    struct stat status;
+    if (fstat(file, &status) == 0 and S_ISREG(status.st_mode) and status.st_size > 0) {
+        void *mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            data = static_cast<const char *>(mapping);
+            size = status.st_size;
+            mapped = true;
+        }
+    }
+    if (!mapped) {
+        // Een leeg bestand of een bestand dat niet gemapt kan worden, wordt gewoon ingelezen. Een bestand dat al
+        // gelezen werd, wordt eerst teruggespoeld; voor een pipe lukt dat niet en wordt de rest gelezen.
+        lseek(file, 0, SEEK_SET);
+        char part[65536];
+        ssize_t partSize;
+        while ((partSize = read(file, part, sizeof(part))) > 0) {
+            buffer.insert(buffer.end(), part, part + partSize);
+        }
+        if (partSize < 0) {
+            buffer.clear();
+            return false;
+        }
+        buffer.push_back('\0');
+        data = &buffer[0];
+        size = buffer.size() - 1;
+    }
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    REQUIRE(properlyInitialized(), "The file must be properly initialized");
+    if (mapped) {
+        munmap(const_cast<char *>(data), size);
+    }
+    std::vector<char>().swap(buffer);
+    data = NULL;
+    size = 0;
+    mapped = false;
+    opened = false;
+    ENSURE(!isOpen(), "The file must be closed");
+}
+
+bool MappedFile::isOpen() const {
+    return opened;
+}
+
+const char *MappedFile::getData() const {
+    REQUIRE(isOpen(), "The file must be open");
+    return data;
+}
+
+std::size_t MappedFile::getSize() const {
+    REQUIRE(isOpen(), "The file must be open");
+    return size;
+}
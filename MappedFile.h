@@ -0,0 +1,118 @@
+/**
+ * @file MappedFile.h
+ * @brief This header file will contain the MappedFile class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_MAPPEDFILE_H
+#define ANTROPSE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * A file that has been mapped in memory, read-only
+ *
+ * The pages of the file are only read when they're used, and nothing is copied. When the file can't be mapped (e.g.
+ * a pipe), it's read in a buffer instead. The mapping is released by close or by the destructor.
+ */
+class MappedFile {
+public:
+    /**
+     * @post
+     * ENSURE(properlyInitialized() and !isOpen(), "The file must be properly initialized and closed");
+     */
+    MappedFile();
+
+    ~MappedFile();
+
+    bool properlyInitialized() const;
+
+    /**
+     * Map a file in memory, a file that is still open is closed first
+     *
+     * @param fileName The name of the file
+     *
+     * @return true when the file has been opened
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The file must be properly initialized");
+     *
+     * @post
+     * ENSURE(isOpen() == result, "The file must be open after a successful open");
+     */
+    bool open(const std::string &fileName);
+
+    /**
+     * Map a file that is already open in memory, from its first byte, a file that is still open is closed first
+     *
+     * The file itself stays open and must be closed by the caller.
+     *
+     * @param file The open file
+     *
+     * @return true when the file has been mapped or read
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The file must be properly initialized");
+     * REQUIRE(file != NULL, "The file must be open");
+     *
+     * @post
+     * ENSURE(isOpen() == result, "The file must be open after a successful open");
+     */
+    bool open(std::FILE *file);
+
+    /**
+     * Release the mapping
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The file must be properly initialized");
+     *
+     * @post
+     * ENSURE(!isOpen(), "The file must be closed");
+     */
+    void close();
+
+    bool isOpen() const;
+
+    /**
+     * @return The content of the file, valid until the file is closed
+     *
+     * @pre
+     * REQUIRE(isOpen(), "The file must be open");
+     */
+    const char *getData() const;
+
+    /**
+     * @return The number of bytes in the file
+     *
+     * @pre
+     * REQUIRE(isOpen(), "The file must be open");
+     */
+    std::size_t getSize() const;
+
+private:
+    /**
+     * Map or read the file of a descriptor, from its first byte
+     */
+    bool openDescriptor(int file);
+
+    const char *data;
+    std::size_t size;
+    bool mapped; /**< Whether data is a mapping, otherwise it points into buffer */
+    bool opened;
+    std::vector<char> buffer;
+    MappedFile *_initCheck;
+
+    // Kopieren zou de mapping twee keer vrijgeven
+    MappedFile(const MappedFile &);
+
+    MappedFile &operator=(const MappedFile &);
+};
+
+
+#endif //ANTROPSE_MAPPEDFILE_H
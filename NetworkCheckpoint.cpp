@@ -0,0 +1,138 @@
+/**
+ * @file NetworkCheckpoint.cpp
+ * @brief This file will contain the definitions of the functions in NetworkCheckpoint.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "NetworkCheckpoint.h"
+#include "BinaryIO.h"
+#include "DesignByContract.h"
+#include "MappedFile.h"
+#include "NetworkSections.h"
+#include "RoadNetwork.h"
+#include "Road.h"
+#include "Vehicle.h"
+
+const char NetworkCheckpoint::MAGIC[4] = {'A', 'C', 'K', 'P'};
+const uint32_t NetworkCheckpoint::FORMAT_VERSION = 2;
+const std::size_t NetworkCheckpoint::HEADER_SIZE = 64;
+const std::size_t NetworkCheckpoint::VEHICLE_SIZE = 56;
+
+namespace {
+    enum NetworkFlags {
+        stateStoreFlag = 1, synchronousUpdateFlag = 2, timeSkippingFlag = 4
+    };
+
+    enum VehicleFlags {
+        previousCarFlag = 1, trafficLightFlag = 2, vehicleSpecificFlag = 4
+    };
+
+    const std::size_t COUNTS_OFFSET = 20;
+}
+
+bool NetworkCheckpoint::save(RoadNetwork &roadNetwork, std::ostream &outStream) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+
+    NetworkSections::Writer sections(roadNetwork, HEADER_SIZE, COUNTS_OFFSET, VEHICLE_SIZE, true);
+    if (!sections.encodeRoads()) {
+        return false;
+    }
+    const std::vector<Vehicle *> &cars = roadNetwork.getCars();
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        if (!sections.encodeVehicle(i)) {
+            return false;
+        }
+        VehicleState state = cars[i]->getState();
+        char *record = sections.getVehicleRecord(i);
+        BinaryIO::encodeUInt32(record + 20, (state.slowingDownForPreviousCar ? previousCarFlag : 0) |
+                                            (state.slowingDownForTrafficLight ? trafficLightFlag : 0) |
+                                            (state.slowingDownForVehicleSpecific ? vehicleSpecificFlag : 0));
+        BinaryIO::encodeDouble(record + 24, state.position);
+        BinaryIO::encodeDouble(record + 32, state.speed);
+        BinaryIO::encodeDouble(record + 40, state.speedup);
+        BinaryIO::encodeDouble(record + 48, state.specificState);
+    }
+
+    char *header = sections.getHeader();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    BinaryIO::encodeUInt32(header + 4, FORMAT_VERSION);
+    BinaryIO::encodeInt32(header + 8, roadNetwork.getIteration());
+    BinaryIO::encodeUInt32(header + 12, (roadNetwork.usesStateStore() ? stateStoreFlag : 0) |
+                                        (roadNetwork.getUpdateMode() == synchronousUpdate ? synchronousUpdateFlag : 0) |
+                                        (roadNetwork.usesTimeSkipping() ? timeSkippingFlag : 0));
+    BinaryIO::encodeInt32(header + 16, roadNetwork.getSubSteps());
+    return sections.write(outStream);
+}
+
+bool NetworkCheckpoint::save(RoadNetwork &roadNetwork, const std::string &fileName) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    std::ofstream outStream(fileName.c_str(), std::ios::binary);
+    if (!outStream or !save(roadNetwork, outStream)) {
+        return false;
+    }
+    outStream.close();
+    return !outStream.fail();
+}
+
+bool NetworkCheckpoint::restore(const char *data, std::size_t size, RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+
+    if (size < HEADER_SIZE or std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 or
+        BinaryIO::decodeUInt32(data + 4) != FORMAT_VERSION) {
+        return false;
+    }
+    int32_t iteration = BinaryIO::decodeInt32(data + 8);
+    uint32_t flags = BinaryIO::decodeUInt32(data + 12);
+    int32_t subSteps = BinaryIO::decodeInt32(data + 16);
+    NetworkSections::Reader sections(HEADER_SIZE, COUNTS_OFFSET, VEHICLE_SIZE, true);
+    if (iteration < 0 or subSteps < 1 or !sections.read(data, size) or !sections.createRoads(roadNetwork)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < sections.getNrOfVehicles(); ++i) {
+        const char *record = sections.getVehicleRecord(i);
+        Road *road = sections.getVehicleRoad(i);
+        uint32_t vehicleFlags = BinaryIO::decodeUInt32(record + 20);
+        VehicleState state;
+        state.position = BinaryIO::decodeDouble(record + 24);
+        state.speed = BinaryIO::decodeDouble(record + 32);
+        state.speedup = BinaryIO::decodeDouble(record + 40);
+        state.specificState = BinaryIO::decodeDouble(record + 48);
+        state.slowingDownForPreviousCar = (vehicleFlags & previousCarFlag) != 0;
+        state.slowingDownForTrafficLight = (vehicleFlags & trafficLightFlag) != 0;
+        state.slowingDownForVehicleSpecific = (vehicleFlags & vehicleSpecificFlag) != 0;
+
+        Vehicle *vehicle = sections.createVehicle(roadNetwork, i);
+        if (vehicle == NULL or
+            !(state.position >= 0 and (state.position <= road->getLength() or road->getLength() == 0)) or
+            !vehicle->restoreState(road, state)) {
+            sections.rollBack(roadNetwork);
+            return false;
+        }
+    }
+
+    sections.addToNetwork(roadNetwork);
+    roadNetwork->setIteration(iteration);
+    roadNetwork->setUseStateStore((flags & stateStoreFlag) != 0);
+    roadNetwork->setUpdateMode((flags & synchronousUpdateFlag) != 0 ? synchronousUpdate : sequentialUpdate);
+    roadNetwork->setTimeSkipping((flags & timeSkippingFlag) != 0);
+    roadNetwork->setSubSteps(subSteps);
+    return true;
+}
+
+bool NetworkCheckpoint::restore(const std::string &fileName, RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+    MappedFile file;
+    if (!file.open(fileName)) {
+        return false;
+    }
+    return restore(file.getData(), file.getSize(), roadNetwork);
+}
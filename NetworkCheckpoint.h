@@ -0,0 +1,88 @@
+/**
+ * @file NetworkCheckpoint.h
+ * @brief This header file will contain the NetworkCheckpoint class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_NETWORKCHECKPOINT_H
+#define ANTROPSE_NETWORKCHECKPOINT_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+class RoadNetwork;
+
+/**
+ * Save the complete state of a road network in a binary checkpoint, and restore it
+ *
+ * A checkpoint contains the iteration and the settings of the network, the roads with their zones, bus stops and
+ * traffic lights, every vehicle with its road, position, speed, speedup, slowing down flags and vehicle specific state
+ * (see Vehicle::getState), the order of the vehicles in the network and in the queues of the roads. A restored network
+ * continues bit for bit the same as the saved network.
+ *
+ * Everything is little endian, in fixed-size records of a multiple of 8 bytes: a header of HEADER_SIZE bytes, then
+ * the sections of NetworkSections with vehicle records of VEHICLE_SIZE bytes. Every name, type and license plate is
+ * stored once in the string section. So a checkpoint is restored in one pass over a file that is mapped in memory,
+ * without parsing.
+ */
+class NetworkCheckpoint {
+public:
+    /**
+     * Write a checkpoint of a network
+     *
+     * @param roadNetwork The network to save, between two iterations
+     * @param outStream The stream to write to, opened in binary mode
+     *
+     * @return true when the checkpoint has been written
+     *
+     * @pre
+     * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    static bool save(RoadNetwork &roadNetwork, std::ostream &outStream);
+
+    /**
+     * Write a checkpoint of a network to a file
+     *
+     * @pre
+     * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    static bool save(RoadNetwork &roadNetwork, const std::string &fileName);
+
+    /**
+     * Restore a checkpoint from memory
+     *
+     * @param data The checkpoint
+     * @param size The number of bytes in the checkpoint
+     * @param roadNetwork An empty network to restore the checkpoint in
+     *
+     * @return true when the checkpoint has been restored. When the checkpoint is damaged (e.g. two roads with the same
+     * name), false is returned and the network stays empty.
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+     */
+    static bool restore(const char *data, std::size_t size, RoadNetwork *roadNetwork);
+
+    /**
+     * Restore a checkpoint from a file, which is mapped in memory while restoring
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+     */
+    static bool restore(const std::string &fileName, RoadNetwork *roadNetwork);
+
+    static const char MAGIC[4];
+    static const uint32_t FORMAT_VERSION;
+    static const std::size_t HEADER_SIZE;
+    static const std::size_t VEHICLE_SIZE;
+};
+
+
+#endif //ANTROPSE_NETWORKCHECKPOINT_H
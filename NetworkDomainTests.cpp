@@ -12,6 +12,8 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include <fstream>
+#include <sstream>
+#include <limits>
 #include "Vehicle.h"
 #include "RoadNetwork.h"
 #include "Road.h"
@@ -22,6 +24,11 @@
 #include "Bus.h"
 #include "Truck.h"
 #include "MotorBike.h"
+#include "DesignByContract.h"
+#include "SignalStateTable.h"
+#include "NetworkCheckpoint.h"
+#include "NetworkSections.h"
+#include "BinaryIO.h"
 
 class NetworkDomainTests : public ::testing::Test {
 protected:
@@ -41,6 +48,93 @@ protected:
     virtual void TearDown() {
     }
 
+    /**
+     * The networks that several tests build in the same way
+     */
+    enum TestNetwork {
+        mixedNetwork, /**< Two roads with a traffic light, a zone and a bus stop, and every type of vehicle */
+        roadChain, /**< Twelve connected roads with three vehicles each, and a traffic light on every fourth road */
+        sparseNetwork, /**< Six long connected roads with a few vehicles far apart, which mostly drive steadily */
+        checkpointNetwork /**< Two roads with every kind of feature, the bus reaches its stop after a while */
+    };
+
+    /**
+     * @return A new network of the given kind, the test must delete it
+     */
+    RoadNetwork *createNetwork(TestNetwork kind) {
+        RoadNetwork *network = new RoadNetwork();
+        switch (kind) {
+            case mixedNetwork: {
+                Road *secondRoad = new Road("N2", 90, 800, NULL);
+                Road *firstRoad = new Road("N1", 70, 600, secondRoad);
+                network->addRoad(secondRoad);
+                network->addRoad(firstRoad);
+                firstRoad->addTrafficLight(300, 0);
+                firstRoad->addZone(150, 50);
+                firstRoad->addBusStop(450);
+                network->addCar(new Car("AUTO1", firstRoad, 0, 0));
+                network->addCar(new Truck("TRUCK1", firstRoad, 20, 40));
+                network->addCar(new MotorBike("MOTOR1", firstRoad, 60, 30));
+                network->addCar(new Bus("BUS1", firstRoad, 100, 10));
+                network->addCar(new Car("AUTO2", firstRoad, 140, 60));
+                network->addCar(new Car("AUTO3", secondRoad, 50, 80));
+                network->addCar(new MotorBike("MOTOR2", secondRoad, 100, 90));
+                break;
+            }
+            case roadChain: {
+                Road *intersection = NULL;
+                for (int i = 0; i < 12; ++i) {
+                    std::string name = "R" + toString(i);
+                    Road *road = new Road(name, 50 + 10 * (i % 5), 200 + 50 * (i % 3), intersection);
+                    network->addRoad(road);
+                    if (i % 4 == 0) {
+                        road->addTrafficLight(100, 10 * i);
+                    }
+                    network->addCar(new Car(name + "A", road, 0, 30));
+                    network->addCar(new Truck(name + "T", road, 40, 20));
+                    network->addCar(new MotorBike(name + "M", road, 90, 50));
+                    intersection = road;
+                }
+                break;
+            }
+            case sparseNetwork: {
+                Road *intersection = NULL;
+                for (int i = 0; i < 6; ++i) {
+                    Road *road = new Road("S" + toString(i), 50 + 20 * (i % 3), 20000 + 1000 * i, intersection);
+                    network->addRoad(road);
+                    road->addZone(8000, 30 + 10 * i);
+                    if (i == 0) {
+                        road->addTrafficLight(12000, 7, 20, 3, 15);
+                    }
+                    road->addBusStop(16000);
+                    intersection = road;
+                }
+                network->addCar(new Car("SA", network->findRoad("S5"), 0, 0));
+                network->addCar(new Bus("SB", network->findRoad("S3"), 100, 20));
+                network->addCar(new MotorBike("SM", network->findRoad("S1"), 500, 40));
+                network->addCar(new Truck("ST", network->findRoad("S4"), 2000, 30));
+                break;
+            }
+            case checkpointNetwork: {
+                Road *second = new Road("B", 90, 800, NULL);
+                Road *first = new Road("A", 120, 1500, second);
+                network->addRoad(first);
+                network->addRoad(second);
+                first->addTrafficLight(400, 3, 20, 4, 15);
+                first->addBusStop(700);
+                first->addZone(1000, 70);
+                second->addZone(200, 50);
+                network->addCar(new Bus("BUS", first, 0, 50));
+                network->addCar(new Car("AUTO1", first, 600, 100));
+                network->addCar(new MotorBike("MOTOR", first, 800, 110));
+                network->addCar(new Truck("TRUCK", first, 1100, 60));
+                network->addCar(new Car("AUTO2", second, 100, 80));
+                break;
+            }
+        }
+        return network;
+    }
+
     // Declares the variables your tests want to use.
     SuccessEnum importResult;
     RoadNetwork *roadNetwork;
@@ -997,6 +1091,999 @@ TEST_F(NetworkDomainTests, MotorBike) {
 }
 
 
+TEST_F(NetworkDomainTests, FindRoadsAndCarsAfterChanges) {
+
+    roadNetwork = new RoadNetwork();
+
+    testRoad = new Road("A12", 120, 5000, NULL);
+    Road *tempRoad = new Road("A11", 120, 50, testRoad);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addRoad(tempRoad);
+
+    EXPECT_EQ(testRoad, roadNetwork->findRoad("A12"));
+    EXPECT_EQ(tempRoad, roadNetwork->findRoad("A11"));
+    EXPECT_TRUE(NULL == roadNetwork->findRoad("A13"));
+
+    testVehicle = new Car("ANT-432", tempRoad, 40, 50);
+    roadNetwork->addCar(testVehicle);
+    roadNetwork->addCar(new Car("ANT-433", testRoad, 20, 0));
+
+    EXPECT_EQ(testVehicle, roadNetwork->findCar("ANT-432"));
+    EXPECT_FALSE(roadNetwork->addCar(new Car("ANT-432", testRoad, 200, 0)));
+
+    // De wagen rijdt over de verbinding naar de volgende weg, maar blijft vindbaar
+    std::ofstream errStream;
+    roadNetwork->moveAllCars(errStream);
+    EXPECT_EQ(testRoad, testVehicle->getCurrentRoad());
+    EXPECT_EQ(testVehicle, roadNetwork->findCar("ANT-432"));
+
+    roadNetwork->removeVehicle("ANT-432");
+    EXPECT_TRUE(NULL == roadNetwork->findCar("ANT-432"));
+    EXPECT_EQ(1, roadNetwork->nrOfCars());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, VehicleQueuePerRoad) {
+
+    roadNetwork = new RoadNetwork();
+
+    testRoad = new Road("A12", 120, 5000, NULL);
+    Road *tempRoad = new Road("A11", 120, 100, testRoad);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addRoad(tempRoad);
+
+    Vehicle *first = new Car("ANT-432", tempRoad, 20, 0);
+    Vehicle *second = new Car("ANT-433", tempRoad, 90, 120);
+    Vehicle *third = new Bus("ANT-434", tempRoad, 60, 0);
+    roadNetwork->addCar(second);
+    roadNetwork->addCar(first);
+    roadNetwork->addCar(third);
+
+    // De rij is gesorteerd op positie, ongeacht de volgorde van toevoegen
+    EXPECT_EQ(first, tempRoad->getFirstVehicle());
+    EXPECT_EQ(third, first->getVehicleAhead());
+    EXPECT_EQ(second, third->getVehicleAhead());
+    EXPECT_EQ(second, tempRoad->getLastVehicle());
+    EXPECT_EQ(third, roadNetwork->findPreviouscar(first));
+    EXPECT_TRUE(NULL == testRoad->getFirstVehicle());
+
+    // Na een iteratie staat de voorste wagen op de volgende weg
+    std::ofstream errStream;
+    roadNetwork->moveAllCars(errStream);
+    EXPECT_EQ(testRoad, second->getCurrentRoad());
+    EXPECT_EQ(second, testRoad->getFirstVehicle());
+    EXPECT_EQ(third, tempRoad->getLastVehicle());
+    EXPECT_TRUE(NULL == roadNetwork->findPreviouscar(third));
+    EXPECT_TRUE(roadNetwork->check());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, CheckInvalidNetwork) {
+
+    roadNetwork = new RoadNetwork();
+
+    testRoad = new Road("A12", 120, 5000, NULL);
+    roadNetwork->addRoad(testRoad);
+
+    testVehicle = new Car("ANT-432", testRoad, 20, 0);
+    Vehicle *otherVehicle = new Truck("ANT-433", testRoad, 100, 0);
+    roadNetwork->addCar(testVehicle);
+    roadNetwork->addCar(otherVehicle);
+    EXPECT_TRUE(roadNetwork->check());
+
+    // De wagen staat te dicht achter de vrachtwagen
+    testVehicle->setCurrentPosition(90);
+    EXPECT_FALSE(roadNetwork->checkSpaceBetweenCars());
+    EXPECT_FALSE(roadNetwork->check());
+
+    testVehicle->setCurrentPosition(20);
+    EXPECT_TRUE(roadNetwork->check());
+
+    // De wagen rijdt op een weg die niet in het netwerk zit
+    Road *unknownRoad = new Road("A13", 120, 5000, NULL);
+    testVehicle->setCurrentRoad(unknownRoad);
+    EXPECT_FALSE(roadNetwork->checkIfCarsOnExistingRoad());
+    EXPECT_FALSE(roadNetwork->check());
+
+    testVehicle->setCurrentRoad(testRoad);
+    EXPECT_TRUE(roadNetwork->check());
+
+    delete roadNetwork;
+    delete unknownRoad;
+}
+
+TEST_F(NetworkDomainTests, ContractLevels) {
+
+    DesignByContract::setLevel(CONTRACT_CHEAP);
+    EXPECT_EQ(CONTRACT_CHEAP, DesignByContract::level);
+    EXPECT_FALSE(DesignByContract::fullChecksEnabled());
+
+    // Met sampling worden de volledige checks om de 3 iteraties uitgevoerd
+    DesignByContract::setSampleInterval(3);
+    int sampledTicks = 0;
+    for (int i = 0; i < 9; ++i) {
+        DesignByContract::nextTick();
+        if (DesignByContract::fullChecksEnabled()) {
+            sampledTicks++;
+        }
+    }
+    EXPECT_EQ(3, sampledTicks);
+
+    DesignByContract::setSampleInterval(0);
+    DesignByContract::setLevel(CONTRACT_OFF);
+    EXPECT_FALSE(DesignByContract::fullChecksEnabled());
+
+    DesignByContract::setLevel(CONTRACT_FULL);
+    EXPECT_EQ(CONTRACT_LEVEL, DesignByContract::level);
+    EXPECT_TRUE(DesignByContract::fullChecksEnabled());
+}
+
+TEST_F(NetworkDomainTests, StateStoreMatchesVehicleEngine) {
+
+    std::ofstream errStream;
+    std::string efname = "tests/domainTests/output/generated/errorLogStateStore.txt";
+    errStream.open(efname.c_str());
+
+    // roadNetwork beweegt de voertuigen zelf
+    roadNetwork = createNetwork(mixedNetwork);
+    RoadNetwork *storeEngine = createNetwork(mixedNetwork);
+    storeEngine->setUseStateStore(true);
+    EXPECT_TRUE(storeEngine->usesStateStore());
+    EXPECT_FALSE(roadNetwork->usesStateStore());
+
+    while (!roadNetwork->isEmpty()) {
+        roadNetwork->moveAllCars(errStream);
+        storeEngine->moveAllCars(errStream);
+        if (storeEngine->getIteration() == 20) {
+            // Van engine wisselen tijdens de simulatie verandert niets
+            storeEngine->setUseStateStore(false);
+            storeEngine->setUseStateStore(true);
+        }
+
+        ASSERT_EQ(roadNetwork->nrOfCars(), storeEngine->nrOfCars());
+        for (int i = 0; i < roadNetwork->nrOfCars(); ++i) {
+            Vehicle *expected = roadNetwork->getCars()[i];
+            Vehicle *actual = storeEngine->getCars()[i];
+            EXPECT_EQ(expected->getLicensePlate(), actual->getLicensePlate());
+            EXPECT_EQ(expected->getCurrentRoad()->getName(), actual->getCurrentRoad()->getName());
+            EXPECT_EQ(expected->getCurrentPosition(), actual->getCurrentPosition());
+            EXPECT_EQ(expected->getCurrentSpeed(), actual->getCurrentSpeed());
+            EXPECT_EQ(expected->getCurrentSpeedup(), actual->getCurrentSpeedup());
+        }
+    }
+    EXPECT_TRUE(storeEngine->isEmpty());
+    EXPECT_TRUE(fileIsEmpty(efname));
+
+    delete roadNetwork;
+    delete storeEngine;
+}
+
+TEST_F(NetworkDomainTests, SynchronousUpdateIndependentOfOrder) {
+
+    std::ofstream errStream;
+    std::string efname = "tests/domainTests/output/generated/errorLogSynchronousUpdate.txt";
+    errStream.open(efname.c_str());
+
+    roadNetwork = createNetwork(mixedNetwork);
+    roadNetwork->setUpdateMode(synchronousUpdate);
+    EXPECT_EQ(synchronousUpdate, roadNetwork->getUpdateMode());
+
+    // Hetzelfde netwerk, maar met de wagens in omgekeerde volgorde toegevoegd
+    RoadNetwork *backward = new RoadNetwork();
+    Road *secondRoad = new Road("N2", 90, 800, NULL);
+    Road *firstRoad = new Road("N1", 70, 600, secondRoad);
+    backward->addRoad(secondRoad);
+    backward->addRoad(firstRoad);
+    firstRoad->addTrafficLight(300, 0);
+    firstRoad->addZone(150, 50);
+    firstRoad->addBusStop(450);
+    backward->addCar(new MotorBike("MOTOR2", secondRoad, 100, 90));
+    backward->addCar(new Car("AUTO3", secondRoad, 50, 80));
+    backward->addCar(new Car("AUTO2", firstRoad, 140, 60));
+    backward->addCar(new Bus("BUS1", firstRoad, 100, 10));
+    backward->addCar(new MotorBike("MOTOR1", firstRoad, 60, 30));
+    backward->addCar(new Truck("TRUCK1", firstRoad, 20, 40));
+    backward->addCar(new Car("AUTO1", firstRoad, 0, 0));
+    backward->setUpdateMode(synchronousUpdate);
+
+    int iterations = 0;
+    while (!roadNetwork->isEmpty()) {
+        roadNetwork->moveAllCars(errStream);
+        backward->moveAllCars(errStream);
+        iterations++;
+
+        ASSERT_EQ(roadNetwork->nrOfCars(), backward->nrOfCars());
+        for (int i = 0; i < roadNetwork->nrOfCars(); ++i) {
+            Vehicle *expected = roadNetwork->getCars()[i];
+            Vehicle *actual = backward->findCar(expected->getLicensePlate());
+            ASSERT_TRUE(actual != NULL);
+            EXPECT_EQ(expected->getCurrentRoad()->getName(), actual->getCurrentRoad()->getName());
+            EXPECT_EQ(expected->getCurrentPosition(), actual->getCurrentPosition());
+            EXPECT_EQ(expected->getCurrentSpeed(), actual->getCurrentSpeed());
+            EXPECT_EQ(expected->getCurrentSpeedup(), actual->getCurrentSpeedup());
+        }
+        EXPECT_TRUE(roadNetwork->check());
+    }
+    EXPECT_TRUE(backward->isEmpty());
+    EXPECT_GT(iterations, 0);
+
+    delete roadNetwork;
+    delete backward;
+}
+
+TEST_F(NetworkDomainTests, ParallelSynchronousUpdate) {
+
+    std::ostringstream singleErrors;
+    std::ostringstream parallelErrors;
+
+    // roadNetwork rekent op een enkele thread
+    roadNetwork = createNetwork(roadChain);
+    roadNetwork->setUpdateMode(synchronousUpdate);
+    RoadNetwork *parallel = createNetwork(roadChain);
+    parallel->setUpdateMode(synchronousUpdate);
+    parallel->setThreadCount(4);
+    EXPECT_EQ(1, roadNetwork->getThreadCount());
+    EXPECT_EQ(4, parallel->getThreadCount());
+
+    while (!roadNetwork->isEmpty()) {
+        roadNetwork->moveAllCars(singleErrors);
+        parallel->moveAllCars(parallelErrors);
+
+        ASSERT_EQ(roadNetwork->nrOfCars(), parallel->nrOfCars());
+        for (int i = 0; i < roadNetwork->nrOfCars(); ++i) {
+            Vehicle *expected = roadNetwork->getCars()[i];
+            Vehicle *actual = parallel->getCars()[i];
+            EXPECT_EQ(expected->getLicensePlate(), actual->getLicensePlate());
+            EXPECT_EQ(expected->getCurrentRoad()->getName(), actual->getCurrentRoad()->getName());
+            EXPECT_EQ(expected->getCurrentPosition(), actual->getCurrentPosition());
+            EXPECT_EQ(expected->getCurrentSpeed(), actual->getCurrentSpeed());
+            EXPECT_EQ(expected->getCurrentSpeedup(), actual->getCurrentSpeedup());
+        }
+    }
+    EXPECT_TRUE(parallel->isEmpty());
+    EXPECT_EQ(singleErrors.str(), parallelErrors.str());
+
+    parallel->setThreadCount(1);
+    EXPECT_EQ(1, parallel->getThreadCount());
+
+    delete roadNetwork;
+    delete parallel;
+}
+
+TEST_F(NetworkDomainTests, ExitQueue) {
+
+    std::ofstream errStream;
+
+    roadNetwork = new RoadNetwork();
+    testRoad = new Road("N9", 120, 200, NULL);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addCar(new Car("EERSTE", testRoad, 190, 100));
+    roadNetwork->addCar(new MotorBike("TWEEDE", testRoad, 170, 110));
+    roadNetwork->addCar(new Car("DERDE", testRoad, 0, 0));
+
+    roadNetwork->moveAllCars(errStream);
+
+    // Beide voertuigen aan het einde van de weg zijn in dezelfde iteratie vertrokken
+    EXPECT_EQ(1, roadNetwork->nrOfCars());
+    ASSERT_EQ(2u, roadNetwork->getExits().size());
+    EXPECT_EQ(NULL, roadNetwork->findCar("EERSTE"));
+    EXPECT_EQ(NULL, roadNetwork->findCar("TWEEDE"));
+    for (unsigned int i = 0; i < roadNetwork->getExits().size(); ++i) {
+        EXPECT_EQ("N9", roadNetwork->getExits()[i].roadName);
+        EXPECT_EQ(1, roadNetwork->getExits()[i].iteration);
+    }
+
+    Vehicle *remaining = roadNetwork->findCar("DERDE");
+    ASSERT_TRUE(remaining != NULL);
+    EXPECT_EQ(remaining, testRoad->getFirstVehicle());
+    EXPECT_EQ(remaining, testRoad->getLastVehicle());
+    EXPECT_TRUE(roadNetwork->check());
+
+    // De vertrekken gelden enkel voor de laatste iteratie
+    roadNetwork->moveAllCars(errStream);
+    EXPECT_TRUE(roadNetwork->getExits().empty());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, PooledVehicles) {
+
+    std::ofstream errStream;
+
+    roadNetwork = new RoadNetwork();
+    testRoad = new Road("A12", 120, 100, NULL);
+    roadNetwork->addRoad(testRoad);
+
+    unsigned long chunkAllocations = 0;
+    for (int round = 0; round < 50; ++round) {
+        const char *types[] = {"AUTO", "MOTORFIETS", "BUS", "VRACHTWAGEN"};
+        for (int type = 0; type < 4; ++type) {
+            Vehicle *vehicle = roadNetwork->createVehicle(types[type]);
+            ASSERT_TRUE(vehicle != NULL);
+            EXPECT_EQ(types[type], vehicle->getType());
+            vehicle->setLicensePlate(toString(round) + "-" + types[type]);
+            vehicle->setCurrentRoad(testRoad);
+            vehicle->setCurrentPosition(25 * (3 - type));
+            ASSERT_TRUE(roadNetwork->addCar(vehicle));
+        }
+        while (!roadNetwork->isEmpty()) {
+            roadNetwork->moveAllCars(errStream);
+        }
+
+        // Na de eerste ronde worden enkel nog vrijgekomen slots hergebruikt
+        if (round == 0) {
+            chunkAllocations = roadNetwork->getPoolStatistics().chunkAllocations;
+        }
+        EXPECT_EQ(chunkAllocations, roadNetwork->getPoolStatistics().chunkAllocations);
+    }
+
+    PoolStatistics statistics = roadNetwork->getPoolStatistics();
+    EXPECT_EQ(200u, statistics.created);
+    EXPECT_EQ(196u, statistics.recycled);
+    EXPECT_EQ(0u, statistics.live);
+    EXPECT_EQ(4u, statistics.chunkAllocations);
+    EXPECT_EQ(NULL, roadNetwork->createVehicle("FIETS"));
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, RoadGraph) {
+
+    roadNetwork = new RoadNetwork();
+    Road *roadC = new Road("C", 50, 100, NULL);
+    Road *roadB = new Road("B", 50, 100, roadC);
+    Road *roadA = new Road("A", 50, 100, roadB);
+    Road *roadD = new Road("D", 50, 100, roadB);
+
+    roadNetwork->addRoad(roadA);
+    roadNetwork->addRoad(roadC);
+    roadNetwork->addRoad(roadB);
+    roadNetwork->addRoad(roadD);
+
+    // De volgorde van het netwerk: B komt na A, de eerste weg die naar B leidt
+    const std::vector<Road *> &roads = roadNetwork->getRoads();
+    ASSERT_EQ(4u, roads.size());
+    EXPECT_EQ(roadD, roads[0]);
+    EXPECT_EQ(roadC, roads[1]);
+    EXPECT_EQ(roadA, roads[2]);
+    EXPECT_EQ(roadB, roads[3]);
+
+    const RoadGraph &graph = roadNetwork->getRoadGraph();
+    EXPECT_EQ(roadB, graph.getSuccessor(roadA));
+    EXPECT_EQ(roadC, graph.getSuccessor(roadB));
+    EXPECT_EQ(NULL, graph.getSuccessor(roadC));
+    ASSERT_EQ(2u, graph.getPredecessors("B").size());
+    EXPECT_EQ(roadA, graph.getPredecessors("B")[0]);
+    EXPECT_EQ(roadD, graph.getPredecessors("B")[1]);
+    EXPECT_EQ(roadD, graph.getFirstPredecessor("B"));
+    EXPECT_TRUE(graph.getPredecessors("A").empty());
+    EXPECT_EQ(roadB, roadNetwork->retrieveIntersectionRoad("B"));
+
+    // In de topologische volgorde komt elke weg voor de weg waar hij naartoe leidt
+    const std::vector<Road *> &topologicalOrder = graph.getTopologicalOrder();
+    ASSERT_EQ(4u, topologicalOrder.size());
+    EXPECT_EQ(roadD, topologicalOrder[0]);
+    EXPECT_EQ(roadA, topologicalOrder[1]);
+    EXPECT_EQ(roadB, topologicalOrder[2]);
+    EXPECT_EQ(roadC, topologicalOrder[3]);
+    EXPECT_TRUE(roadNetwork->checkIntersections());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, LongRoadChain) {
+
+    // Zonder graaf was het toevoegen van een weg lineair in het aantal wegen
+    const int nrOfRoads = 100000;
+    roadNetwork = new RoadNetwork();
+    std::vector<Road *> chain;
+    for (int i = 0; i < nrOfRoads; ++i) {
+        Road *road = roadNetwork->createRoad();
+        road->setName("W" + toString(i));
+        road->setSpeedLimit(50);
+        road->setLength(100);
+        if (i > 0) {
+            road->setIntersection(chain.back());
+        }
+        chain.push_back(road);
+    }
+
+    // Van het einde naar het begin, zodat elke nieuwe weg achter zijn voorganger komt
+    for (int i = 0; i < nrOfRoads; ++i) {
+        ASSERT_TRUE(roadNetwork->addRoad(chain[i]));
+    }
+
+    EXPECT_EQ(nrOfRoads, roadNetwork->nrOfRoads());
+    EXPECT_EQ(chain.back(), roadNetwork->getRoads()[0]);
+    EXPECT_EQ(chain.front(), roadNetwork->getRoads()[nrOfRoads - 1]);
+    EXPECT_EQ(chain.back(), roadNetwork->getRoadGraph().getTopologicalOrder()[0]);
+    EXPECT_EQ(chain[nrOfRoads - 2], roadNetwork->getRoadGraph().getFirstPredecessor("W" + toString(nrOfRoads - 3)));
+    EXPECT_TRUE(roadNetwork->check());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, RoadGraphLabels) {
+
+    // Elke nieuwe weg komt tussen zijn voorganger en Z, tot er geen plaats meer is tussen de labels
+    const int nrOfRoads = 200;
+    roadNetwork = new RoadNetwork();
+    Road *last = new Road("Z", 50, 100, NULL);
+    roadNetwork->addRoad(last);
+    std::vector<Road *> chain(nrOfRoads);
+    for (int i = nrOfRoads - 1; i >= 0; --i) {
+        chain[i] = new Road("K" + toString(i), 50, 100, i + 1 < nrOfRoads ? chain[i + 1] : last);
+    }
+    for (int i = 0; i < nrOfRoads; ++i) {
+        ASSERT_TRUE(roadNetwork->addRoad(chain[i]));
+    }
+
+    const RoadGraph &graph = roadNetwork->getRoadGraph();
+    const std::vector<Road *> &roads = roadNetwork->getRoads();
+    ASSERT_EQ(nrOfRoads + 1u, roads.size());
+    EXPECT_EQ(last, roads[nrOfRoads]);
+    for (int i = 0; i < nrOfRoads; ++i) {
+        EXPECT_EQ(chain[i], roads[i]);
+        EXPECT_TRUE(graph.comesBefore(roads[i], roads[i + 1]));
+        EXPECT_FALSE(graph.comesBefore(roads[i + 1], roads[i]));
+    }
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, ZoneProfile) {
+
+    Road *testRoad = new Road("Zones", 120, 10000, NULL);
+    for (int i = 1; i < 500; ++i) {
+        EXPECT_TRUE(testRoad->addZone(i * 20, 30 + i % 90));
+    }
+    EXPECT_FALSE(testRoad->addZone(20, 50));
+    EXPECT_EQ(120, testRoad->getSpeedLimit(0));
+    EXPECT_EQ(120, testRoad->getSpeedLimit(19.5));
+    EXPECT_EQ(31, testRoad->getSpeedLimit(20));
+    EXPECT_EQ(30 + 499 % 90, testRoad->getSpeedLimit(9999));
+
+    // Vooruit met de cursor geeft dezelfde snelheden als zoeken vanaf het begin
+    int zone = 0;
+    for (double position = 0; position < 10000; position += 7.5) {
+        EXPECT_EQ(testRoad->getSpeedLimit(position), testRoad->getSpeedLimit(position, zone));
+    }
+
+    // Een cursor die niet bij de positie past, wordt opnieuw gezocht
+    EXPECT_EQ(120, testRoad->getSpeedLimit(5, zone));
+    EXPECT_EQ(0, zone);
+    zone = 1000;
+    EXPECT_EQ(testRoad->getSpeedLimit(5000), testRoad->getSpeedLimit(5000, zone));
+
+    // Een nieuwe snelheidslimiet geldt voor de eerste zone
+    EXPECT_TRUE(testRoad->setSpeedLimit(70));
+    EXPECT_EQ(70, testRoad->getSpeedLimit(10));
+    EXPECT_EQ(31, testRoad->getSpeedLimit(25));
+
+    delete testRoad;
+}
+
+TEST_F(NetworkDomainTests, FeatureTimeline) {
+
+    Road *testRoad = new Road("Features", 120, 1000, NULL);
+    EXPECT_TRUE(testRoad->addTrafficLight(100, 0));
+    EXPECT_TRUE(testRoad->addBusStop(200));
+    EXPECT_TRUE(testRoad->addBusStop(300));
+    EXPECT_TRUE(testRoad->addTrafficLight(300, 0));
+    EXPECT_TRUE(testRoad->addTrafficLight(700, 0));
+
+    const std::vector<RoadFeature> &features = testRoad->getFeatures();
+    ASSERT_EQ(5u, features.size());
+    EXPECT_EQ(100, features[0].position);
+    EXPECT_EQ(testRoad->getTrafficLight(100), features[0].trafficLight);
+    EXPECT_EQ(200, features[1].position);
+    EXPECT_EQ(NULL, features[1].trafficLight);
+    EXPECT_EQ(300, features[2].position);
+    EXPECT_EQ(300, features[3].position);
+    EXPECT_EQ(700, features[4].position);
+    EXPECT_EQ(NULL, testRoad->getTrafficLight(150));
+
+    // Een verkeerslicht op de positie zelf telt niet meer, een bushalte wel
+    int feature = 0;
+    EXPECT_EQ(testRoad->getTrafficLight(100), testRoad->getNextTrafficLight(0, feature));
+    EXPECT_EQ(testRoad->getTrafficLight(300), testRoad->getNextTrafficLight(100, feature));
+    EXPECT_EQ(200, testRoad->getNextBusStop(100, feature));
+    EXPECT_EQ(300, testRoad->getNextBusStop(300, feature));
+    EXPECT_EQ(testRoad->getTrafficLight(700), testRoad->getNextTrafficLight(300, feature));
+    EXPECT_EQ(-1, testRoad->getNextBusStop(300.5, feature));
+    EXPECT_EQ(NULL, testRoad->getNextTrafficLight(700, feature));
+
+    // Een cursor die niet bij de positie past, wordt opnieuw gezocht
+    EXPECT_EQ(200, testRoad->getNextBusStop(0, feature));
+    feature = 42;
+    EXPECT_EQ(700, testRoad->getNextTrafficLight(350));
+    EXPECT_EQ(testRoad->getTrafficLight(700), testRoad->getNextTrafficLight(350, feature));
+
+    // Vooruit met de cursor geeft hetzelfde als zoeken vanaf het begin
+    feature = 0;
+    for (double position = 0; position < 1000; position += 2.5) {
+        double nextLight = testRoad->getNextTrafficLight(position);
+        TrafficLight *light = testRoad->getNextTrafficLight(position, feature);
+        EXPECT_EQ(nextLight, light == NULL ? -1 : light->getPosition());
+        EXPECT_EQ(testRoad->getNextBusStop(position), testRoad->getNextBusStop(position, feature));
+    }
+
+    delete testRoad;
+}
+
+TEST_F(NetworkDomainTests, SignalStateTable) {
+
+    std::vector<TrafficLight *> lights;
+    lights.push_back(new TrafficLight(10, 0));
+    lights.push_back(new TrafficLight(20, 1234567));
+    lights.push_back(new TrafficLight(30, 7, 10, 0, 5));
+    lights.push_back(new TrafficLight(40, 3, 1, 1, 1));
+    lights.push_back(new TrafficLight(50, 2147483647, 45, 3, 12));
+
+    SignalStateTable table;
+    for (unsigned int i = 0; i < lights.size(); ++i) {
+        EXPECT_EQ((int) i, table.addTrafficLight(lights[i]));
+    }
+    EXPECT_FALSE(table.isUpToDate(0));
+
+    // Stappen van 1, een sprong vooruit en een sprong achteruit
+    double times[] = {0, 1, 2, 3, 500, 499};
+    for (int t = 0; t < 6; ++t) {
+        table.update(times[t]);
+        for (unsigned int i = 0; i < lights.size(); ++i) {
+            EXPECT_EQ(lights[i]->getColor(times[t]), table.getColor(lights[i]));
+        }
+    }
+    for (int time = 500; time < 800; ++time) {
+        table.update(time);
+        EXPECT_TRUE(table.isUpToDate(time));
+        for (unsigned int i = 0; i < lights.size(); ++i) {
+            EXPECT_EQ(lights[i]->getColor(time), table.getColor(lights[i]));
+            EXPECT_EQ(lights[i]->getColor(time), table.getColors()[i]);
+        }
+    }
+
+    table.clear();
+    EXPECT_FALSE(table.contains(lights[0]));
+    EXPECT_EQ(-1, lights[0]->getSignalId());
+
+    for (unsigned int i = 0; i < lights.size(); ++i) {
+        delete lights[i];
+    }
+}
+
+TEST_F(NetworkDomainTests, TrafficLightColorsInNetwork) {
+
+    roadNetwork = new RoadNetwork();
+    Road *testRoad = new Road("Lichten", 120, 1000, NULL);
+    EXPECT_TRUE(testRoad->addTrafficLight(300, 17));
+    EXPECT_TRUE(testRoad->addTrafficLight(600, 0, 4, 1, 3));
+    EXPECT_FALSE(testRoad->addTrafficLight(700, 0, 0, 1, 3));
+    roadNetwork->addRoad(testRoad);
+
+    // Een licht dat na het begin van de iteratie toegevoegd wordt, berekent zijn eigen kleur
+    TrafficLight *light = testRoad->getTrafficLight(600);
+    EXPECT_EQ(light->getColor(0), roadNetwork->getTrafficLightColor(light));
+    std::ostringstream errors;
+    for (int i = 0; i < 100; ++i) {
+        roadNetwork->moveAllCars(errors);
+        if (i == 50) {
+            EXPECT_TRUE(testRoad->addTrafficLight(800, 5));
+            EXPECT_EQ(testRoad->getTrafficLight(800)->getColor(roadNetwork->getIteration()),
+                      roadNetwork->getTrafficLightColor(testRoad->getTrafficLight(800)));
+        }
+        const std::map<double, TrafficLight *> &trafficLights = testRoad->getTrafficLights();
+        for (std::map<double, TrafficLight *>::const_iterator trafficLight = trafficLights.begin();
+             trafficLight != trafficLights.end(); ++trafficLight) {
+            EXPECT_EQ(trafficLight->second->getColor(roadNetwork->getIteration()),
+                      roadNetwork->getTrafficLightColor(trafficLight->second));
+        }
+    }
+
+    // De nieuwe revisie van de weg zet het nieuwe licht in de tabel
+    EXPECT_LE(0, testRoad->getTrafficLight(800)->getSignalId());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, SteadyStateTimeSkipping) {
+
+    std::ostringstream skippedErrors;
+    std::ostringstream referenceErrors;
+
+    // roadNetwork berekent elke iteratie
+    RoadNetwork *skipped = createNetwork(sparseNetwork);
+    roadNetwork = createNetwork(sparseNetwork);
+    skipped->setTimeSkipping(true);
+    EXPECT_TRUE(skipped->usesTimeSkipping());
+    EXPECT_FALSE(roadNetwork->usesTimeSkipping());
+
+    // Na elke sprong en elke gewone iteratie moet het netwerk gelijk zijn aan een netwerk dat elke iteratie berekent
+    int iterationsSkipped = 0;
+    while (!skipped->isEmpty()) {
+        int skip = skipped->skipSteadyIterations(std::numeric_limits<int>::max());
+        if (skip == 0) {
+            skipped->moveAllCars(skippedErrors);
+        }
+        iterationsSkipped += skip;
+        while (roadNetwork->getIteration() < skipped->getIteration()) {
+            roadNetwork->moveAllCars(referenceErrors);
+        }
+
+        ASSERT_EQ(roadNetwork->getIteration(), skipped->getIteration());
+        ASSERT_EQ(roadNetwork->nrOfCars(), skipped->nrOfCars());
+        for (int i = 0; i < skipped->nrOfCars(); ++i) {
+            Vehicle *expected = roadNetwork->getCars()[i];
+            Vehicle *actual = skipped->getCars()[i];
+            EXPECT_EQ(expected->getLicensePlate(), actual->getLicensePlate());
+            EXPECT_EQ(expected->getCurrentRoad()->getName(), actual->getCurrentRoad()->getName());
+            EXPECT_EQ(expected->getCurrentPosition(), actual->getCurrentPosition());
+            EXPECT_EQ(expected->getCurrentSpeed(), actual->getCurrentSpeed());
+            EXPECT_EQ(expected->getCurrentSpeedup(), actual->getCurrentSpeedup());
+        }
+    }
+    EXPECT_TRUE(roadNetwork->isEmpty());
+    EXPECT_EQ(referenceErrors.str(), skippedErrors.str());
+
+    // Een groot deel van de iteraties wordt overgeslagen, enkel wanneer de wagens versnellen, vertragen of dicht achter
+    // elkaar rijden moet elke iteratie berekend worden
+    EXPECT_GT(iterationsSkipped, skipped->getIteration() / 3);
+
+    // automaticSimulation gebruikt dezelfde sprongen
+    RoadNetwork *automatic = createNetwork(sparseNetwork);
+    automatic->setTimeSkipping(true);
+    std::ofstream errStream("tests/domainTests/output/generated/errorLogTimeSkipping.txt");
+    automatic->automaticSimulation(errStream);
+    errStream.close();
+    EXPECT_EQ(skipped->getIteration(), automatic->getIteration());
+
+    delete skipped;
+    delete roadNetwork;
+    delete automatic;
+}
+
+int countRedLightCrossings(int subSteps) {
+    // Een truck rijdt naar een licht dat na 5 iteraties op oranje springt, vanop verschillende plaatsen en snelheden
+    int crossings = 0;
+    for (int speed = 60; speed <= 120; speed += 20) {
+        for (int start = 0; start < 300; start += 10) {
+            RoadNetwork *network = new RoadNetwork();
+            Road *road = new Road("A", 120, 1000, NULL);
+            network->addRoad(road);
+            road->addTrafficLight(300, 0, 5, 2, 100);
+            TrafficLight *trafficLight = road->getTrafficLights().begin()->second;
+            Vehicle *truck = new Truck("T", road, start, speed);
+            network->addCar(truck);
+            network->setSubSteps(subSteps);
+
+            std::ostringstream errors;
+            for (int i = 0; i < 200 and !network->isEmpty(); ++i) {
+                double before = truck->getCurrentPosition();
+                network->moveAllCars(errors);
+                EXPECT_EQ(i + 1, network->getIteration());
+                if (!network->isEmpty() and before <= 300 and truck->getCurrentPosition() > 300 and
+                    network->getTrafficLightColor(trafficLight) == red) {
+                    crossings++;
+                }
+            }
+            delete network;
+        }
+    }
+    return crossings;
+}
+
+TEST_F(NetworkDomainTests, AdaptiveSubSteps) {
+    RoadNetwork roadNetwork;
+    EXPECT_EQ(1, roadNetwork.getSubSteps());
+    roadNetwork.setSubSteps(4);
+    EXPECT_EQ(4, roadNetwork.getSubSteps());
+
+    // Enkel voertuigen die dicht bij een voorganger, licht of bushalte zijn, worden in kleinere stappen bewogen
+    Road *road = new Road("A", 120, 5000, NULL);
+    roadNetwork.addRoad(road);
+    road->addTrafficLight(1000, 0, 20, 3, 15);
+    road->addBusStop(3000);
+    Vehicle *free = new Car("FREE", road, 0, 100);
+    Vehicle *follower = new Car("FOLLOW", road, 1400, 100);
+    Vehicle *leader = new Car("LEAD", road, 1420, 100);
+    Vehicle *nearLight = new Car("LIGHT", road, 950, 100);
+    Vehicle *bus = new Bus("BUS", road, 2950, 50);
+    roadNetwork.addCar(free);
+    roadNetwork.addCar(follower);
+    roadNetwork.addCar(leader);
+    roadNetwork.addCar(nearLight);
+    roadNetwork.addCar(bus);
+    EXPECT_FALSE(free->isNearInteraction(&roadNetwork));
+    EXPECT_TRUE(follower->isNearInteraction(&roadNetwork));
+    EXPECT_FALSE(leader->isNearInteraction(&roadNetwork));
+    EXPECT_TRUE(nearLight->isNearInteraction(&roadNetwork));
+    EXPECT_TRUE(bus->isNearInteraction(&roadNetwork));
+
+    // Met kleinere stappen remmen de voertuigen vaker op tijd voor een licht dat rood wordt, terwijl de iteraties, en
+    // dus de kleuren van de lichten, gelijk blijven lopen
+    EXPECT_LT(countRedLightCrossings(4), countRedLightCrossings(1));
+}
+
+void expectSameNetwork(RoadNetwork *expected, RoadNetwork *actual) {
+    ASSERT_EQ(expected->getIteration(), actual->getIteration());
+    ASSERT_EQ(expected->getCars().size(), actual->getCars().size());
+    for (unsigned int i = 0; i < expected->getCars().size(); ++i) {
+        Vehicle *expectedCar = expected->getCars()[i];
+        Vehicle *actualCar = actual->getCars()[i];
+        EXPECT_EQ(expectedCar->getLicensePlate(), actualCar->getLicensePlate());
+        EXPECT_EQ(expectedCar->getType(), actualCar->getType());
+        EXPECT_EQ(expectedCar->getCurrentRoad()->getName(), actualCar->getCurrentRoad()->getName());
+        EXPECT_EQ(expectedCar->getCurrentPosition(), actualCar->getCurrentPosition());
+        EXPECT_EQ(expectedCar->getCurrentSpeed(), actualCar->getCurrentSpeed());
+        EXPECT_EQ(expectedCar->getCurrentSpeedup(), actualCar->getCurrentSpeedup());
+        EXPECT_EQ(expectedCar->getSpecificState(), actualCar->getSpecificState());
+    }
+}
+
+TEST_F(NetworkDomainTests, CheckpointRestore) {
+    roadNetwork = createNetwork(checkpointNetwork);
+    roadNetwork->setSubSteps(2);
+    std::ostringstream errors;
+    bool busWaiting = false;
+    for (int i = 0; i < 500 and !busWaiting; ++i) {
+        roadNetwork->moveAllCars(errors);
+        busWaiting = roadNetwork->findCar("BUS")->getSpecificState() > 0;
+    }
+    ASSERT_TRUE(busWaiting);
+
+    std::ostringstream checkpoint;
+    EXPECT_TRUE(NetworkCheckpoint::save(*roadNetwork, checkpoint));
+    std::string data = checkpoint.str();
+    RoadNetwork *restored = new RoadNetwork();
+    EXPECT_TRUE(NetworkCheckpoint::restore(data.data(), data.size(), restored));
+    EXPECT_EQ(2, restored->getSubSteps());
+    EXPECT_EQ(roadNetwork->nrOfRoads(), restored->nrOfRoads());
+    EXPECT_EQ(roadNetwork->findRoad("A")->getIntersection(), roadNetwork->findRoad("B"));
+    EXPECT_EQ(restored->findRoad("A")->getIntersection(), restored->findRoad("B"));
+
+    // Het herstelde netwerk rijdt bit voor bit hetzelfde verder, tot alle voertuigen het netwerk verlaten hebben
+    std::ostringstream originalErrors;
+    std::ostringstream restoredErrors;
+    expectSameNetwork(roadNetwork, restored);
+    while (!roadNetwork->isEmpty()) {
+        roadNetwork->moveAllCars(originalErrors);
+        restored->moveAllCars(restoredErrors);
+        expectSameNetwork(roadNetwork, restored);
+    }
+    EXPECT_TRUE(restored->isEmpty());
+    EXPECT_EQ(originalErrors.str(), restoredErrors.str());
+    delete restored;
+
+    // Via een bestand
+    RoadNetwork *fromFile = new RoadNetwork();
+    RoadNetwork *saved = createNetwork(checkpointNetwork);
+    EXPECT_TRUE(NetworkCheckpoint::save(*saved, "tests/domainTests/output/generated/checkpoint.bin"));
+    EXPECT_TRUE(NetworkCheckpoint::restore("tests/domainTests/output/generated/checkpoint.bin", fromFile));
+    expectSameNetwork(saved, fromFile);
+    delete fromFile;
+    delete saved;
+
+    // Een beschadigd of afgekapt checkpoint wordt geweigerd
+    RoadNetwork *damaged = new RoadNetwork();
+    EXPECT_FALSE(NetworkCheckpoint::restore(data.data(), data.size() - 1, damaged));
+    EXPECT_EQ(0, damaged->nrOfRoads());
+    std::string wrongMagic = data;
+    wrongMagic[0] = 'X';
+    EXPECT_FALSE(NetworkCheckpoint::restore(wrongMagic.data(), wrongMagic.size(), damaged));
+    EXPECT_FALSE(NetworkCheckpoint::restore("tests/domainTests/output/generated/nonexistent.bin", damaged));
+    EXPECT_EQ(0, damaged->nrOfRoads());
+    delete damaged;
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, CheckpointUndeclaredConnection) {
+    // B verbindt met een weg die niet in het netwerk zit, zoals een niet gedeclareerde verbinding bij het inlezen
+    Road *outside = new Road();
+    outside->setName("C");
+    roadNetwork = new RoadNetwork();
+    roadNetwork->addRoad(new Road("B", 90, 800, outside));
+    roadNetwork->addCar(new Car("AUTO1", roadNetwork->findRoad("B"), 700, 80));
+    roadNetwork->addCar(new Truck("TRUCK", roadNetwork->findRoad("B"), 500, 60));
+
+    // Een voertuig op B dat niet in de rij van B staat, wordt geweigerd. Met een voertuig minder blijft de sectie van
+    // de rijen even groot. Het aantal voertuigen in de rijen staat in de header na de aantallen wegen, zones,
+    // bushaltes, lichten en voertuigen, vanaf 20.
+    std::ostringstream unqueued;
+    ASSERT_TRUE(NetworkCheckpoint::save(*roadNetwork, unqueued));
+    std::string damaged = unqueued.str();
+    std::size_t queue = NetworkCheckpoint::HEADER_SIZE + NetworkSections::ROAD_SIZE +
+                        2 * NetworkCheckpoint::VEHICLE_SIZE;
+    BinaryIO::encodeUInt32(&damaged[40], 1);
+    BinaryIO::encodeUInt32(&damaged[NetworkCheckpoint::HEADER_SIZE + 32], 1);
+    BinaryIO::encodeUInt32(&damaged[queue + 4], 0);
+    RoadNetwork *damagedNetwork = new RoadNetwork();
+    EXPECT_FALSE(NetworkCheckpoint::restore(damaged.data(), damaged.size(), damagedNetwork));
+    EXPECT_EQ(0, damagedNetwork->nrOfRoads());
+    EXPECT_EQ(0, damagedNetwork->nrOfCars());
+    delete damagedNetwork;
+
+    // Elke iteratie opnieuw hersteld rijdt het netwerk bit voor bit hetzelfde verder, en verlaten de voertuigen het
+    // netwerk via de verbinding in plaats van aan het einde van B
+    std::ostringstream originalErrors;
+    std::ostringstream restoredErrors;
+    unsigned int nrOfExits = 0;
+    while (!roadNetwork->isEmpty()) {
+        std::ostringstream checkpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(*roadNetwork, checkpoint));
+        std::string data = checkpoint.str();
+        RoadNetwork *restored = new RoadNetwork();
+        ASSERT_TRUE(NetworkCheckpoint::restore(data.data(), data.size(), restored));
+        EXPECT_EQ(1, restored->nrOfRoads());
+        ASSERT_TRUE(restored->findRoad("B")->getIntersection() != NULL);
+        EXPECT_EQ("C", restored->findRoad("B")->getIntersection()->getName());
+        EXPECT_TRUE(restored->findRoad("C") == NULL);
+        expectSameNetwork(roadNetwork, restored);
+        roadNetwork->moveAllCars(originalErrors);
+        restored->moveAllCars(restoredErrors);
+        expectSameNetwork(roadNetwork, restored);
+        EXPECT_EQ(roadNetwork->isEmpty(), restored->isEmpty());
+        ASSERT_EQ(roadNetwork->getExits().size(), restored->getExits().size());
+        for (unsigned int i = 0; i < roadNetwork->getExits().size(); ++i) {
+            EXPECT_EQ(roadNetwork->getExits()[i].licensePlate, restored->getExits()[i].licensePlate);
+            EXPECT_EQ("C", roadNetwork->getExits()[i].roadName);
+            EXPECT_EQ("C", restored->getExits()[i].roadName);
+            EXPECT_EQ(roadNetwork->getExits()[i].iteration, restored->getExits()[i].iteration);
+        }
+        nrOfExits += roadNetwork->getExits().size();
+        delete restored;
+    }
+    EXPECT_EQ(2u, nrOfExits);
+    EXPECT_EQ(originalErrors.str(), restoredErrors.str());
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, DamagedCheckpointLeavesNothing) {
+    roadNetwork = createNetwork(checkpointNetwork);
+    std::ostringstream checkpoint;
+    ASSERT_TRUE(NetworkCheckpoint::save(*roadNetwork, checkpoint));
+    std::string data = checkpoint.str();
+    std::size_t vehicles = NetworkCheckpoint::HEADER_SIZE + 2 * NetworkSections::ROAD_SIZE +
+                           2 * NetworkSections::ZONE_SIZE + NetworkSections::BUS_STOP_SIZE +
+                           NetworkSections::TRAFFIC_LIGHT_SIZE;
+    std::size_t lastVehicle = vehicles + 4 * NetworkCheckpoint::VEHICLE_SIZE;
+
+    // Elke fout wordt pas gevonden nadat er al wegen of voertuigen gemaakt zijn
+    std::string damaged[] = {data, data, data, data};
+    damaged[0].replace(NetworkCheckpoint::HEADER_SIZE + NetworkSections::ROAD_SIZE, 8, data,
+                       NetworkCheckpoint::HEADER_SIZE, 8); // Twee wegen met dezelfde naam
+    damaged[1].replace(lastVehicle + 8, 8, data, vehicles + 8, 8); // Dezelfde nummerplaat
+    damaged[2].replace(lastVehicle, 8, data, vehicles + NetworkCheckpoint::VEHICLE_SIZE + 8, 8); // Een onbestaand type
+    BinaryIO::encodeDouble(&damaged[3][lastVehicle + 24], 5000); // Voorbij het einde van B
+    for (int i = 0; i < 4; ++i) {
+        RoadNetwork *restored = new RoadNetwork();
+        EXPECT_FALSE(NetworkCheckpoint::restore(damaged[i].data(), damaged[i].size(), restored)) << i;
+        EXPECT_EQ(0, restored->nrOfRoads()) << i;
+        EXPECT_EQ(0, restored->nrOfCars()) << i;
+        EXPECT_EQ(0u, restored->getPoolStatistics().live) << i;
+        delete restored;
+    }
+    delete roadNetwork;
+}
+
+TEST_F(NetworkDomainTests, AdaptiveLargeSteps) {
+    RoadNetwork *original = new RoadNetwork();
+    Road *second = new Road("B", 90, 1500, NULL);
+    Road *first = new Road("A", 120, 6000, second);
+    original->addRoad(first);
+    original->addRoad(second);
+    original->addRoad(new Road("C", 70, 8000, NULL));
+    first->addZone(2000, 70);
+    first->addTrafficLight(4000, 0, 20, 4, 15);
+    first->addBusStop(5000);
+    original->addCar(new Car("VRIJ", first, 1000, 120));
+    original->addCar(new Bus("BUS", first, 0, 70));
+    original->addCar(new Truck("TRUCK", original->findRoad("C"), 0, 70));
+    original->setSubSteps(4);
+
+    // Een netwerk dat elke iteratie opnieuw hersteld wordt, heeft geen geplande grote stappen en beweegt elke wagen
+    // zelf. Toch blijft alles bit voor bit gelijk, ook bij de lichten, die elke iteratie van kleur kunnen wisselen.
+    int largeSteps = 0;
+    std::ostringstream originalErrors;
+    std::ostringstream restoredErrors;
+    while (!original->isEmpty()) {
+        std::ostringstream checkpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(*original, checkpoint));
+        std::string data = checkpoint.str();
+        RoadNetwork *restored = new RoadNetwork();
+        ASSERT_TRUE(NetworkCheckpoint::restore(data.data(), data.size(), restored));
+        for (unsigned int i = 0; i < original->getCars().size(); ++i) {
+            largeSteps += original->getCars()[i]->getLargeStepIterations() > 0;
+        }
+        original->moveAllCars(originalErrors);
+        restored->moveAllCars(restoredErrors);
+        expectSameNetwork(original, restored);
+        ASSERT_EQ(original->getExits().size(), restored->getExits().size());
+        delete restored;
+    }
+    EXPECT_EQ(originalErrors.str(), restoredErrors.str());
+    // De vrije wagens rijden het grootste deel van hun weg in grote stappen
+    EXPECT_GT(largeSteps, 100);
+    delete original;
+}
+
+void addBulkLoadCars(RoadNetwork *network, int seed, std::vector<bool> &added) {
+    srand(seed);
+    for (int i = 0; i < 2000; ++i) {
+        if (i == 1000) {
+            // Een weg waar geen weg naartoe leidt komt vooraan, voor de wegen met wagens
+            network->addRoad(new Road("C", 90, 5000, NULL));
+        }
+        const char *roadNames[] = {"A", "B", "C"};
+        Road *road = network->findRoad(roadNames[rand() % (i < 1000 ? 2 : 3)]);
+        std::string plate = "P" + toString(rand() % 1900); // Ook nummerplaten die al gebruikt zijn
+        double position = rand() % 4000;
+        Vehicle *car;
+        if (rand() % 2 == 0) {
+            car = new Car(plate, road, position, 0);
+        } else {
+            car = new Truck(plate, road, position, 0);
+        }
+        added.push_back(network->addCar(car));
+    }
+}
+
+TEST_F(NetworkDomainTests, BulkLoad) {
+    RoadNetwork *networks[2];
+    std::vector<bool> added[2];
+    for (int bulk = 0; bulk < 2; ++bulk) {
+        RoadNetwork *network = new RoadNetwork();
+        networks[bulk] = network;
+        network->addRoad(new Road("A", 120, 5000, NULL));
+        network->addRoad(new Road("B", 100, 5000, NULL));
+        network->addCar(new Car("START", network->findRoad("B"), 2500, 0));
+        if (bulk == 1) {
+            network->startBulkLoad();
+            EXPECT_TRUE(network->isBulkLoading());
+        }
+        addBulkLoadCars(network, 17, added[bulk]);
+        if (bulk == 1) {
+            EXPECT_TRUE(network->findCar("START") != NULL);
+            network->finishBulkLoad();
+            EXPECT_FALSE(network->isBulkLoading());
+        }
+        EXPECT_TRUE(network->check());
+    }
+
+    // Dezelfde wagens geweigerd, en dezelfde volgorde in de lijst van wagens en in de rijen van de wegen
+    EXPECT_TRUE(added[0] == added[1]);
+    ASSERT_EQ(networks[0]->nrOfCars(), networks[1]->nrOfCars());
+    EXPECT_GT(networks[0]->nrOfCars(), 100);
+    for (int i = 0; i < networks[0]->nrOfCars(); ++i) {
+        EXPECT_EQ(networks[0]->getCars()[i]->getLicensePlate(), networks[1]->getCars()[i]->getLicensePlate());
+    }
+    const char *roadNames[] = {"A", "B", "C"};
+    for (int i = 0; i < 3; ++i) {
+        Vehicle *car = networks[0]->findRoad(roadNames[i])->getLastVehicle();
+        Vehicle *bulkCar = networks[1]->findRoad(roadNames[i])->getLastVehicle();
+        while (car != NULL and bulkCar != NULL) {
+            EXPECT_EQ(car->getLicensePlate(), bulkCar->getLicensePlate());
+            car = car->getVehicleBehind();
+            bulkCar = bulkCar->getVehicleBehind();
+        }
+        EXPECT_TRUE(car == NULL and bulkCar == NULL);
+    }
+
+    // Beide netwerken rijden hetzelfde
+    std::ostringstream errors[2];
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        networks[0]->moveAllCars(errors[0]);
+        networks[1]->moveAllCars(errors[1]);
+    }
+    for (int i = 0; i < networks[0]->nrOfCars(); ++i) {
+        EXPECT_EQ(networks[0]->getCars()[i]->getCurrentPosition(), networks[1]->getCars()[i]->getCurrentPosition());
+    }
+    EXPECT_EQ(errors[0].str(), errors[1].str());
+    delete networks[0];
+    delete networks[1];
+}
+
 //int main(int argc, char **argv) {
 //    ::testing::InitGoogleTest(&argc, argv);
 //    return RUN_ALL_TESTS();
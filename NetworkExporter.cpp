@@ -44,7 +44,7 @@ void NetworkExporter::exportOn(std::ostream &onStream, RoadNetwork &game) {
 
     this->sectionStart(onStream, "Roadnetwork " + toString(game.getIteration()));
 
-    this->roadNetworkStart(onStream);
+    this->roadNetworkStart(onStream, game);
 
     this->roadsStart(onStream);
     for (int road = 0; road < game.nrOfRoads(); ++road) {
@@ -58,6 +58,13 @@ void NetworkExporter::exportOn(std::ostream &onStream, RoadNetwork &game) {
     }
     this->vehiclesEnd(onStream);
 
+    this->exitsStart(onStream);
+    const std::vector<VehicleExit> &exits = game.getExits();
+    for (unsigned int exit = 0; exit < exits.size(); ++exit) {
+        this->vehicleExit(onStream, exits[exit]);
+    }
+    this->exitsEnd(onStream);
+
     this->roadNetworkEnd(onStream);
     this->sectionEnd(onStream);
 }
@@ -66,7 +73,7 @@ void NetworkExporter::sectionStart(std::ostream &onStream, const std::string sec
     onStream << sectionTitle << std::endl << std::endl;
 }
 
-void NetworkExporter::roadNetworkStart(std::ostream &onStream) {
+void NetworkExporter::roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork) {
 
 }
 
@@ -98,7 +105,7 @@ void NetworkExporter::roadAdd(std::ostream &onStream, const Road *road, RoadNetw
     for (std::map<double, TrafficLight *>::const_iterator trafficLight = trafficLights.begin();
          trafficLight != trafficLights.end(); ++trafficLight) {
         onStream << listItem << "Verkeerslicht op positie " << (*trafficLight).first << ": ";
-        TrafficLightColor color = (*trafficLight).second->getColor(roadNetwork.getIteration());
+        TrafficLightColor color = roadNetwork.getTrafficLightColor((*trafficLight).second);
         if (color == green) {
             onStream << "Groen";
         } else if (color == orange) {
@@ -140,6 +147,18 @@ void NetworkExporter::vehiclesEnd(std::ostream &onStream) {
 //    onStream << std::endl;
 }
 
+void NetworkExporter::exitsStart(std::ostream &onStream) {
+
+}
+
+void NetworkExporter::vehicleExit(std::ostream &onStream, const VehicleExit &exit) {
+
+}
+
+void NetworkExporter::exitsEnd(std::ostream &onStream) {
+
+}
+
 void NetworkExporter::sectionEnd(std::ostream &onStream) {
 
 }
@@ -83,7 +83,7 @@ public:
 protected:
     virtual void sectionStart(std::ostream &onStream, const std::string sectionTitle);
 
-    virtual void roadNetworkStart(std::ostream &onStream);
+    virtual void roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork);
 
     virtual void roadsStart(std::ostream &onStream);
 
@@ -97,6 +97,15 @@ protected:
 
     virtual void vehiclesEnd(std::ostream &onStream);
 
+    virtual void exitsStart(std::ostream &onStream);
+
+    /**
+     * Export a vehicle that left the network during the last iteration, nothing is written by default
+     */
+    virtual void vehicleExit(std::ostream &onStream, const VehicleExit &exit);
+
+    virtual void exitsEnd(std::ostream &onStream);
+
     virtual void sectionEnd(std::ostream &onStream);
 
     virtual void roadNetworkEnd(std::ostream &onStream);
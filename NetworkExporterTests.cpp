@@ -12,6 +12,7 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include <fstream>
+#include <sstream>
 #include "Vehicle.h"
 #include "RoadNetwork.h"
 #include "Road.h"
@@ -24,6 +25,8 @@
 #include "MotorBike.h"
 #include "Truck.h"
 #include "GraphicImpressionExporter.h"
+#include "TrajectoryExporter.h"
+#include "TrajectoryReader.h"
 
 class NetworkExporterTests : public ::testing::Test {
 protected:
@@ -850,6 +853,181 @@ TEST_F(NetworkExporterTests, ZoneTestGIE) {
     delete roadNetwork;
 }
 
+/**
+ * Exporter that only writes the vehicles that left the network
+ */
+class ExitExporter : public NetworkExporter {
+protected:
+    virtual void roadAdd(std::ostream &onStream, const Road *road, RoadNetwork &roadNetwork) {}
+
+    virtual void vehicleAdd(std::ostream &onStream, const Vehicle *vehicle) {}
+
+    virtual void vehicleExit(std::ostream &onStream, const VehicleExit &exit) {
+        onStream << exit.type << " " << exit.licensePlate << " verlaat " << exit.roadName << " in iteratie "
+                 << exit.iteration << std::endl;
+    }
+};
+
+TEST_F(NetworkExporterTests, VehicleExits) {
+
+    roadNetwork = new RoadNetwork();
+    testRoad = new Road("E313", 120, 100, NULL);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addCar(new Car("VERTREK1", testRoad, 95, 100));
+    roadNetwork->addCar(new Truck("BLIJFT", testRoad, 10, 0));
+
+    std::ofstream errStream;
+    roadNetwork->moveAllCars(errStream);
+    ASSERT_EQ(1, roadNetwork->nrOfCars());
+
+    std::ostringstream output;
+    ExitExporter exporter;
+    exporter.documentStart(output);
+    exporter.exportOn(output, *roadNetwork);
+    exporter.documentEnd(output);
+
+    EXPECT_EQ("Roadnetwork 1\n\nAUTO VERTREK1 verlaat E313 in iteratie 1\n"
+              "-----------------------------------------------------------\n", output.str());
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkExporterTests, GraphicImpressionPerRoad) {
+
+    roadNetwork = new RoadNetwork();
+    Road *second = new Road("B", 120, 500, NULL);
+    testRoad = new Road("A", 120, 1000, second);
+    roadNetwork->addRoad(second);
+    roadNetwork->addRoad(testRoad);
+    testRoad->addBusStop(700);
+    roadNetwork->addCar(new Car("VOOR", testRoad, 150, 0));
+    roadNetwork->addCar(new Truck("ACHTER", testRoad, 120, 0));
+    roadNetwork->addCar(new MotorBike("ANDER", second, 450, 0));
+
+    std::ostringstream output;
+    GraphicImpressionExporter exporter;
+    exporter.documentStart(output);
+    exporter.exportOn(output, *roadNetwork);
+    exporter.documentEnd(output);
+
+    // Elke weg tekent enkel zijn eigen voertuigen, en van twee voertuigen in hetzelfde stuk het voorste
+    EXPECT_NE(std::string::npos, output.str().find("A \t | \t=C=====P==\n"));
+    EXPECT_NE(std::string::npos, output.str().find("B \t | \t====M\n"));
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkExporterTests, GraphicImpressionTemplates) {
+
+    roadNetwork = new RoadNetwork();
+    testRoad = new Road("A", 120, 1000, NULL);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addCar(new Car("WAGEN", testRoad, 150, 0));
+    unsigned long revision = testRoad->getRevision();
+
+    // Dezelfde exporter hergebruikt het sjabloon van de weg, tot de weg verandert
+    GraphicImpressionExporter exporter;
+    exporter.documentStart(std::cout);
+    std::ostringstream first;
+    exporter.exportOn(first, *roadNetwork);
+    EXPECT_NE(std::string::npos, first.str().find("A \t | \t=C========\n"));
+
+    testRoad->addBusStop(700);
+    EXPECT_NE(revision, testRoad->getRevision());
+    std::ostringstream second;
+    exporter.exportOn(second, *roadNetwork);
+    EXPECT_NE(std::string::npos, second.str().find("A \t | \t=C=====P==\n"));
+
+    testRoad->setLength(500);
+    testRoad->setName("B");
+    std::ostringstream third;
+    exporter.exportOn(third, *roadNetwork);
+    EXPECT_NE(std::string::npos, third.str().find("B \t | \t=C===\n"));
+    exporter.documentEnd(std::cout);
+
+    delete roadNetwork;
+}
+
+TEST_F(NetworkExporterTests, BinaryTrajectory) {
+
+    roadNetwork = new RoadNetwork();
+    Road *last = new Road("N2", 90, 1500, NULL);
+    testRoad = new Road("N1", 120, 2000, last);
+    roadNetwork->addRoad(testRoad);
+    roadNetwork->addRoad(last);
+    testRoad->addZone(1200, 70);
+    testRoad->addTrafficLight(800, 3, 12, 2, 9);
+    last->addBusStop(600);
+    roadNetwork->addCar(new Car("AUTO", testRoad, 300, 50));
+    roadNetwork->addCar(new Truck("VRACHT", testRoad, 100, 30));
+    roadNetwork->addCar(new MotorBike("MOTOR", last, 200, 60));
+    roadNetwork->addCar(new Bus("BUS", last, 20, 40));
+
+    // Een frame zonder veranderingen kost per voertuig een byte voor de weg en een byte voor elke delta
+    TrajectoryExporter unchangedExporter;
+    std::ostringstream unchanged;
+    unchangedExporter.documentStart(unchanged);
+    unchangedExporter.exportOn(unchanged, *roadNetwork);
+    std::string::size_type firstFrameEnd = unchanged.str().size();
+    unchangedExporter.exportOn(unchanged, *roadNetwork);
+    EXPECT_EQ(firstFrameEnd + 1 + 4 + 4 * 3, unchanged.str().size());
+
+    NetworkExporter textExporter;
+    GraphicImpressionExporter graphicExporter;
+    TrajectoryExporter trajectoryExporter;
+    std::ostringstream text;
+    std::ostringstream graphic;
+    std::ostringstream trajectory;
+    textExporter.documentStart(text);
+    graphicExporter.documentStart(graphic);
+    trajectoryExporter.documentStart(trajectory);
+
+    std::ostringstream errors;
+    int frames = 0;
+    while (!roadNetwork->isEmpty()) {
+        textExporter.exportOn(text, *roadNetwork);
+        graphicExporter.exportOn(graphic, *roadNetwork);
+        trajectoryExporter.exportOn(trajectory, *roadNetwork);
+        frames++;
+        roadNetwork->moveAllCars(errors);
+        if (roadNetwork->getIteration() == 20) {
+            // Een nieuw voertuig en een nieuwe bushalte: er moet een nieuwe header geschreven worden
+            roadNetwork->addCar(new Car("LAAT", testRoad, 0, 0));
+            testRoad->addBusStop(1800);
+        }
+    }
+    textExporter.documentEnd(text);
+    graphicExporter.documentEnd(graphic);
+    trajectoryExporter.documentEnd(trajectory);
+    EXPECT_LT(trajectory.str().size(), text.str().size() / 2);
+
+    // De trajectorie wordt terug dezelfde tekst als de exporters schreven tijdens de simulatie
+    std::istringstream textInput(trajectory.str());
+    std::ostringstream convertedText;
+    NetworkExporter convertingTextExporter;
+    convertingTextExporter.documentStart(convertedText);
+    EXPECT_EQ(frames, TrajectoryReader::convert(textInput, convertedText, convertingTextExporter));
+    convertingTextExporter.documentEnd(convertedText);
+    EXPECT_EQ(text.str(), convertedText.str());
+
+    std::istringstream graphicInput(trajectory.str());
+    std::ostringstream convertedGraphic;
+    GraphicImpressionExporter convertingGraphicExporter;
+    convertingGraphicExporter.documentStart(convertedGraphic);
+    EXPECT_EQ(frames, TrajectoryReader::convert(graphicInput, convertedGraphic, convertingGraphicExporter));
+    convertingGraphicExporter.documentEnd(convertedGraphic);
+    EXPECT_EQ(graphic.str(), convertedGraphic.str());
+
+    // Een afgebroken trajectorie geeft de volledige frames terug
+    std::istringstream damagedInput(trajectory.str().substr(0, trajectory.str().size() - 3));
+    TrajectoryReader reader(damagedInput);
+    while (reader.readFrame()) {}
+    EXPECT_EQ(frames - 1, reader.getNrOfFramesRead());
+    EXPECT_TRUE(reader.isDamaged());
+
+    delete roadNetwork;
+}
+
 //int main(int argc, char **argv) {
 //    ::testing::InitGoogleTest(&argc, argv);
 //    return RUN_ALL_TESTS();
@@ -2,7 +2,11 @@
 // Created by arno on 4/13/19.
 //
 
-#include <sstream>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <stdlib.h>
 #include "NetworkImporter.h"
 #include "TinyXML/tinyxml.h"
 #include "Road.h"
@@ -12,26 +16,49 @@
 #include "Truck.h"
 #include "AntropseUtils.h"
 #include "DesignByContract.h"
+#include "CONST.h"
+#include "MappedFile.h"
+#include "XmlElementStream.h"
+#include "NetworkScenario.h"
 
 SuccessEnum
 NetworkImporter::importRoadNetwork(const std::string &filename, std::ostream &errStream, RoadNetwork *roadNetwork) {
 
     try {
 
-        if (!(roadNetwork->properlyInitialized() and roadNetwork->check() and fileExists(filename))) {
+        // Het bestand wordt maar een keer geopend, ook om een binair scenario te herkennen
+        FILE *file = roadNetwork->properlyInitialized() ? std::fopen(filename.c_str(), "rb") : NULL;
+        if (!(roadNetwork->properlyInitialized() and roadNetwork->check() and file != NULL)) {
+            if (file != NULL) {
+                std::fclose(file);
+            }
             errStream << "Import aborted: Not all preconditions met" << std::endl;
             return ImportAborted;
         }
 
         REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
-        REQUIRE(roadNetwork->check(), "The roadnetwork must be valid");
-        REQUIRE(fileExists(filename), "Het bestand dat je wil inlezen moet bestaan");
+        REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+
+        char magic[sizeof(NetworkScenario::MAGIC)];
+        std::size_t magicSize = std::fread(magic, 1, sizeof(magic), file);
+        if (NetworkScenario::isScenario(magic, magicSize)) {
+            MappedFile mapped;
+            bool opened = mapped.open(file);
+            std::fclose(file);
+            if (!opened) {
+                errStream << "Import aborted: Error raised when opening the file" << std::endl;
+                return ImportAborted;
+            }
+            return importScenario(mapped.getData(), mapped.getSize(), errStream, roadNetwork);
+        }
 
         SuccessEnum endResult = Success;
 
         // Open the document
         TiXmlDocument docu;
-        if (!docu.LoadFile(filename.c_str())) {
+        bool loaded = docu.LoadFile(file);
+        std::fclose(file);
+        if (!loaded) {
             // Stop the program when an error is raised during opening
             errStream << "Import aborted: Error raised when opening the file" << docu.ErrorDesc() << std::endl;
             return ImportAborted;
@@ -40,8 +67,7 @@ NetworkImporter::importRoadNetwork(const std::string &filename, std::ostream &er
 
         // Get into the root tag of the document
         TiXmlElement *ROOT = docu.FirstChildElement();
-        std::string rootValue = ROOT->Value();
-        if (rootValue != "ROOT") {
+        if (ROOT == NULL or std::string(ROOT->Value()) != "ROOT") {
             errStream << "Import aborted: Expected <ROOT> --- </ROOT> " << std::endl;
             return ImportAborted;
         }
@@ -49,59 +75,172 @@ NetworkImporter::importRoadNetwork(const std::string &filename, std::ostream &er
         // Get the first Lane/Vehicle
         TiXmlElement *current_node = ROOT->FirstChildElement();
 
+        roadNetwork->startBulkLoad();
         while (current_node != NULL) {
+            readElement(current_node, roadNetwork, endResult, errStream);
+            current_node = current_node->NextSiblingElement();
+        }
+        roadNetwork->finishBulkLoad();
 
-            std::string type = current_node->Value();
+        if (!roadNetwork->check()) {
+            errStream << "Import Failed: Something unknown went wrong :-(" << std::endl;
+            return ImportFailed;
+        }
 
-            if (type == "BAAN") {
-                readRoad(current_node, roadNetwork, endResult, errStream);
-            } else if (type == "VOERTUIG") {
+        ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+        return endResult;
+    } catch (...) {
+        if (roadNetwork->isBulkLoading()) {
+            roadNetwork->finishBulkLoad();
+        }
+        errStream
+                << "Import Failed: Everything is on fire, there are zombies everywhere, this world is doomed. "
+                   "Nobody knows what happened. Never. Ever. Touch this project again."
+                << std::endl;
+        return ImportFailed;
+    }
+}
 
-                TiXmlNode *vehicleTypeNode = current_node->FirstChild()->FirstChild();
-                if (vehicleTypeNode == NULL) {
-                    endResult = PartialImport;
-                    errStream << "Partial Import: Vehicle type not specified, ignoring" << std::endl;
-                    current_node = current_node->NextSiblingElement();
-                    continue;
-                }
+SuccessEnum NetworkImporter::importRoadNetworkStreaming(const std::string &filename, std::ostream &errStream,
+                                                        RoadNetwork *roadNetwork) {
+    if (!(roadNetwork->properlyInitialized() and roadNetwork->check())) {
+        errStream << "Import aborted: Not all preconditions met" << std::endl;
+        return ImportAborted;
+    }
 
-                if (vehicleTypeNode->FirstChild() != NULL) {
-                    errStream << "Partial Import: Ongeldige string in de node" << std::endl;
-                    endResult = PartialImport;
-                    continue;
-                }
+    REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+    REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
 
-                std::string vehicleType = vehicleTypeNode->ToText()->Value();
+    std::ifstream inStream(filename.c_str(), std::ios::binary);
+    if (!inStream) {
+        errStream << "Import aborted: Not all preconditions met" << std::endl;
+        return ImportAborted;
+    }
 
-                Vehicle *car;
+    // Een binair scenario wordt in een keer ingelezen, xml in blokken uit dezelfde stream
+    char magic[sizeof(NetworkScenario::MAGIC)];
+    inStream.read(magic, sizeof(magic));
+    if (NetworkScenario::isScenario(magic, inStream.gcount())) {
+        std::vector<char> scenario(magic, magic + sizeof(magic));
+        scenario.insert(scenario.end(), std::istreambuf_iterator<char>(inStream), std::istreambuf_iterator<char>());
+        return importScenario(&scenario[0], scenario.size(), errStream, roadNetwork);
+    }
+    inStream.clear();
+    inStream.seekg(0);
+    XmlElementStream elements(inStream);
+    return importElements(elements, errStream, roadNetwork);
+}
 
-                if (vehicleType == "AUTO") {
-                    car = new Car();
-                } else if (vehicleType == "MOTORFIETS") {
-                    car = new MotorBike();
-                } else if (vehicleType == "BUS") {
-                    car = new Bus();
-                } else if (vehicleType == "VRACHTWAGEN") {
-                    car = new Truck();
-                } else {
-                    endResult = PartialImport;
-                    errStream << "Partial Import: Vehicle type not recognized, ignoring" << std::endl;
-                    current_node = current_node->NextSiblingElement();
-                    continue;
-                }
+SuccessEnum NetworkImporter::importRoadNetwork(std::istream &inStream, std::ostream &errStream,
+                                               RoadNetwork *roadNetwork) {
+    if (!(roadNetwork->properlyInitialized() and roadNetwork->check())) {
+        errStream << "Import aborted: Not all preconditions met" << std::endl;
+        return ImportAborted;
+    }
 
-                readVehicle(current_node, roadNetwork, endResult, errStream, car);
+    REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+    REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
 
-            } else if (type == "VERKEERSTEKEN") {
-                readRoadSign(current_node, roadNetwork, endResult, errStream);
-            } else {
-                endResult = PartialImport;
-                errStream << "Partial Import: Type not recognized, ignoring" << std::endl;
+    XmlElementStream elements(inStream);
+    return importElements(elements, errStream, roadNetwork);
+}
 
-            }
+SuccessEnum NetworkImporter::importRoadNetwork(const char *data, std::size_t size, std::ostream &errStream,
+                                               RoadNetwork *roadNetwork) {
+    if (!(roadNetwork->properlyInitialized() and roadNetwork->check())) {
+        errStream << "Import aborted: Not all preconditions met" << std::endl;
+        return ImportAborted;
+    }
 
-            current_node = current_node->NextSiblingElement();
+    REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+    REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+
+    return importDocument(data, size, errStream, roadNetwork);
+}
+
+SuccessEnum NetworkImporter::importMappedRoadNetwork(const std::string &filename, std::ostream &errStream,
+                                                     RoadNetwork *roadNetwork) {
+    if (!(roadNetwork->properlyInitialized() and roadNetwork->check())) {
+        errStream << "Import aborted: Not all preconditions met" << std::endl;
+        return ImportAborted;
+    }
+
+    REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+    REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+
+    // Het openen zelf controleert of het bestand bestaat
+    MappedFile file;
+    if (!file.open(filename)) {
+        errStream << "Import aborted: Error raised when opening the file" << std::endl;
+        return ImportAborted;
+    }
+    return importDocument(file.getData(), file.getSize(), errStream, roadNetwork);
+}
+
+SuccessEnum NetworkImporter::importDocument(const char *data, std::size_t size, std::ostream &errStream,
+                                            RoadNetwork *roadNetwork) {
+    if (NetworkScenario::isScenario(data, size)) {
+        return importScenario(data, size, errStream, roadNetwork);
+    }
+    XmlElementStream elements(data, size);
+    return importElements(elements, errStream, roadNetwork);
+}
+
+SuccessEnum NetworkImporter::importScenario(const char *data, std::size_t size, std::ostream &errStream,
+                                            RoadNetwork *roadNetwork) {
+    // Een scenario beschrijft het hele netwerk, het wordt niet bij een ander netwerk gevoegd
+    if (roadNetwork->nrOfRoads() != 0 or roadNetwork->nrOfCars() != 0) {
+        errStream << "Import aborted: Een binair scenario kan enkel in een leeg netwerk ingelezen worden" << std::endl;
+        return ImportAborted;
+    }
+
+    // Een beschadigd scenario laat niets achter in het netwerk
+    if (!NetworkScenario::load(data, size, roadNetwork)) {
+        errStream << "Import aborted: Ongeldig of beschadigd binair scenario" << std::endl;
+        return ImportAborted;
+    }
 
+    if (!roadNetwork->check()) {
+        errStream << "Import Failed: Something unknown went wrong :-(" << std::endl;
+        return ImportFailed;
+    }
+
+    ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+    return Success;
+}
+
+SuccessEnum NetworkImporter::importElements(XmlElementStream &elements, std::ostream &errStream,
+                                            RoadNetwork *roadNetwork) {
+
+    try {
+
+        SuccessEnum endResult = Success;
+
+        if (!elements.openRoot("ROOT")) {
+            errStream << "Import aborted: Expected <ROOT> --- </ROOT> " << std::endl;
+            return ImportAborted;
+        }
+
+        // Elk element wordt apart geparsed en meteen ingelezen, er zit nooit meer dan een element in het geheugen
+        std::string elementText;
+        TiXmlDocument element;
+        roadNetwork->startBulkLoad();
+        while (elements.nextElement(elementText)) {
+            element.Clear();
+            element.Parse(elementText.c_str());
+            if (element.Error() or element.FirstChildElement() == NULL) {
+                endResult = PartialImport;
+                errStream << "Partial Import: Ongeldige xml, element overslaan" << element.ErrorDesc() << std::endl;
+                continue;
+            }
+            readElement(element.FirstChildElement(), roadNetwork, endResult, errStream);
+        }
+        roadNetwork->finishBulkLoad();
+
+        if (elements.isDamaged()) {
+            // De elementen voor het onvolledige element zijn al ingelezen
+            endResult = PartialImport;
+            errStream << "Partial Import: Het bestand eindigt voor </ROOT>, de rest wordt overgeslagen" << std::endl;
         }
 
         if (!roadNetwork->check()) {
@@ -109,9 +248,12 @@ NetworkImporter::importRoadNetwork(const std::string &filename, std::ostream &er
             return ImportFailed;
         }
 
-        ENSURE(roadNetwork->check(), "The roadnetwork is still valid");
+        ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
         return endResult;
     } catch (...) {
+        if (roadNetwork->isBulkLoading()) {
+            roadNetwork->finishBulkLoad();
+        }
         errStream
                 << "Import Failed: Everything is on fire, there are zombies everywhere, this world is doomed. "
                    "Nobody knows what happened. Never. Ever. Touch this project again."
@@ -120,9 +262,55 @@ NetworkImporter::importRoadNetwork(const std::string &filename, std::ostream &er
     }
 }
 
+void NetworkImporter::readElement(TiXmlElement *current_node, RoadNetwork *roadNetwork, SuccessEnum &endResult,
+                                  std::ostream &errStream) {
+    std::string type = current_node->Value();
+
+    if (type == "BAAN") {
+        readRoad(current_node, roadNetwork, endResult, errStream);
+    } else if (type == "VOERTUIG") {
+
+        TiXmlNode *vehicleTypeNode = current_node->FirstChild()->FirstChild();
+        if (vehicleTypeNode == NULL) {
+            endResult = PartialImport;
+            errStream << "Partial Import: Vehicle type not specified, ignoring" << std::endl;
+            return;
+        }
+
+        if (vehicleTypeNode->FirstChild() != NULL) {
+            errStream << "Partial Import: Ongeldige string in de node" << std::endl;
+            endResult = PartialImport;
+            return;
+        }
+
+        std::string vehicleType = vehicleTypeNode->ToText()->Value();
+
+        // Het netwerk maakt het voertuig aan in de pool van zijn type
+        Vehicle *car = roadNetwork->createVehicle(vehicleType);
+        if (car == NULL) {
+            endResult = PartialImport;
+            errStream << "Partial Import: Vehicle type not recognized, ignoring" << std::endl;
+            return;
+        }
+
+        readVehicle(current_node, roadNetwork, endResult, errStream, car);
+        if (roadNetwork->findCar(car->getLicensePlate()) != car) {
+            // Het voertuig is niet toegevoegd, zijn slot kan hergebruikt worden
+            roadNetwork->destroyVehicle(car);
+        }
+
+    } else if (type == "VERKEERSTEKEN") {
+        readRoadSign(current_node, roadNetwork, endResult, errStream);
+    } else {
+        endResult = PartialImport;
+        errStream << "Partial Import: Type not recognized, ignoring" << std::endl;
+
+    }
+}
+
 void NetworkImporter::readRoad(TiXmlElement *current_node, RoadNetwork *roadNetwork, SuccessEnum &endResult,
                                std::ostream &errStream) {
-    Road *road = new Road(); // Deze regel is nodig omdat je anders een uninitialized compiling error krijgt
+    Road *road = roadNetwork->createRoad(); // Deze regel is nodig omdat je anders een uninitialized compiling error krijgt
 
     // Get the specifications from the specification tags in the xml file
     for (TiXmlElement *elem = current_node->FirstChildElement();
@@ -146,9 +334,9 @@ void NetworkImporter::readRoad(TiXmlElement *current_node, RoadNetwork *roadNetw
         std::string el = text->ToText()->Value();
 
         if (elemName == "naam") {
-            delete road;
+            roadNetwork->destroyRoad(road);
             if (roadNetwork->retrieveIntersectionRoad(el) == NULL) {
-                road = new Road;
+                road = roadNetwork->createRoad();
                 if (!road->setName(el)) {
                     endResult = PartialImport;
                     errStream << "Partial Import: Ongeldige informatie bij de naam van de weg" << std::endl;
@@ -170,7 +358,7 @@ void NetworkImporter::readRoad(TiXmlElement *current_node, RoadNetwork *roadNetw
                 return;
             }
         } else if (elemName == "verbinding") {
-            Road *exit_road = new Road;
+            Road *exit_road = roadNetwork->createRoad();
             exit_road->setName(el);
             if (!road->setIntersection(exit_road)) {
                 endResult = PartialImport;
@@ -390,7 +578,27 @@ void NetworkImporter::readRoadSign(TiXmlElement *current_node, RoadNetwork *road
             return;
         }
 
-        if (!road->addTrafficLight(position)) {
+        // Optioneel: een eigen cyclus en offset voor dit licht, in seconden
+        const char *cycleElements[] = {"groen", "oranje", "rood", "offset"};
+        double cycle[] = {CONST::GREEN_DURATION, CONST::ORANGE_DURATION, CONST::RED_DURATION, -1};
+        for (int i = 0; i < 4; ++i) {
+            TiXmlElement *cycleElement = current_node->FirstChildElement(cycleElements[i]);
+            if (cycleElement == NULL) {
+                continue;
+            }
+            if (cycleElement->FirstChildElement() != NULL or cycleElement->FirstChild() == NULL or
+                !checkInt(cycleElement->FirstChild()->ToText()->Value())) {
+                endResult = PartialImport;
+                errStream << "Partial Import: De " << cycleElements[i] << " van het verkeerslicht is geen integer"
+                          << std::endl;
+                return;
+            }
+            cycle[i] = std::strtod(cycleElement->FirstChild()->ToText()->Value(), NULL);
+        }
+
+        // Zonder offset begint het licht op een willekeurig moment in zijn cyclus
+        int offset = cycle[3] == -1 ? rand() : cycle[3];
+        if (!road->addTrafficLight(position, offset, cycle[0], cycle[1], cycle[2])) {
             endResult = PartialImport;
             errStream << "Partial Import: Ongeldige informatie bij het toevoegen van het verkeerslicht aan de weg"
                       << std::endl;
@@ -9,11 +9,14 @@
 #ifndef ANTROPSE_NETWORKIMPORTER_H
 #define ANTROPSE_NETWORKIMPORTER_H
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include "RoadNetwork.h"
 #include "TinyXML/tinyxml.h"
 
+class XmlElementStream;
+
 /**
  * ImportFailed: Something went wrong and we're not sure what has been changed to roadNetwork (This is an error)
  * ImportAborted: Nothing has been changed to your roadNetwork
@@ -29,6 +32,29 @@ enum SuccessEnum {
  */
 class NetworkImporter {
 private:
+    /**
+     * Read a child element of the root: a road, a vehicle or a road sign
+     */
+    static void readElement(TiXmlElement *current_node, RoadNetwork *roadNetwork, SuccessEnum &endResult,
+                            std::ostream &errStream);
+
+    /**
+     * Import the children of <ROOT> one by one, the parse path shared by every import except the one from a file name
+     */
+    static SuccessEnum importElements(XmlElementStream &elements, std::ostream &errStream, RoadNetwork *roadNetwork);
+
+    /**
+     * Import a document in memory, xml or a binary NetworkScenario, for the imports from a buffer or a mapped file
+     */
+    static SuccessEnum importDocument(const char *data, std::size_t size, std::ostream &errStream,
+                                      RoadNetwork *roadNetwork);
+
+    /**
+     * Load a binary NetworkScenario in an empty network
+     */
+    static SuccessEnum importScenario(const char *data, std::size_t size, std::ostream &errStream,
+                                      RoadNetwork *roadNetwork);
+
     static void readRoad(TiXmlElement *current_node, RoadNetwork *roadNetwork, SuccessEnum &endResult,
                          std::ostream &errStream);
 
@@ -42,6 +68,10 @@ public:
     /**
      * Import a roadnetwork from an xml file
      *
+     * The whole document is parsed before anything is added, so a file with invalid xml (e.g. without </ROOT>) is
+     * aborted. The file is opened once: a binary NetworkScenario is recognised by its first bytes and loaded like
+     * importMappedRoadNetwork does.
+     *
      * @param filename The name of the file you want to import the network from
      * @param errStream The stream to which you want the errors to be written
      * @param roadNetwork The roadnetwork where you want to add the elements from the file to
@@ -54,15 +84,106 @@ public:
      *
      * @pre
      * REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
-     * REQUIRE(roadNetwork->check(), "The roadnetwork must be valid");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
      * REQUIRE(fileExists(filename), "Het bestand dat je wil inlezen moet bestaan");
      *
      * @post
-     * ENSURE(roadNetwork->check(), "The roadnetwork is still valid");
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
      *
      */
     static SuccessEnum
     importRoadNetwork(const std::string &filename, std::ostream &errStream, RoadNetwork *roadNetwork);
+
+    /**
+     * Import a roadnetwork from an xml file, without loading the whole file in memory
+     *
+     * The children of <ROOT> are read one by one from the file, and every road, vehicle or road sign is added with the
+     * same checks as importRoadNetwork as soon as it has been read. So the memory used doesn't grow with the size of the
+     * file, only with the size of the largest element. Because the file isn't checked completely before the first
+     * element is added, an invalid element or an end of the file before </ROOT> gives a PartialImport with everything
+     * before it added, where importRoadNetwork aborts. A binary NetworkScenario is read from the same stream and loaded
+     * like importMappedRoadNetwork does.
+     *
+     * @param filename The name of the file you want to import the network from
+     * @param errStream The stream to which you want the errors to be written
+     * @param roadNetwork The roadnetwork where you want to add the elements from the file to
+     *
+     * @return A SuccessEnum, like importRoadNetwork
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+     * REQUIRE(fileExists(filename), "Het bestand dat je wil inlezen moet bestaan");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+     */
+    static SuccessEnum
+    importRoadNetworkStreaming(const std::string &filename, std::ostream &errStream, RoadNetwork *roadNetwork);
+
+    /**
+     * Import a roadnetwork from xml in a stream, e.g. generated in memory, in the same way as importRoadNetworkStreaming
+     *
+     * @param inStream The stream with the xml document
+     * @param errStream The stream to which you want the errors to be written
+     * @param roadNetwork The roadnetwork where you want to add the elements from the stream to
+     *
+     * @return A SuccessEnum, like importRoadNetworkStreaming
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+     */
+    static SuccessEnum importRoadNetwork(std::istream &inStream, std::ostream &errStream, RoadNetwork *roadNetwork);
+
+    /**
+     * Import a roadnetwork from xml in memory, in the same way as importRoadNetworkStreaming, without copying the xml
+     *
+     * When the data is a binary NetworkScenario, it's loaded without any parsing. A scenario describes a complete
+     * network, so the network must be empty, otherwise ImportAborted is returned. A damaged scenario gives
+     * ImportAborted as well, and leaves the network empty.
+     *
+     * @param data The xml document, which doesn't have to end with '\0'
+     * @param size The number of bytes in the document
+     * @param errStream The stream to which you want the errors to be written
+     * @param roadNetwork The roadnetwork where you want to add the elements from the document to
+     *
+     * @return A SuccessEnum, like importRoadNetworkStreaming
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+     */
+    static SuccessEnum
+    importRoadNetwork(const char *data, std::size_t size, std::ostream &errStream, RoadNetwork *roadNetwork);
+
+    /**
+     * Import a roadnetwork from an xml file that is mapped in memory, in the same way as importRoadNetworkStreaming
+     *
+     * The file is opened once: when it doesn't exist or can't be read, ImportAborted is returned. The file can be xml
+     * or a binary NetworkScenario, like for importRoadNetwork from memory.
+     *
+     * @param filename The name of the file you want to import the network from
+     * @param errStream The stream to which you want the errors to be written
+     * @param roadNetwork The roadnetwork where you want to add the elements from the file to
+     *
+     * @return A SuccessEnum, like importRoadNetworkStreaming
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Roadnetwork moet juist geinitialiseerd zijn");
+     * REQUIRE_FULL(roadNetwork->check(), "The roadnetwork must be valid");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check(), "The roadnetwork is still valid");
+     */
+    static SuccessEnum
+    importMappedRoadNetwork(const std::string &filename, std::ostream &errStream, RoadNetwork *roadNetwork);
 };
 
 
@@ -12,12 +12,20 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include <fstream>
+#include <sstream>
+#include <stdlib.h>
+#include <unistd.h>
 #include "Vehicle.h"
+#include "Car.h"
 #include "RoadNetwork.h"
 #include "Road.h"
 #include "CONST.h"
 #include "NetworkImporter.h"
 #include "AntropseUtils.h"
+#include "NetworkCheckpoint.h"
+#include "NetworkScenario.h"
+#include "NetworkSections.h"
+#include "BinaryIO.h"
 
 class NetworkImporterTests : public ::testing::Test {
 protected:
@@ -1416,6 +1424,356 @@ TEST_F(NetworkImporterTests, HtmlTagsInsideRoadName) {
 }
 
 //
+TEST_F(NetworkImporterTests, TrafficLightCycle) {
+
+    std::string nameTest = "TrafficLightCycle";
+
+    std::ofstream outputFile;
+    std::string ofname = "tests/inputTests/output/generated/" + nameTest + ".txt";
+    std::string ifname = "tests/inputTests/" + nameTest + ".xml";
+
+    roadNetwork = new RoadNetwork();
+
+    outputFile.open(ofname.c_str());
+    importResult = NetworkImporter::importRoadNetwork(ifname, outputFile, roadNetwork);
+    outputFile.close();
+
+    testRoad = roadNetwork->findRoad("E19");
+
+    EXPECT_EQ(PartialImport, importResult);
+    EXPECT_EQ(2u, testRoad->getTrafficLights().size());
+
+    TrafficLight *light = testRoad->getTrafficLight(40);
+    ASSERT_TRUE(light != NULL);
+    EXPECT_EQ(20, light->getGreenDuration());
+    EXPECT_EQ(4, light->getOrangeDuration());
+    EXPECT_EQ(16, light->getRedDuration());
+    EXPECT_EQ(10, light->getStartOffset());
+    EXPECT_EQ(green, light->getColor(9));
+    EXPECT_EQ(orange, light->getColor(10));
+    EXPECT_EQ(red, light->getColor(14));
+    EXPECT_EQ(green, light->getColor(30));
+
+    light = testRoad->getTrafficLight(80);
+    ASSERT_TRUE(light != NULL);
+    EXPECT_EQ(CONST::GREEN_DURATION, light->getGreenDuration());
+    EXPECT_EQ(CONST::ORANGE_DURATION, light->getOrangeDuration());
+    EXPECT_EQ(50, light->getRedDuration());
+
+    EXPECT_TRUE(testRoad->getTrafficLight(120) == NULL);
+
+    std::string expectedOfname = "tests/inputTests/output/expected/" + nameTest + ".txt";
+    EXPECT_TRUE(fileCompare(expectedOfname, ofname));
+}
+
+TEST_F(NetworkImporterTests, StreamingImport) {
+    // Elk bestand geeft hetzelfde resultaat, dezelfde fouten en hetzelfde netwerk als de import met de DOM
+    const char *nameTests[] = {"DefaultReadFile", "SomeoneFloating", "NoPersonalSpace", "RocketHigh", "WayTooLow",
+                               "BusyDay", "WithoutRoot", "NoOpeningRoot", "MotorBike", "Bus", "Vrachtwagen",
+                               "UnknownVehicle", "UnknownRoadSign", "UnknownType", "EmptyRoadName",
+                               "StringAsSpeedLimit", "DoubleAsSpeedLimit", "NegativeSpeedLimit",
+                               "AlreadyUsedLicensePlate", "DrivingOnNonExistentRoad", "BusStop",
+                               "BusStopOnNonExistentRoad", "Zones", "TrafficLight", "NoRoadSpecified",
+                               "IncorrectRoadLength", "UnknownRoadAttribute", "DoubleRoadName", "CarOffRoad",
+                               "IncompleteZone", "TrafficLightOnUnknownRoad", "BusStopOffRoad",
+                               "TrafficLightWithoutPosition", "TrafficLightOffRoad", "BusStopDoubleAsPosition",
+                               "DoubleLicencePlate", "BusStopMissingRoad", "IncompleteRoadInformation",
+                               "IncompleteCarInformation", "UnknownConnection", "VehicleWithoutType",
+                               "VehicleEmptyType", "RoadSigns", "HtmlTagsInsideRoadName", "TrafficLightCycle"};
+    for (unsigned int i = 0; i < sizeof(nameTests) / sizeof(nameTests[0]); ++i) {
+        std::string ifname = "tests/inputTests/" + std::string(nameTests[i]) + ".xml";
+
+        RoadNetwork domNetwork;
+        std::ostringstream domErrors;
+        srand(0);
+        SuccessEnum domResult = NetworkImporter::importRoadNetwork(ifname, domErrors, &domNetwork);
+
+        RoadNetwork streamedNetwork;
+        std::ostringstream streamedErrors;
+        srand(0);
+        SuccessEnum streamedResult = NetworkImporter::importRoadNetworkStreaming(ifname, streamedErrors,
+                                                                                 &streamedNetwork);
+
+        EXPECT_EQ(domResult, streamedResult) << nameTests[i];
+        EXPECT_EQ(domErrors.str(), streamedErrors.str()) << nameTests[i];
+        std::ostringstream domCheckpoint;
+        std::ostringstream streamedCheckpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(domNetwork, domCheckpoint));
+        EXPECT_TRUE(NetworkCheckpoint::save(streamedNetwork, streamedCheckpoint));
+        EXPECT_TRUE(domCheckpoint.str() == streamedCheckpoint.str()) << nameTests[i];
+    }
+
+    // Zonder </ROOT> zijn alle volledige elementen ingelezen
+    roadNetwork = new RoadNetwork();
+    std::ostringstream errors;
+    importResult = NetworkImporter::importRoadNetworkStreaming("tests/inputTests/NoClosingRoot.xml", errors,
+                                                               roadNetwork);
+    EXPECT_EQ(PartialImport, importResult);
+    EXPECT_EQ(2, roadNetwork->nrOfRoads());
+    EXPECT_EQ(2, roadNetwork->nrOfCars());
+    EXPECT_EQ("Partial Import: Het bestand eindigt voor </ROOT>, de rest wordt overgeslagen\n", errors.str());
+    delete roadNetwork;
+}
+
+TEST_F(NetworkImporterTests, ImportFromMemory) {
+    // Uit een stream, een buffer of een gemapt bestand geeft hetzelfde resultaat als uit de bestandsnaam
+    const char *nameTests[] = {"DefaultReadFile", "BusyDay", "WithoutRoot", "NoOpeningRoot", "NoClosingRoot",
+                               "UnknownVehicle", "DoubleRoadName", "CarOffRoad", "TrafficLight", "Zones",
+                               "HtmlTagsInsideRoadName", "TrafficLightCycle"};
+    for (unsigned int i = 0; i < sizeof(nameTests) / sizeof(nameTests[0]); ++i) {
+        std::string ifname = "tests/inputTests/" + std::string(nameTests[i]) + ".xml";
+        std::ifstream file(ifname.c_str(), std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        // De buffer eindigt niet op '\0', de rest mag niet gelezen worden
+        std::string document = contents.str() + "<ROOT>";
+
+        RoadNetwork expectedNetwork;
+        std::ostringstream expectedErrors;
+        srand(0);
+        SuccessEnum expectedResult = NetworkImporter::importRoadNetworkStreaming(ifname, expectedErrors,
+                                                                                 &expectedNetwork);
+        std::ostringstream expectedCheckpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(expectedNetwork, expectedCheckpoint));
+
+        for (int source = 0; source < 3; ++source) {
+            RoadNetwork network;
+            std::ostringstream errors;
+            std::istringstream inStream(contents.str());
+            srand(0);
+            SuccessEnum result;
+            if (source == 0) {
+                result = NetworkImporter::importRoadNetwork(inStream, errors, &network);
+            } else if (source == 1) {
+                result = NetworkImporter::importRoadNetwork(document.data(), contents.str().size(), errors, &network);
+            } else {
+                result = NetworkImporter::importMappedRoadNetwork(ifname, errors, &network);
+            }
+
+            EXPECT_EQ(expectedResult, result) << nameTests[i] << " " << source;
+            EXPECT_EQ(expectedErrors.str(), errors.str()) << nameTests[i] << " " << source;
+            std::ostringstream checkpoint;
+            EXPECT_TRUE(NetworkCheckpoint::save(network, checkpoint));
+            EXPECT_TRUE(expectedCheckpoint.str() == checkpoint.str()) << nameTests[i] << " " << source;
+        }
+    }
+
+    // Een bestand dat niet bestaat kan niet gemapt worden
+    roadNetwork = new RoadNetwork();
+    std::ostringstream errors;
+    importResult = NetworkImporter::importMappedRoadNetwork("tests/inputTests/NonExistent.xml", errors, roadNetwork);
+    EXPECT_EQ(ImportAborted, importResult);
+    EXPECT_EQ("Import aborted: Error raised when opening the file\n", errors.str());
+    EXPECT_EQ(0, roadNetwork->nrOfRoads());
+    delete roadNetwork;
+}
+
+TEST_F(NetworkImporterTests, LineEndings) {
+    // Met "\r\n" of "\r" als einde van een regel wordt elk bestand ingelezen als met "\n"
+    const char *nameTests[] = {"DefaultReadFile", "BusyDay", "NoOpeningRoot", "UnknownVehicle", "TrafficLight",
+                               "Zones", "HtmlTagsInsideRoadName"};
+    const char *lineEndings[] = {"\r\n", "\r"};
+    for (unsigned int i = 0; i < sizeof(nameTests) / sizeof(nameTests[0]); ++i) {
+        std::string ifname = "tests/inputTests/" + std::string(nameTests[i]) + ".xml";
+        std::ifstream file(ifname.c_str(), std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+
+        RoadNetwork expectedNetwork;
+        std::ostringstream expectedErrors;
+        srand(0);
+        SuccessEnum expectedResult = NetworkImporter::importRoadNetwork(ifname, expectedErrors, &expectedNetwork);
+        std::ostringstream expectedCheckpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(expectedNetwork, expectedCheckpoint));
+
+        for (unsigned int j = 0; j < 2; ++j) {
+            std::string document;
+            for (unsigned int k = 0; k < contents.str().size(); ++k) {
+                if (contents.str()[k] == '\n') {
+                    document += lineEndings[j];
+                } else {
+                    document += contents.str()[k];
+                }
+            }
+            // Een bestand dat een hele pagina vult, heeft geen '\0' meer op de laatste pagina
+            long pageSize = sysconf(_SC_PAGESIZE);
+            document.append(pageSize - document.size() % pageSize, ' ');
+
+            std::string ofname = "tests/inputTests/output/generated/LineEndings" + std::string(nameTests[i]) +
+                                 (j == 0 ? "CRLF" : "CR") + ".xml";
+            std::ofstream output(ofname.c_str(), std::ios::binary);
+            output << document;
+            output.close();
+
+            RoadNetwork network;
+            std::ostringstream errors;
+            srand(0);
+            SuccessEnum result = NetworkImporter::importRoadNetwork(ofname, errors, &network);
+            EXPECT_EQ(expectedResult, result) << ofname;
+            EXPECT_EQ(expectedErrors.str(), errors.str()) << ofname;
+            std::ostringstream checkpoint;
+            EXPECT_TRUE(NetworkCheckpoint::save(network, checkpoint));
+            EXPECT_TRUE(expectedCheckpoint.str() == checkpoint.str()) << ofname;
+        }
+    }
+
+    // Ook in de waarden zelf
+    std::string ofname = "tests/inputTests/output/generated/LineEndingsValues.xml";
+    std::ofstream output(ofname.c_str(), std::ios::binary);
+    output << "<ROOT a=\"1\r\n2\r3\"><!--4\r\n5\r6--><![CDATA[7\r\n8\r9]]></ROOT>";
+    output.close();
+    TiXmlDocument document;
+    ASSERT_TRUE(document.LoadFile(ofname.c_str()));
+    EXPECT_EQ("1\n2\n3", std::string(document.RootElement()->Attribute("a")));
+    EXPECT_EQ("4\n5\n6", std::string(document.RootElement()->FirstChild()->Value()));
+    EXPECT_EQ("7\n8\n9", std::string(document.RootElement()->LastChild()->Value()));
+}
+
+TEST_F(NetworkImporterTests, SharedStrings) {
+    // Gelijke namen en waarden in een document delen hun tekst
+    const char *xml = "<ROOT><VOERTUIG><type>AUTO</type><baan>E19</baan></VOERTUIG>"
+                      "<VOERTUIG><type>AUTO</type><baan>E313</baan></VOERTUIG><BAAN naam=\"E19\"/></ROOT>";
+    TiXmlDocument document;
+    document.Parse(xml);
+    ASSERT_FALSE(document.Error());
+    TiXmlElement *first = document.RootElement()->FirstChildElement();
+    TiXmlElement *second = first->NextSiblingElement();
+    EXPECT_EQ(first->Value(), second->Value());
+    EXPECT_EQ(first->FirstChildElement("type")->GetText(), second->FirstChildElement("type")->GetText());
+    EXPECT_EQ(first->FirstChildElement("baan")->GetText(), second->NextSiblingElement()->Attribute("naam"));
+    EXPECT_NE(first->FirstChildElement("baan")->GetText(), second->FirstChildElement("baan")->GetText());
+
+    // Een gedeelde tekst aanpassen verandert de andere niet
+    second->SetValue("BUS");
+    EXPECT_EQ("VOERTUIG", std::string(first->Value()));
+    EXPECT_EQ("BUS", std::string(second->Value()));
+
+    // Een kopie staat los van het document, dat daarna leeggemaakt en opnieuw gebruikt kan worden
+    document.RootElement()->RemoveChild(first);
+    TiXmlDocument copy(document);
+    document.Clear();
+    document.Parse(xml);
+    ASSERT_FALSE(document.Error());
+    TiXmlPrinter printed;
+    printed.SetStreamPrinting();
+    copy.Accept(&printed);
+    EXPECT_EQ("<ROOT><BUS><type>AUTO</type><baan>E313</baan></BUS><BAAN naam=\"E19\" /></ROOT>",
+              std::string(printed.CStr()));
+    EXPECT_EQ("E19", std::string(document.RootElement()->FirstChildElement()->FirstChildElement("baan")->GetText()));
+}
+
+TEST_F(NetworkImporterTests, ScenarioFormat) {
+    // Een binair scenario en de xml die ervan geschreven wordt geven hetzelfde netwerk als de oorspronkelijke xml
+    const char *nameTests[] = {"DefaultReadFile", "BusyDay", "MotorBike", "Bus", "Vrachtwagen", "BusStop", "Zones",
+                               "TrafficLight", "UnknownConnection", "DoubleRoadName", "RoadSigns",
+                               "HtmlTagsInsideRoadName", "TrafficLightCycle"};
+    for (unsigned int i = 0; i < sizeof(nameTests) / sizeof(nameTests[0]); ++i) {
+        std::string ifname = "tests/inputTests/" + std::string(nameTests[i]) + ".xml";
+        std::string binaryName = "tests/inputTests/output/generated/" + std::string(nameTests[i]) + ".bin";
+        std::string xmlName = "tests/inputTests/output/generated/" + std::string(nameTests[i]) + "Scenario.xml";
+
+        RoadNetwork expectedNetwork;
+        std::ostringstream errors;
+        srand(0);
+        NetworkImporter::importRoadNetwork(ifname, errors, &expectedNetwork);
+        std::ostringstream expectedCheckpoint;
+        EXPECT_TRUE(NetworkCheckpoint::save(expectedNetwork, expectedCheckpoint));
+        EXPECT_TRUE(NetworkScenario::save(expectedNetwork, binaryName)) << nameTests[i];
+        std::ofstream xmlFile(xmlName.c_str());
+        EXPECT_TRUE(NetworkScenario::saveXml(expectedNetwork, xmlFile)) << nameTests[i];
+        xmlFile.close();
+
+        // Met de DOM en uit een stream
+        const std::string fileNames[] = {binaryName, xmlName};
+        for (int file = 0; file < 4; ++file) {
+            RoadNetwork network;
+            std::ostringstream scenarioErrors;
+            SuccessEnum result = file < 2 ?
+                                 NetworkImporter::importRoadNetwork(fileNames[file % 2], scenarioErrors, &network) :
+                                 NetworkImporter::importRoadNetworkStreaming(fileNames[file % 2], scenarioErrors,
+                                                                             &network);
+            EXPECT_EQ(Success, result) << fileNames[file % 2] << " " << scenarioErrors.str();
+            std::ostringstream checkpoint;
+            EXPECT_TRUE(NetworkCheckpoint::save(network, checkpoint));
+            EXPECT_TRUE(expectedCheckpoint.str() == checkpoint.str()) << fileNames[file % 2];
+        }
+    }
+
+    std::ifstream file("tests/inputTests/output/generated/BusyDay.bin", std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    std::string scenario = contents.str();
+
+    // Een binair scenario wordt niet bij een bestaand netwerk gevoegd
+    roadNetwork = new RoadNetwork();
+    NetworkImporter::importRoadNetwork("tests/inputTests/DefaultReadFile.xml", std::cerr, roadNetwork);
+    std::ostringstream errors;
+    importResult = NetworkImporter::importRoadNetwork(scenario.data(), scenario.size(), errors, roadNetwork);
+    EXPECT_EQ(ImportAborted, importResult);
+    EXPECT_EQ("Import aborted: Een binair scenario kan enkel in een leeg netwerk ingelezen worden\n", errors.str());
+    delete roadNetwork;
+
+    // Een afgekapt scenario, een andere versie of een voertuig op een onbestaande weg voegt niets toe
+    std::string damaged[] = {scenario.substr(0, scenario.size() - 1), scenario, scenario};
+    damaged[1][4] = 2;
+    std::size_t vehicles = NetworkScenario::HEADER_SIZE +
+                           BinaryIO::decodeUInt32(scenario.data() + 8) * NetworkSections::ROAD_SIZE +
+                           BinaryIO::decodeUInt32(scenario.data() + 12) * NetworkSections::ZONE_SIZE +
+                           BinaryIO::decodeUInt32(scenario.data() + 16) * NetworkSections::BUS_STOP_SIZE +
+                           BinaryIO::decodeUInt32(scenario.data() + 20) * NetworkSections::TRAFFIC_LIGHT_SIZE;
+    damaged[2][vehicles + 16] = 100;
+    for (int i = 0; i < 3; ++i) {
+        roadNetwork = new RoadNetwork();
+        std::ostringstream damagedErrors;
+        importResult = NetworkImporter::importRoadNetwork(damaged[i].data(), damaged[i].size(), damagedErrors,
+                                                          roadNetwork);
+        EXPECT_EQ(ImportAborted, importResult) << i;
+        EXPECT_EQ("Import aborted: Ongeldig of beschadigd binair scenario\n", damagedErrors.str()) << i;
+        EXPECT_EQ(0, roadNetwork->nrOfRoads());
+        EXPECT_EQ(0, roadNetwork->nrOfCars());
+        delete roadNetwork;
+    }
+}
+
+TEST_F(NetworkImporterTests, DamagedScenarioLeavesNothing) {
+    RoadNetwork network;
+    Road *second = new Road("B", 80, 500, NULL);
+    Road *first = new Road("A", 100, 1000, second);
+    network.addRoad(first);
+    network.addRoad(second);
+    first->addTrafficLight(400, 0, 20, 4, 15);
+    first->addZone(600, 50);
+    network.addCar(new Car("P1", first, 0, 0));
+    network.addCar(new Car("P2", second, 10, 0));
+    std::ostringstream saved;
+    ASSERT_TRUE(NetworkScenario::save(network, saved));
+    std::string scenario = saved.str();
+    std::size_t roads = NetworkScenario::HEADER_SIZE;
+    std::size_t zones = roads + 2 * NetworkSections::ROAD_SIZE;
+    std::size_t trafficLights = zones + NetworkSections::ZONE_SIZE;
+    std::size_t vehicles = trafficLights + NetworkSections::TRAFFIC_LIGHT_SIZE;
+
+    // Elke fout wordt pas gevonden nadat er al wegen of voertuigen gemaakt zijn
+    std::string damaged[] = {scenario, scenario, scenario, scenario, scenario};
+    damaged[0].replace(roads + NetworkSections::ROAD_SIZE, 8, scenario, roads, 8); // Twee wegen met dezelfde naam
+    damaged[1].replace(vehicles + NetworkScenario::VEHICLE_SIZE + 8, 8, scenario, vehicles + 8, 8); // Dezelfde plaat
+    damaged[2].replace(vehicles + NetworkScenario::VEHICLE_SIZE, 8, scenario, vehicles + 8, 8); // Een onbestaand type
+    BinaryIO::encodeDouble(&damaged[3][trafficLights + 32], 0); // Een licht dat nooit rood wordt
+    BinaryIO::encodeDouble(&damaged[4][vehicles + NetworkScenario::VEHICLE_SIZE + 32], 90); // Te snel voor B
+    for (int i = 0; i < 5; ++i) {
+        RoadNetwork damagedNetwork;
+        EXPECT_FALSE(NetworkScenario::load(damaged[i].data(), damaged[i].size(), &damagedNetwork)) << i;
+        EXPECT_EQ(0, damagedNetwork.nrOfRoads()) << i;
+        EXPECT_EQ(0, damagedNetwork.nrOfCars()) << i;
+        EXPECT_EQ(0u, damagedNetwork.getPoolStatistics().live) << i;
+    }
+
+    RoadNetwork loaded;
+    EXPECT_TRUE(NetworkScenario::load(scenario.data(), scenario.size(), &loaded));
+    EXPECT_EQ(2, loaded.nrOfCars());
+    EXPECT_EQ(loaded.findRoad("B"), loaded.findRoad("A")->getIntersection());
+}
+
 //int main(int argc, char **argv) {
 //    ::testing::InitGoogleTest(&argc, argv);
 //    return RUN_ALL_TESTS();
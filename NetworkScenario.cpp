@@ -0,0 +1,184 @@
+/**
+ * @file NetworkScenario.cpp
+ * @brief This file will contain the definitions of the functions in NetworkScenario.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+#include "NetworkScenario.h"
+#include "BinaryIO.h"
+#include "DesignByContract.h"
+#include "NetworkSections.h"
+#include "RoadNetwork.h"
+#include "Road.h"
+#include "TrafficLight.h"
+#include "Vehicle.h"
+#include "TinyXML/tinyxml.h"
+
+const char NetworkScenario::MAGIC[4] = {'A', 'S', 'C', 'N'};
+const uint32_t NetworkScenario::FORMAT_VERSION = 1;
+const std::size_t NetworkScenario::HEADER_SIZE = 48;
+const std::size_t NetworkScenario::VEHICLE_SIZE = 40;
+
+namespace {
+    const std::size_t COUNTS_OFFSET = 8;
+
+    /**
+     * A number as text, strtod reads exactly the same double back
+     */
+    std::string toText(double value) {
+        std::ostringstream text;
+        text.precision(17);
+        text << value;
+        return text.str();
+    }
+
+    void addTextElement(TiXmlElement *parent, const char *name, const std::string &value) {
+        TiXmlElement *element = new TiXmlElement(name);
+        element->LinkEndChild(new TiXmlText(value.c_str()));
+        parent->LinkEndChild(element);
+    }
+
+    TiXmlElement *addRoadSign(TiXmlElement *root, const char *type, const Road *road, double position) {
+        TiXmlElement *sign = new TiXmlElement("VERKEERSTEKEN");
+        addTextElement(sign, "type", type);
+        addTextElement(sign, "baan", road->getName());
+        addTextElement(sign, "positie", toText(position));
+        root->LinkEndChild(sign);
+        return sign;
+    }
+}
+
+bool NetworkScenario::save(RoadNetwork &roadNetwork, std::ostream &outStream) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+
+    NetworkSections::Writer sections(roadNetwork, HEADER_SIZE, COUNTS_OFFSET, VEHICLE_SIZE, false);
+    if (!sections.encodeRoads()) {
+        return false;
+    }
+    const std::vector<Vehicle *> &cars = roadNetwork.getCars();
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        const Vehicle *vehicle = cars[i];
+        // Net als in xml staat een voertuig op een hele positie en rijdt het aan een hele snelheid
+        if (!sections.encodeVehicle(i) or vehicle->getCurrentPosition() != (int) vehicle->getCurrentPosition() or
+            vehicle->getCurrentSpeed() != (int) vehicle->getCurrentSpeed()) {
+            return false;
+        }
+        char *record = sections.getVehicleRecord(i);
+        BinaryIO::encodeDouble(record + 24, vehicle->getCurrentPosition());
+        BinaryIO::encodeDouble(record + 32, vehicle->getCurrentSpeed());
+    }
+
+    char *header = sections.getHeader();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    BinaryIO::encodeUInt32(header + 4, FORMAT_VERSION);
+    return sections.write(outStream);
+}
+
+bool NetworkScenario::save(RoadNetwork &roadNetwork, const std::string &fileName) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    std::ofstream outStream(fileName.c_str(), std::ios::binary);
+    if (!outStream or !save(roadNetwork, outStream)) {
+        return false;
+    }
+    outStream.close();
+    return !outStream.fail();
+}
+
+bool NetworkScenario::saveXml(RoadNetwork &roadNetwork, std::ostream &outStream) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+
+    TiXmlDocument document;
+    TiXmlElement *root = new TiXmlElement("ROOT");
+    document.LinkEndChild(root);
+
+    const std::vector<Road *> &roads = roadNetwork.getRoads();
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        TiXmlElement *road = new TiXmlElement("BAAN");
+        addTextElement(road, "naam", roads[i]->getName());
+        addTextElement(road, "snelheidslimiet", toText(roads[i]->getSpeedLimit()));
+        addTextElement(road, "lengte", toText(roads[i]->getLength()));
+        if (roads[i]->getIntersection() != NULL) {
+            addTextElement(road, "verbinding", roads[i]->getIntersection()->getName());
+        }
+        root->LinkEndChild(road);
+    }
+
+    // De lichten voor de zones, een licht kan niet op het begin van een zone gezet worden
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        const Road *road = roads[i];
+        for (std::map<double, TrafficLight *>::const_iterator it = road->getTrafficLights().begin();
+             it != road->getTrafficLights().end(); ++it) {
+            TiXmlElement *sign = addRoadSign(root, "VERKEERSLICHT", road, it->first);
+            addTextElement(sign, "groen", toText(it->second->getGreenDuration()));
+            addTextElement(sign, "oranje", toText(it->second->getOrangeDuration()));
+            addTextElement(sign, "rood", toText(it->second->getRedDuration()));
+            addTextElement(sign, "offset", toText(it->second->getStartOffset()));
+        }
+        for (std::set<double>::const_iterator it = road->getBusStops().begin(); it != road->getBusStops().end(); ++it) {
+            addRoadSign(root, "BUSHALTE", road, *it);
+        }
+        for (std::map<double, int>::const_iterator it = road->getZones().begin(); it != road->getZones().end(); ++it) {
+            TiXmlElement *sign = addRoadSign(root, "ZONE", road, it->first);
+            addTextElement(sign, "snelheidslimiet", toText(it->second));
+        }
+    }
+
+    const std::vector<Vehicle *> &cars = roadNetwork.getCars();
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        TiXmlElement *vehicle = new TiXmlElement("VOERTUIG");
+        addTextElement(vehicle, "type", cars[i]->getType());
+        addTextElement(vehicle, "nummerplaat", cars[i]->getLicensePlate());
+        addTextElement(vehicle, "baan", cars[i]->getCurrentRoad()->getName());
+        addTextElement(vehicle, "positie", toText(cars[i]->getCurrentPosition()));
+        addTextElement(vehicle, "snelheid", toText(cars[i]->getCurrentSpeed()));
+        root->LinkEndChild(vehicle);
+    }
+
+    TiXmlPrinter printer;
+    document.Accept(&printer);
+    outStream << printer.CStr();
+    return outStream.good();
+}
+
+bool NetworkScenario::isScenario(const char *data, std::size_t size) {
+    return size >= sizeof(MAGIC) and std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool NetworkScenario::load(const char *data, std::size_t size, RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+
+    if (size < HEADER_SIZE or !isScenario(data, size) or BinaryIO::decodeUInt32(data + 4) != FORMAT_VERSION) {
+        return false;
+    }
+    // Zoals na de import staat elk voertuig in de rij van zijn weg
+    NetworkSections::Reader sections(HEADER_SIZE, COUNTS_OFFSET, VEHICLE_SIZE, false);
+    if (!sections.read(data, size) or sections.getNrOfQueued() != sections.getNrOfVehicles() or
+        !sections.createRoads(roadNetwork)) {
+        return false;
+    }
+
+    // De voertuigen worden ingesteld zoals bij de import, met dezelfde controles
+    for (uint32_t i = 0; i < sections.getNrOfVehicles(); ++i) {
+        const char *record = sections.getVehicleRecord(i);
+        double position = BinaryIO::decodeDouble(record + 24);
+        Vehicle *vehicle = sections.createVehicle(roadNetwork, i);
+        if (vehicle == NULL or !vehicle->setCurrentRoad(sections.getVehicleRoad(i)) or position != (int) position or
+            !vehicle->setCurrentPosition((int) position) or
+            !vehicle->setCurrentSpeed(BinaryIO::decodeDouble(record + 32))) {
+            sections.rollBack(roadNetwork);
+            return false;
+        }
+    }
+    sections.addToNetwork(roadNetwork);
+    return true;
+}
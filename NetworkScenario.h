@@ -0,0 +1,102 @@
+/**
+ * @file NetworkScenario.h
+ * @brief This header file will contain the NetworkScenario class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_NETWORKSCENARIO_H
+#define ANTROPSE_NETWORKSCENARIO_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+class RoadNetwork;
+
+/**
+ * Save the start of a simulation in a binary scenario, the compact counterpart of the xml input, and load it again
+ *
+ * A scenario contains what an xml file can describe: the roads with their connection, zones, bus stops and traffic
+ * lights, and every vehicle with its type, license plate, road, position and speed. A scenario is written from a
+ * network that has just been imported, and loading it gives the same network as the import, without parsing a single
+ * number: the order of the roads, of the vehicles in the network and of the queues on every road are stored as well.
+ * Unlike a NetworkCheckpoint, the settings of the network and the state of the vehicles during a simulation aren't.
+ *
+ * Everything is little endian, in fixed-size records of a multiple of 8 bytes: a header of HEADER_SIZE bytes, then
+ * the sections of NetworkSections with vehicle records of VEHICLE_SIZE bytes. Every name, type and license plate is
+ * stored once in the string section. The version is checked when loading, a scenario of another version can only be
+ * converted again from its xml.
+ */
+class NetworkScenario {
+public:
+    /**
+     * Write a network as a binary scenario
+     *
+     * @param roadNetwork The network to save, before its first iteration
+     * @param outStream The stream to write to, opened in binary mode
+     *
+     * @return true when the scenario has been written, false when the network can't be described by a scenario (e.g. a
+     * vehicle that isn't on a whole position)
+     *
+     * @pre
+     * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    static bool save(RoadNetwork &roadNetwork, std::ostream &outStream);
+
+    /**
+     * Write a network as a binary scenario to a file
+     *
+     * @pre
+     * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    static bool save(RoadNetwork &roadNetwork, const std::string &fileName);
+
+    /**
+     * Write a network as xml, in the format of the NetworkImporter
+     *
+     * Importing the xml gives the same network: the roads come first, then the road signs and the vehicles in the
+     * order of the network.
+     *
+     * @param roadNetwork The network to save, before its first iteration
+     * @param outStream The stream to write to
+     *
+     * @return true when the xml has been written
+     *
+     * @pre
+     * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    static bool saveXml(RoadNetwork &roadNetwork, std::ostream &outStream);
+
+    /**
+     * @return true when the data starts like a binary scenario, whether its version is supported or not
+     */
+    static bool isScenario(const char *data, std::size_t size);
+
+    /**
+     * Load a binary scenario from memory
+     *
+     * @param data The scenario
+     * @param size The number of bytes in the scenario
+     * @param roadNetwork An empty network to load the scenario in
+     *
+     * @return true when the scenario has been loaded. When the scenario is damaged (e.g. a vehicle that is faster than
+     * its road allows), false is returned and the network stays empty.
+     *
+     * @pre
+     * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+     */
+    static bool load(const char *data, std::size_t size, RoadNetwork *roadNetwork);
+
+    static const char MAGIC[4];
+    static const uint32_t FORMAT_VERSION;
+    static const std::size_t HEADER_SIZE;
+    static const std::size_t VEHICLE_SIZE;
+};
+
+
+#endif //ANTROPSE_NETWORKSCENARIO_H
@@ -0,0 +1,436 @@
+/**
+ * @file NetworkSections.cpp
+ * @brief This file will contain the definitions of the functions in NetworkSections.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include <map>
+#include <set>
+#include "NetworkSections.h"
+#include "DesignByContract.h"
+#include "RoadNetwork.h"
+#include "Road.h"
+#include "TrafficLight.h"
+#include "Vehicle.h"
+
+namespace {
+    /**
+     * The size of the string section follows the six counts, on a multiple of 8
+     */
+    std::size_t getStringSizeOffset(std::size_t countsOffset) {
+        return (countsOffset + 6 * 4 + 7) / 8 * 8;
+    }
+
+    void encodeString(char *record, const std::string &value, BinaryIO::StringSection &strings) {
+        BinaryIO::encodeUInt32(record, strings.add(value));
+        BinaryIO::encodeUInt32(record + 4, value.size());
+    }
+
+    bool validString(const char *record, uint64_t stringSize) {
+        return BinaryIO::validString(BinaryIO::decodeUInt32(record), BinaryIO::decodeUInt32(record + 4), stringSize);
+    }
+
+    /**
+     * Whether the strings at a fixed offset in a number of records are all different, e.g. the license plates of a
+     * million vehicles. The strings are compared in the string section, in a table of record indices without copying
+     * them or allocating a node per string.
+     */
+    bool differentStrings(const char *records, std::size_t recordSize, uint32_t nrOfRecords, const char *strings) {
+        std::size_t nrOfSlots = 1;
+        while (nrOfSlots < 2 * (std::size_t) nrOfRecords) {
+            nrOfSlots *= 2;
+        }
+        // Een plaats bevat de index + 1 van een record, 0 is leeg
+        std::vector<uint32_t> slots(nrOfSlots, 0);
+        for (uint32_t i = 0; i < nrOfRecords; ++i) {
+            const char *value = strings + BinaryIO::decodeUInt32(records + i * recordSize);
+            uint32_t size = BinaryIO::decodeUInt32(records + i * recordSize + 4);
+            // FNV-1a
+            std::size_t hash = 2166136261u;
+            for (uint32_t c = 0; c < size; ++c) {
+                hash = (hash ^ (unsigned char) value[c]) * 16777619u;
+            }
+            std::size_t slot = hash & (nrOfSlots - 1);
+            while (slots[slot] != 0) {
+                const char *other = records + (slots[slot] - 1) * recordSize;
+                if (BinaryIO::decodeUInt32(other + 4) == size and
+                    std::memcmp(strings + BinaryIO::decodeUInt32(other), value, size) == 0) {
+                    return false;
+                }
+                slot = (slot + 1) & (nrOfSlots - 1);
+            }
+            slots[slot] = i + 1;
+        }
+        return true;
+    }
+}
+
+void NetworkSections::Layout::calculateOffsets(std::size_t headerSize, std::size_t vehicleSize) {
+    roads = headerSize;
+    zones = roads + (uint64_t) nrOfRoads * ROAD_SIZE;
+    busStops = zones + (uint64_t) nrOfZones * ZONE_SIZE;
+    trafficLights = busStops + (uint64_t) nrOfBusStops * BUS_STOP_SIZE;
+    vehicles = trafficLights + (uint64_t) nrOfTrafficLights * TRAFFIC_LIGHT_SIZE;
+    queues = vehicles + (uint64_t) nrOfVehicles * vehicleSize;
+    // Een index is 4 bytes, de strings beginnen op een veelvoud van 8
+    strings = queues + ((uint64_t) nrOfQueued * 4 + 7) / 8 * 8;
+    size = strings + stringSize;
+}
+
+NetworkSections::Writer::Writer(const RoadNetwork &roadNetwork, std::size_t headerSize, std::size_t countsOffset,
+                                std::size_t vehicleSize, bool allowConnections)
+        : roads(roadNetwork.getRoads()), cars(roadNetwork.getCars()), countsOffset(countsOffset),
+          vehicleSize(vehicleSize) {
+    REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+
+    layout.nrOfRoads = roads.size();
+    layout.nrOfZones = 0;
+    layout.nrOfBusStops = 0;
+    layout.nrOfTrafficLights = 0;
+    layout.nrOfVehicles = cars.size();
+    layout.nrOfQueued = 0;
+    layout.stringSize = 0;
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        roadIndices[roads[i]] = i;
+        layout.nrOfZones += roads[i]->getZones().size();
+        layout.nrOfBusStops += roads[i]->getBusStops().size();
+        layout.nrOfTrafficLights += roads[i]->getTrafficLights().size();
+        for (Vehicle *vehicle = roads[i]->getFirstVehicle(); vehicle != NULL; vehicle = vehicle->getVehicleAhead()) {
+            layout.nrOfQueued++;
+        }
+    }
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        vehicleIndices[cars[i]] = i;
+    }
+    if (allowConnections) {
+        // Een voertuig op een verbinding naar een weg buiten het netwerk wordt bewaard als -1 - de weg ervoor
+        for (unsigned int i = 0; i < roads.size(); ++i) {
+            if (roads[i]->getIntersection() != NULL and !roadIndices.count(roads[i]->getIntersection())) {
+                roadIndices.insert(std::make_pair(roads[i]->getIntersection(), -1 - (int32_t) i));
+            }
+        }
+    }
+    layout.calculateOffsets(headerSize, vehicleSize);
+    buffer.assign(layout.strings, 0);
+}
+
+bool NetworkSections::Writer::encodeRoads() {
+    char *zone = &buffer[0] + layout.zones;
+    char *busStop = &buffer[0] + layout.busStops;
+    char *trafficLight = &buffer[0] + layout.trafficLights;
+    char *queue = &buffer[0] + layout.queues;
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        const Road *road = roads[i];
+        char *record = &buffer[0] + layout.roads + i * ROAD_SIZE;
+        encodeString(record, road->getName(), strings);
+        // Een verbinding wordt op naam bewaard, ze kan naar een weg buiten het netwerk wijzen
+        if (road->getIntersection() != NULL) {
+            encodeString(record + 8, road->getIntersection()->getName(), strings);
+        }
+        BinaryIO::encodeInt32(record + 16, road->getSpeedLimit());
+        BinaryIO::encodeUInt32(record + 20, road->getZones().size());
+        BinaryIO::encodeUInt32(record + 24, road->getBusStops().size());
+        BinaryIO::encodeUInt32(record + 28, road->getTrafficLights().size());
+        BinaryIO::encodeDouble(record + 40, road->getLength());
+
+        for (std::map<double, int>::const_iterator it = road->getZones().begin(); it != road->getZones().end(); ++it) {
+            BinaryIO::encodeDouble(zone, it->first);
+            BinaryIO::encodeInt32(zone + 8, it->second);
+            zone += ZONE_SIZE;
+        }
+        for (std::set<double>::const_iterator it = road->getBusStops().begin(); it != road->getBusStops().end(); ++it) {
+            BinaryIO::encodeDouble(busStop, *it);
+            busStop += BUS_STOP_SIZE;
+        }
+        for (std::map<double, TrafficLight *>::const_iterator it = road->getTrafficLights().begin();
+             it != road->getTrafficLights().end(); ++it) {
+            BinaryIO::encodeDouble(trafficLight, it->first);
+            BinaryIO::encodeDouble(trafficLight + 8, it->second->getStartOffset());
+            BinaryIO::encodeDouble(trafficLight + 16, it->second->getGreenDuration());
+            BinaryIO::encodeDouble(trafficLight + 24, it->second->getOrangeDuration());
+            BinaryIO::encodeDouble(trafficLight + 32, it->second->getRedDuration());
+            trafficLight += TRAFFIC_LIGHT_SIZE;
+        }
+
+        // Van voor naar achter, zodat elk voertuig bij het inlezen vooraan de rij kan aansluiten
+        uint32_t nrOfQueued = 0;
+        for (Vehicle *vehicle = road->getLastVehicle(); vehicle != NULL; vehicle = vehicle->getVehicleBehind()) {
+            std::tr1::unordered_map<const Vehicle *, uint32_t>::const_iterator index = vehicleIndices.find(vehicle);
+            if (index == vehicleIndices.end()) {
+                return false;
+            }
+            BinaryIO::encodeUInt32(queue, index->second);
+            queue += 4;
+            nrOfQueued++;
+        }
+        BinaryIO::encodeUInt32(record + 32, nrOfQueued);
+    }
+    return true;
+}
+
+bool NetworkSections::Writer::encodeVehicle(unsigned int index) {
+    const Vehicle *vehicle = cars[index];
+    std::tr1::unordered_map<const Road *, int32_t>::const_iterator road = roadIndices.find(vehicle->getCurrentRoad());
+    if (road == roadIndices.end()) {
+        return false;
+    }
+    char *record = getVehicleRecord(index);
+    encodeString(record, vehicle->getType(), strings);
+    encodeString(record + 8, vehicle->getLicensePlate(), strings);
+    BinaryIO::encodeInt32(record + 16, road->second);
+    return true;
+}
+
+char *NetworkSections::Writer::getHeader() {
+    return &buffer[0];
+}
+
+char *NetworkSections::Writer::getVehicleRecord(unsigned int index) {
+    return &buffer[0] + layout.vehicles + index * vehicleSize;
+}
+
+bool NetworkSections::Writer::write(std::ostream &outStream) {
+    char *counts = getHeader() + countsOffset;
+    BinaryIO::encodeUInt32(counts, layout.nrOfRoads);
+    BinaryIO::encodeUInt32(counts + 4, layout.nrOfZones);
+    BinaryIO::encodeUInt32(counts + 8, layout.nrOfBusStops);
+    BinaryIO::encodeUInt32(counts + 12, layout.nrOfTrafficLights);
+    BinaryIO::encodeUInt32(counts + 16, layout.nrOfVehicles);
+    BinaryIO::encodeUInt32(counts + 20, layout.nrOfQueued);
+    BinaryIO::encodeUInt64(getHeader() + getStringSizeOffset(countsOffset), strings.getData().size());
+
+    outStream.write(&buffer[0], buffer.size());
+    outStream.write(strings.getData().data(), strings.getData().size());
+    return outStream.good();
+}
+
+NetworkSections::Reader::Reader(std::size_t headerSize, std::size_t countsOffset, std::size_t vehicleSize,
+                                bool allowConnections)
+        : data(NULL), strings(NULL), headerSize(headerSize), countsOffset(countsOffset), vehicleSize(vehicleSize),
+          allowConnections(allowConnections) {
+}
+
+bool NetworkSections::Reader::read(const char *newData, std::size_t size) {
+    data = newData;
+    const char *counts = data + countsOffset;
+    layout.nrOfRoads = BinaryIO::decodeUInt32(counts);
+    layout.nrOfZones = BinaryIO::decodeUInt32(counts + 4);
+    layout.nrOfBusStops = BinaryIO::decodeUInt32(counts + 8);
+    layout.nrOfTrafficLights = BinaryIO::decodeUInt32(counts + 12);
+    layout.nrOfVehicles = BinaryIO::decodeUInt32(counts + 16);
+    layout.nrOfQueued = BinaryIO::decodeUInt32(counts + 20);
+    layout.stringSize = BinaryIO::decodeUInt64(data + getStringSizeOffset(countsOffset));
+    if (layout.stringSize > size) {
+        return false;
+    }
+    layout.calculateOffsets(headerSize, vehicleSize);
+    if (layout.size != size) {
+        return false;
+    }
+    strings = data + layout.strings;
+
+    uint64_t nrOfZones = 0;
+    uint64_t nrOfBusStops = 0;
+    uint64_t nrOfTrafficLights = 0;
+    uint64_t nrOfQueued = 0;
+    for (uint32_t i = 0; i < layout.nrOfRoads; ++i) {
+        const char *record = getRoadRecord(i);
+        if (!validString(record, layout.stringSize) or !validString(record + 8, layout.stringSize)) {
+            return false;
+        }
+        nrOfZones += BinaryIO::decodeUInt32(record + 20);
+        nrOfBusStops += BinaryIO::decodeUInt32(record + 24);
+        nrOfTrafficLights += BinaryIO::decodeUInt32(record + 28);
+        nrOfQueued += BinaryIO::decodeUInt32(record + 32);
+    }
+    if (nrOfZones != layout.nrOfZones or nrOfBusStops != layout.nrOfBusStops or
+        nrOfTrafficLights != layout.nrOfTrafficLights or nrOfQueued != layout.nrOfQueued) {
+        return false;
+    }
+
+    uint64_t nrOfVehiclesOnRoads = 0;
+    for (uint32_t i = 0; i < layout.nrOfVehicles; ++i) {
+        const char *record = getVehicleRecord(i);
+        int32_t road = BinaryIO::decodeInt32(record + 16);
+        if (!validString(record, layout.stringSize) or !validString(record + 8, layout.stringSize) or
+            road >= (int64_t) layout.nrOfRoads) {
+            return false;
+        }
+        nrOfVehiclesOnRoads += road >= 0;
+        // Enkel een weg die een verbinding heeft, kan naar een voertuig op die verbinding verwijzen
+        if (road < 0 and (!allowConnections or road < -(int64_t) layout.nrOfRoads or
+                          BinaryIO::decodeUInt32(getRoadRecord(-1 - road) + 12) == 0)) {
+            return false;
+        }
+    }
+    // Elk voertuig op een weg staat in een rij, anders zou het niet in de rij van zijn weg terechtkomen
+    if (nrOfVehiclesOnRoads != layout.nrOfQueued) {
+        return false;
+    }
+
+    // De namen en de nummerplaten zijn uniek, anders zou het netwerk ze pas weigeren als het al aangepast is
+    if (!differentStrings(data + layout.roads, ROAD_SIZE, layout.nrOfRoads, strings) or
+        !differentStrings(data + layout.vehicles + 8, vehicleSize, layout.nrOfVehicles, strings)) {
+        return false;
+    }
+
+    // Elk voertuig staat hoogstens een keer in een rij, die van zijn eigen weg
+    std::vector<bool> queued(layout.nrOfVehicles, false);
+    const char *queue = data + layout.queues;
+    for (uint32_t i = 0; i < layout.nrOfRoads; ++i) {
+        for (uint32_t count = BinaryIO::decodeUInt32(getRoadRecord(i) + 32); count > 0; --count) {
+            uint32_t vehicle = BinaryIO::decodeUInt32(queue);
+            if (vehicle >= layout.nrOfVehicles or queued[vehicle] or
+                BinaryIO::decodeInt32(getVehicleRecord(vehicle) + 16) != (int64_t) i) {
+                return false;
+            }
+            queued[vehicle] = true;
+            queue += 4;
+        }
+    }
+    return true;
+}
+
+uint32_t NetworkSections::Reader::getNrOfVehicles() const {
+    return layout.nrOfVehicles;
+}
+
+uint32_t NetworkSections::Reader::getNrOfQueued() const {
+    return layout.nrOfQueued;
+}
+
+const char *NetworkSections::Reader::getVehicleRecord(uint32_t index) const {
+    return data + layout.vehicles + (uint64_t) index * vehicleSize;
+}
+
+const char *NetworkSections::Reader::getRoadRecord(uint32_t index) const {
+    return data + layout.roads + (uint64_t) index * ROAD_SIZE;
+}
+
+std::string NetworkSections::Reader::decodeString(const char *record) const {
+    return std::string(strings + BinaryIO::decodeUInt32(record), BinaryIO::decodeUInt32(record + 4));
+}
+
+bool NetworkSections::Reader::createRoads(RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+
+    std::tr1::unordered_map<std::string, Road *> roadsByName;
+    const char *zone = data + layout.zones;
+    const char *busStop = data + layout.busStops;
+    const char *trafficLight = data + layout.trafficLights;
+    bool valid = true;
+    roads.reserve(layout.nrOfRoads);
+    for (uint32_t i = 0; i < layout.nrOfRoads and valid; ++i) {
+        const char *record = getRoadRecord(i);
+        Road *road = roadNetwork->createRoad();
+        roads.push_back(road);
+        valid = road->setName(decodeString(record)) and road->setSpeedLimit(BinaryIO::decodeInt32(record + 16)) and
+                road->setLength(BinaryIO::decodeDouble(record + 40));
+        roadsByName[road->getName()] = road;
+
+        // De lichten voor de zones, een licht kan niet op het begin van een zone gezet worden
+        for (uint32_t light = BinaryIO::decodeUInt32(record + 28); light > 0 and valid; --light) {
+            valid = road->addTrafficLight(BinaryIO::decodeDouble(trafficLight),
+                                          (int) BinaryIO::decodeDouble(trafficLight + 8),
+                                          BinaryIO::decodeDouble(trafficLight + 16),
+                                          BinaryIO::decodeDouble(trafficLight + 24),
+                                          BinaryIO::decodeDouble(trafficLight + 32));
+            trafficLight += TRAFFIC_LIGHT_SIZE;
+        }
+        for (uint32_t stop = BinaryIO::decodeUInt32(record + 24); stop > 0 and valid; --stop) {
+            valid = road->addBusStop((int) BinaryIO::decodeDouble(busStop));
+            busStop += BUS_STOP_SIZE;
+        }
+        for (uint32_t zones = BinaryIO::decodeUInt32(record + 20); zones > 0 and valid; --zones) {
+            valid = road->addZone(BinaryIO::decodeDouble(zone), BinaryIO::decodeInt32(zone + 8));
+            zone += ZONE_SIZE;
+        }
+    }
+    for (uint32_t i = 0; i < layout.nrOfRoads and valid; ++i) {
+        const char *record = getRoadRecord(i);
+        if (BinaryIO::decodeUInt32(record + 12) == 0) {
+            continue;
+        }
+        // Zoals bij de import wordt een verbinding naar een weg buiten het netwerk een weg met enkel een naam, een
+        // per naam
+        Road *&intersection = roadsByName[decodeString(record + 8)];
+        if (intersection == NULL) {
+            intersection = roadNetwork->createRoad();
+            connections.push_back(intersection);
+            intersection->setName(decodeString(record + 8));
+        }
+        valid = roads[i]->setIntersection(intersection);
+    }
+    if (!valid) {
+        rollBack(roadNetwork);
+    }
+    return valid;
+}
+
+Vehicle *NetworkSections::Reader::createVehicle(RoadNetwork *roadNetwork, uint32_t index) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(index < getNrOfVehicles(), "Het voertuig moet in het bestand staan");
+
+    const char *record = getVehicleRecord(index);
+    Vehicle *vehicle = roadNetwork->createVehicle(decodeString(record));
+    if (vehicle != NULL) {
+        vehicles.push_back(vehicle);
+        if (!vehicle->setLicensePlate(decodeString(record + 8))) {
+            return NULL;
+        }
+    }
+    return vehicle;
+}
+
+Road *NetworkSections::Reader::getVehicleRoad(uint32_t index) const {
+    int32_t road = BinaryIO::decodeInt32(getVehicleRecord(index) + 16);
+    return road >= 0 ? roads[road] : roads[-1 - road]->getIntersection();
+}
+
+void NetworkSections::Reader::rollBack(RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    for (unsigned int i = 0; i < vehicles.size(); ++i) {
+        roadNetwork->destroyVehicle(vehicles[i]);
+    }
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        roadNetwork->destroyRoad(roads[i]);
+    }
+    for (unsigned int i = 0; i < connections.size(); ++i) {
+        roadNetwork->destroyRoad(connections[i]);
+    }
+    vehicles.clear();
+    roads.clear();
+    connections.clear();
+}
+
+void NetworkSections::Reader::addToNetwork(RoadNetwork *roadNetwork) {
+    REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+    REQUIRE(vehicles.size() == getNrOfVehicles(), "Elk voertuig moet gemaakt zijn");
+
+    // De rijen van voor naar achter: elk voertuig sluit vooraan de rij aan, zonder te zoeken
+    const char *queue = data + layout.queues;
+    for (uint32_t i = 0; i < layout.nrOfRoads; ++i) {
+        for (uint32_t count = BinaryIO::decodeUInt32(getRoadRecord(i) + 32); count > 0; --count) {
+            roads[i]->enterVehicle(vehicles[BinaryIO::decodeUInt32(queue)]);
+            queue += 4;
+        }
+    }
+    // In de volgorde van het bestand, zodat de wegen in dezelfde volgorde staan. De namen zijn uniek en elke weg is
+    // volledig ingesteld, dus dit kan niet meer mislukken
+    for (uint32_t i = 0; i < layout.nrOfRoads; ++i) {
+        bool added = roadNetwork->addRoad(roads[i]);
+        ENSURE(added, "De weg moet toegevoegd zijn");
+    }
+    roadNetwork->reserveCars(layout.nrOfVehicles);
+    for (uint32_t i = 0; i < layout.nrOfVehicles; ++i) {
+        roadNetwork->restoreCar(vehicles[i]);
+    }
+    roads.clear();
+    connections.clear();
+    vehicles.clear();
+}
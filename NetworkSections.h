@@ -0,0 +1,239 @@
+/**
+ * @file NetworkSections.h
+ * @brief This header file will contain the NetworkSections classes.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_NETWORKSECTIONS_H
+#define ANTROPSE_NETWORKSECTIONS_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+#include "BinaryIO.h"
+
+class RoadNetwork;
+class Road;
+class Vehicle;
+
+/**
+ * The sections a NetworkCheckpoint and a NetworkScenario have in common: the roads with their connection, zones, bus
+ * stops and traffic lights, the queues and the strings. Both formats only differ in their header and in what a vehicle
+ * record contains after its type, license plate and road.
+ *
+ * A file is a header of headerSize bytes, then the roads, zones, bus stops, traffic lights, vehicles, the queues (the
+ * indices of the vehicles of every road, from the front to the back) and the strings. The header contains the number
+ * of roads, zones, bus stops, traffic lights, vehicles and queued vehicles (32 bits each) at countsOffset, and the size
+ * of the string section (64 bits) at the first multiple of 8 after them.
+ *
+ * A road record contains its name (offset and length in the string section) at 0, the name of its connection at 8
+ * (length 0 without a connection), the speed limit at 16, the number of zones, bus stops, traffic lights and queued
+ * vehicles at 20, 24, 28 and 32, and the length at 40. A vehicle record starts with its type at 0, its license plate at
+ * 8 and the index of its road at 16. A vehicle on a connection to a road outside the network has -1 - the index of the
+ * first road that leads to it.
+ */
+namespace NetworkSections {
+    const std::size_t ROAD_SIZE = 48;
+    const std::size_t ZONE_SIZE = 16;
+    const std::size_t BUS_STOP_SIZE = 8;
+    const std::size_t TRAFFIC_LIGHT_SIZE = 40;
+
+    /**
+     * The number of records in every section, and where the sections start
+     */
+    struct Layout {
+        uint32_t nrOfRoads;
+        uint32_t nrOfZones;
+        uint32_t nrOfBusStops;
+        uint32_t nrOfTrafficLights;
+        uint32_t nrOfVehicles;
+        uint32_t nrOfQueued;
+        uint64_t stringSize;
+
+        uint64_t roads;
+        uint64_t zones;
+        uint64_t busStops;
+        uint64_t trafficLights;
+        uint64_t vehicles;
+        uint64_t queues;
+        uint64_t strings;
+        uint64_t size;
+
+        void calculateOffsets(std::size_t headerSize, std::size_t vehicleSize);
+    };
+
+    /**
+     * Writes the roads, their features and queues and the strings of a network, the format fills in the rest of its
+     * header and the vehicle records
+     */
+    class Writer {
+    public:
+        /**
+         * Count the records of a network and lay out the sections
+         *
+         * @param roadNetwork The network to write
+         * @param headerSize The size of the header of the format
+         * @param countsOffset Where the counts are stored in the header
+         * @param vehicleSize The size of a vehicle record of the format
+         * @param allowConnections Whether a vehicle can be on a connection to a road outside the network
+         *
+         * @pre
+         * REQUIRE(roadNetwork.properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+         */
+        Writer(const RoadNetwork &roadNetwork, std::size_t headerSize, std::size_t countsOffset,
+               std::size_t vehicleSize, bool allowConnections);
+
+        /**
+         * Write the road records, the zones, bus stops, traffic lights and queues
+         *
+         * @return false when a road has a vehicle in its queue that isn't in the network
+         */
+        bool encodeRoads();
+
+        /**
+         * Write the type, license plate and road of a vehicle in its record
+         *
+         * @return false when the vehicle isn't on a road of the network (or a connection, if those are allowed)
+         */
+        bool encodeVehicle(unsigned int index);
+
+        char *getHeader();
+
+        char *getVehicleRecord(unsigned int index);
+
+        /**
+         * Write the counts in the header, and the sections and the strings to the stream
+         *
+         * @return true when everything has been written
+         */
+        bool write(std::ostream &outStream);
+
+    private:
+        const std::vector<Road *> &roads;
+        const std::vector<Vehicle *> &cars;
+        std::size_t countsOffset;
+        std::size_t vehicleSize;
+        Layout layout;
+        std::vector<char> buffer;
+        BinaryIO::StringSection strings;
+        std::tr1::unordered_map<const Road *, int32_t> roadIndices;
+        std::tr1::unordered_map<const Vehicle *, uint32_t> vehicleIndices;
+
+        Writer(const Writer &);
+
+        Writer &operator=(const Writer &);
+    };
+
+    /**
+     * Reads the roads, their features and queues from a file in memory, and builds them in a network
+     *
+     * Everything that can be checked without building the network is checked by read. Then the roads and the vehicles
+     * are made outside the network, which checks the values (e.g. a negative speed limit). Only when everything has
+     * been made, addToNetwork adds it all to the network, which can't fail anymore. A format calls rollBack when it
+     * finds out a vehicle can't be made, so a damaged file never leaves a part of itself in the network.
+     */
+    class Reader {
+    public:
+        /**
+         * @param headerSize The size of the header of the format
+         * @param countsOffset Where the counts are stored in the header
+         * @param vehicleSize The size of a vehicle record of the format
+         * @param allowConnections Whether a vehicle can be on a connection to a road outside the network
+         */
+        Reader(std::size_t headerSize, std::size_t countsOffset, std::size_t vehicleSize, bool allowConnections);
+
+        /**
+         * Check the sections of a file: their sizes, the strings and counts of the roads, the type, license plate and
+         * road of every vehicle, the queues, and whether the names of the roads and the license plates are unique
+         *
+         * @param data The file, it has to stay in memory while the Reader is used
+         * @param size The number of bytes in the file, at least headerSize
+         *
+         * @return false when the file is damaged
+         */
+        bool read(const char *data, std::size_t size);
+
+        uint32_t getNrOfVehicles() const;
+
+        uint32_t getNrOfQueued() const;
+
+        const char *getVehicleRecord(uint32_t index) const;
+
+        /**
+         * @return The string of which the offset and the length are stored at record
+         */
+        std::string decodeString(const char *record) const;
+
+        /**
+         * Make the roads with their zones, bus stops, traffic lights and connections, outside the network
+         *
+         * Like the import, a connection to a road outside the network becomes a road with only a name.
+         *
+         * @return false when a road has an invalid value, nothing is left behind then
+         *
+         * @pre
+         * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+         */
+        bool createRoads(RoadNetwork *roadNetwork);
+
+        /**
+         * Make the vehicle of a record with its type and license plate, it's removed again by rollBack
+         *
+         * @return The vehicle, or NULL when its type is unknown or its license plate is empty
+         *
+         * @pre
+         * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+         * REQUIRE(index < getNrOfVehicles(), "Het voertuig moet in het bestand staan");
+         */
+        Vehicle *createVehicle(RoadNetwork *roadNetwork, uint32_t index);
+
+        /**
+         * @return The road the vehicle of a record is on, made by createRoads
+         */
+        Road *getVehicleRoad(uint32_t index) const;
+
+        /**
+         * Destroy everything that has been made, the network stays as it was
+         *
+         * @pre
+         * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+         */
+        void rollBack(RoadNetwork *roadNetwork);
+
+        /**
+         * Fill the queues and add the roads and the vehicles to the network, in the order of the file
+         *
+         * @pre
+         * REQUIRE(roadNetwork->properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+         * REQUIRE(roadNetwork->nrOfRoads() == 0 and roadNetwork->nrOfCars() == 0, "Het netwerk moet leeg zijn");
+         * REQUIRE(vehicles.size() == getNrOfVehicles(), "Elk voertuig moet gemaakt zijn");
+         */
+        void addToNetwork(RoadNetwork *roadNetwork);
+
+    private:
+        const char *data;
+        const char *strings;
+        std::size_t headerSize;
+        std::size_t countsOffset;
+        std::size_t vehicleSize;
+        bool allowConnections;
+        Layout layout;
+        std::vector<Road *> roads;
+        std::vector<Road *> connections;
+        std::vector<Vehicle *> vehicles;
+
+        const char *getRoadRecord(uint32_t index) const;
+
+        Reader(const Reader &);
+
+        Reader &operator=(const Reader &);
+    };
+}
+
+#endif //ANTROPSE_NETWORKSECTIONS_H
@@ -0,0 +1,187 @@
+/**
+ * @file ObjectPool.h
+ * @brief This header file will contain the ObjectPool class template.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_OBJECTPOOL_H
+#define ANTROPSE_OBJECTPOOL_H
+
+#include <map>
+#include <new>
+#include <vector>
+#include "DesignByContract.h"
+
+/**
+ * Counters of the allocations done by one or more pools
+ */
+struct PoolStatistics {
+    unsigned long created; /**< The number of objects created in the pool */
+    unsigned long recycled; /**< The number of objects created in a slot of a destroyed object */
+    unsigned long chunkAllocations; /**< The number of times memory was allocated for new slots */
+    unsigned long live; /**< The number of objects currently in the pool */
+    unsigned long capacity; /**< The number of slots, used or free */
+
+    PoolStatistics() : created(0), recycled(0), chunkAllocations(0), live(0), capacity(0) {}
+
+    PoolStatistics &operator+=(const PoolStatistics &other) {
+        created += other.created;
+        recycled += other.recycled;
+        chunkAllocations += other.chunkAllocations;
+        live += other.live;
+        capacity += other.capacity;
+        return *this;
+    }
+};
+
+/**
+ * Allocates objects of one type in chunks of slots
+ *
+ * The slots of destroyed objects are reused by the next objects that are created, so once a simulation has reached a
+ * steady state no memory is allocated anymore. Objects of the same type are close to each other in memory. All objects
+ * that are still alive are destroyed together with the pool.
+ */
+template<class T>
+class ObjectPool {
+public:
+    /**
+     * @param chunkSize The number of slots allocated at once
+     *
+     * @pre
+     * REQUIRE(chunkSize > 0, "Een chunk moet minstens 1 slot hebben");
+     */
+    explicit ObjectPool(unsigned int chunkSize = 64) : chunkSize(chunkSize) {
+        REQUIRE(chunkSize > 0, "Een chunk moet minstens 1 slot hebben");
+    }
+
+    /**
+     * Destroy all objects that are still in the pool and release the memory of all chunks
+     */
+    ~ObjectPool() {
+        for (unsigned int slot = 0; slot < live.size(); ++slot) {
+            if (live[slot]) {
+                slotAddress(slot)->~T();
+            }
+        }
+        for (unsigned int chunk = 0; chunk < chunks.size(); ++chunk) {
+            ::operator delete(chunks[chunk]);
+        }
+    }
+
+    /**
+     * Create a new object with the default constructor of T
+     *
+     * @post
+     * ENSURE(owns(result), "Het object moet in de pool zitten");
+     *
+     * @return The new object
+     */
+    T *create() {
+        if (freeSlots.empty()) {
+            allocateChunk();
+        } else if (used[freeSlots.back()]) {
+            statistics.recycled++;
+        }
+
+        unsigned int slot = freeSlots.back();
+        freeSlots.pop_back();
+        T *result = new(slotAddress(slot)) T();
+        live[slot] = true;
+        used[slot] = true;
+        statistics.created++;
+        statistics.live++;
+
+        ENSURE(owns(result), "Het object moet in de pool zitten");
+        return result;
+    }
+
+    /**
+     * Destroy an object of the pool, its slot is used again by the next object that is created
+     *
+     * @param object The object to destroy
+     *
+     * @pre
+     * REQUIRE(owns(object), "Het object moet in de pool zitten");
+     *
+     * @post
+     * ENSURE(!owns(object), "Het object zit niet meer in de pool");
+     */
+    void destroy(T *object) {
+        REQUIRE(owns(object), "Het object moet in de pool zitten");
+        int slot = findSlot(object);
+        object->~T();
+        live[slot] = false;
+        freeSlots.push_back(slot);
+        statistics.live--;
+        ENSURE(!owns(object), "Het object zit niet meer in de pool");
+    }
+
+    /**
+     * @return true when the object is alive and has been created by this pool
+     */
+    bool owns(const T *object) const {
+        int slot = findSlot(object);
+        return slot != -1 and live[slot];
+    }
+
+    /**
+     * @return The allocation counters of this pool
+     */
+    const PoolStatistics &getStatistics() const {
+        return statistics;
+    }
+
+private:
+    void allocateChunk() {
+        char *chunk = static_cast<char *>(::operator new(chunkSize * sizeof(T)));
+        chunkIndices[chunk] = chunks.size();
+        chunks.push_back(chunk);
+        unsigned int firstSlot = live.size();
+        live.resize(firstSlot + chunkSize, false);
+        used.resize(firstSlot + chunkSize, false);
+
+        // Van achter naar voor, zodat de objecten in volgorde van hun adres uitgedeeld worden
+        for (unsigned int slot = firstSlot + chunkSize; slot > firstSlot; --slot) {
+            freeSlots.push_back(slot - 1);
+        }
+        statistics.chunkAllocations++;
+        statistics.capacity += chunkSize;
+    }
+
+    T *slotAddress(unsigned int slot) const {
+        return reinterpret_cast<T *>(chunks[slot / chunkSize] + (slot % chunkSize) * sizeof(T));
+    }
+
+    int findSlot(const T *object) const {
+        // De laatste chunk die voor het adres begint, in plaats van alle chunks te overlopen
+        const char *address = reinterpret_cast<const char *>(object);
+        std::map<const char *, unsigned int>::const_iterator chunk = chunkIndices.upper_bound(address);
+        if (chunk == chunkIndices.begin()) {
+            return -1;
+        }
+        --chunk;
+        if (address < chunk->first + chunkSize * sizeof(T) and (address - chunk->first) % sizeof(T) == 0) {
+            return chunk->second * chunkSize + (address - chunk->first) / sizeof(T);
+        }
+        return -1;
+    }
+
+    unsigned int chunkSize;
+    std::vector<char *> chunks;
+    std::map<const char *, unsigned int> chunkIndices; /**< The index of every chunk, on its address */
+    std::vector<unsigned int> freeSlots;
+    std::vector<bool> live; /**< Whether a slot contains an object */
+    std::vector<bool> used; /**< Whether a slot has ever contained an object */
+    PoolStatistics statistics;
+
+    // De pool is eigenaar van zijn objecten en kan dus niet gekopieerd worden
+    ObjectPool(const ObjectPool &);
+
+    ObjectPool &operator=(const ObjectPool &);
+};
+
+
+#endif //ANTROPSE_OBJECTPOOL_H
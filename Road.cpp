@@ -7,11 +7,15 @@
  * @date 01/03/2019
  */
 
+#include <algorithm>
 #include <limits>
 #include <stdlib.h>
 #include "Road.h"
+#include "Vehicle.h"
 #include "DesignByContract.h"
 
+unsigned long Road::nrOfRevisions = 0;
+
 const std::string &Road::getName() const {
     REQUIRE(properlyInit(), "De weg moet deftig geinitialiseerd zijn");
     return name;
@@ -19,17 +23,37 @@ const std::string &Road::getName() const {
 
 int Road::getSpeedLimit(double position) const {
     REQUIRE(properlyInit(), "De weg moet deftig geinitialiseerd zijn");
-    int speed = speedLimit;
-    for (std::map<double, int>::const_iterator zone = zones.begin(); zone != zones.end(); ++zone) {
-        if ((*zone).first > position) {
-            break;
-//            return speed;
+    prepare();
+    // Het aantal zones dat voor of op de positie begint, is de index van de snelheidslimiet
+    return zoneSpeedLimits[std::upper_bound(zoneStarts.begin(), zoneStarts.end(), position) - zoneStarts.begin()];
+}
+
+int Road::getSpeedLimit() const {
+    REQUIRE(properlyInit(), "De weg moet deftig geinitialiseerd zijn");
+    return speedLimit;
+}
+
+int Road::getSpeedLimit(double position, int &zone) const {
+    REQUIRE(properlyInit(), "De weg moet deftig geinitialiseerd zijn");
+    prepare();
+    int nrOfZones = zoneStarts.size();
+    if (zone < 0 or zone > nrOfZones or (zone > 0 and zoneStarts[zone - 1] > position)) {
+        zone = std::upper_bound(zoneStarts.begin(), zoneStarts.end(), position) - zoneStarts.begin();
+    } else {
+        while (zone < nrOfZones and zoneStarts[zone] <= position) {
+            ++zone;
         }
-        speed = (*zone).second;
     }
-    return speed;
-//    std::cerr << "Eine Seefahrt was yeeting speedlimit is 0" << std::endl;
-//    return 0;
+    return zoneSpeedLimits[zone];
+}
+
+double Road::getNextZoneStart(double position, int &zone) const {
+    REQUIRE(properlyInit(), "De weg moet deftig geinitialiseerd zijn");
+    getSpeedLimit(position, zone);
+    if (zone == (int) zoneStarts.size()) {
+        return -1;
+    }
+    return zoneStarts[zone];
 }
 
 double Road::getLength() const {
@@ -43,6 +67,7 @@ bool Road::setName(const std::string &newName) {
     }
     REQUIRE(newName.size() > 0, "De naam mag niet leeg zijn");
     Road::name = newName;
+    revision = ++nrOfRevisions;
     ENSURE(getName() == newName, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
@@ -53,6 +78,7 @@ bool Road::setSpeedLimit(int newSpeedLimit) {
     }
     REQUIRE(newSpeedLimit > 0, "De speedlimit moet strikt groter zijn dan 0"); // Strikt groter
     Road::speedLimit = newSpeedLimit;
+    timelineModified();
     ENSURE(getSpeedLimit(0) == newSpeedLimit, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
@@ -63,15 +89,17 @@ bool Road::setLength(double newLength) {
     }
     REQUIRE(newLength > 0, "De lengte moet strikt groter zijn dan 0");
     Road::length = newLength;
+    revision = ++nrOfRevisions;
     ENSURE(getLength() == newLength, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
 
-Road::Road() : name(""), speedLimit(), length(0), intersection() {
+Road::Road() : name(""), speedLimit(), length(0), intersection(), firstVehicle(NULL), lastVehicle(NULL) {
     _initCheck = this;
 //    length = std::numeric_limits<double>::infinity();
     speedLimit = std::numeric_limits<int>::max();
     intersection = NULL;
+    timelineModified();
     ENSURE(properlyInit(), "The road is properly initialized");
 }
 
@@ -85,6 +113,7 @@ bool Road::setIntersection(Road *newIntersection) {
     }
     REQUIRE(newIntersection->properlyInit(), "De intersectie moet deftig geinitialiseerd zijn");
     Road::intersection = newIntersection;
+    revision = ++nrOfRevisions;
     ENSURE(getIntersection() == newIntersection, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
@@ -96,8 +125,11 @@ bool Road::properlyInit() const {
 Road::Road(const std::string &name, int speedLimit, double length, Road *intersection) : name(name),
                                                                                          speedLimit(speedLimit),
                                                                                          length(length),
-                                                                                         intersection(intersection) {
+                                                                                         intersection(intersection),
+                                                                                         firstVehicle(NULL),
+                                                                                         lastVehicle(NULL) {
     _initCheck = this;
+    timelineModified();
 }
 
 bool Road::addBusStop(int position) {
@@ -106,6 +138,7 @@ bool Road::addBusStop(int position) {
         position < getLength() &&
         busStops.find(position) == busStops.end()) {
         busStops.insert(position);
+        timelineModified();
         ENSURE(busStops.find(position) != busStops.end(), "De positie is toegevoegd aan de lijst met busstops");
         return true;
     }
@@ -117,6 +150,7 @@ bool Road::addZone(double position, int zoneSpeedLimit) {
         position < getLength() &&
         zones.find(position) == zones.end()) {
         zones[position] = zoneSpeedLimit;
+        timelineModified();
         return true;
     }
     return false;
@@ -131,38 +165,147 @@ bool Road::addTrafficLight(double position, int time) {
         position < getLength() &&
         zones.find(position) == zones.end()) {
         trafficLights[position] = new TrafficLight(position, time);
+        timelineModified();
         return true;
     }
     return false;
 }
 
-double Road::getNextBusStop(double busPosition) {
-    double position = -1;
-    for (std::set<double>::iterator stop = busStops.begin(); stop != busStops.end(); ++stop) {
-        if (*stop >= busPosition and (position == -1 or position > *stop)) {
-            position = *stop;
-        }
+bool Road::addTrafficLight(double position, int time, double greenDuration, double orangeDuration,
+                           double redDuration) {
+    if (position > 0 &&
+        position < getLength() &&
+        zones.find(position) == zones.end() &&
+        time >= 0 && greenDuration > 0 && orangeDuration >= 0 && redDuration > 0) {
+        trafficLights[position] = new TrafficLight(position, time, greenDuration, orangeDuration, redDuration);
+        timelineModified();
+        return true;
     }
-    return position;
+    return false;
+}
+
+double Road::getNextBusStop(double busPosition) {
+    int feature = -1;
+    return getNextBusStop(busPosition, feature);
 }
 
 
 double Road::getNextTrafficLight(double position) {
     REQUIRE(properlyInit(), "De weg moet deftig geinitialliseerd zijn");
-    double nextLight = -1;
-    for (std::map<double, TrafficLight *>::iterator light = trafficLights.begin();
-         light != trafficLights.end(); ++light) {
-        if ((*light).first > position and (nextLight == -1 or nextLight > (*light).first)) {
-            nextLight = (*light).first;
-        }
+    int feature = -1;
+    TrafficLight *nextLight = getNextTrafficLight(position, feature);
+    if (nextLight == NULL) {
+        return -1;
     }
-    return nextLight;
+    return nextLight->getPosition();
 }
 
 
 TrafficLight *Road::getTrafficLight(double position) {
     REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
-    return trafficLights[position];
+    std::map<double, TrafficLight *>::const_iterator light = trafficLights.find(position);
+    if (light == trafficLights.end()) {
+        return NULL;
+    }
+    return light->second;
+}
+
+TrafficLight *Road::getNextTrafficLight(double position, int &feature) const {
+    REQUIRE(properlyInit(), "The road must be correctly initialized");
+    findFeature(position, feature);
+    int nextLight = nextTrafficLights[feature];
+    // Een verkeerslicht op de positie zelf is al gepasseerd
+    if (nextLight != -1 and features[nextLight].position == position) {
+        nextLight = nextTrafficLights[nextLight + 1];
+    }
+    if (nextLight == -1) {
+        return NULL;
+    }
+    return features[nextLight].trafficLight;
+}
+
+double Road::getNextBusStop(double busPosition, int &feature) const {
+    REQUIRE(properlyInit(), "The road must be correctly initialized");
+    findFeature(busPosition, feature);
+    int nextStop = nextBusStops[feature];
+    if (nextStop == -1) {
+        return -1;
+    }
+    return features[nextStop].position;
+}
+
+const std::vector<RoadFeature> &Road::getFeatures() const {
+    REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
+    prepare();
+    return features;
+}
+
+void Road::prepare() const {
+    REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
+    if (timelineChanged) {
+        compileZones();
+        compileFeatures();
+        timelineChanged = false;
+    }
+}
+
+void Road::timelineModified() {
+    timelineChanged = true;
+    revision = ++nrOfRevisions;
+}
+
+unsigned long Road::getRevision() const {
+    REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
+    return revision;
+}
+
+void Road::findFeature(double position, int &feature) const {
+    prepare();
+    int nrOfFeatures = features.size();
+    if (feature < 0 or feature > nrOfFeatures or (feature > 0 and features[feature - 1].position >= position)) {
+        feature = 0;
+        int last = nrOfFeatures;
+        // Binair zoeken naar de eerste feature op of na de positie
+        while (feature < last) {
+            int middle = (feature + last) / 2;
+            if (features[middle].position < position) {
+                feature = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+    } else {
+        while (feature < nrOfFeatures and features[feature].position < position) {
+            ++feature;
+        }
+    }
+}
+
+void Road::compileFeatures() const {
+    features.clear();
+    std::map<double, TrafficLight *>::const_iterator light = trafficLights.begin();
+    std::set<double>::const_iterator stop = busStops.begin();
+    while (light != trafficLights.end() or stop != busStops.end()) {
+        RoadFeature feature;
+        if (stop == busStops.end() or (light != trafficLights.end() and light->first <= *stop)) {
+            feature.position = light->first;
+            feature.trafficLight = light->second;
+            ++light;
+        } else {
+            feature.position = *stop;
+            feature.trafficLight = NULL;
+            ++stop;
+        }
+        features.push_back(feature);
+    }
+
+    // Van achter naar voor, met een laatste plaats voor posities na alle features
+    nextTrafficLights.assign(features.size() + 1, -1);
+    nextBusStops.assign(features.size() + 1, -1);
+    for (int i = features.size() - 1; i >= 0; --i) {
+        nextTrafficLights[i] = features[i].trafficLight != NULL ? i : nextTrafficLights[i + 1];
+        nextBusStops[i] = features[i].trafficLight == NULL ? i : nextBusStops[i + 1];
+    }
 }
 
 const std::set<double> &Road::getBusStops() const {
@@ -180,9 +323,120 @@ const std::map<double, int> &Road::getZones() const {
     return zones;
 }
 
+void Road::compileZones() const {
+    zoneStarts.clear();
+    zoneSpeedLimits.assign(1, speedLimit);
+    for (std::map<double, int>::const_iterator zone = zones.begin(); zone != zones.end(); ++zone) {
+        zoneStarts.push_back(zone->first);
+        zoneSpeedLimits.push_back(zone->second);
+    }
+}
+
 bool Road::emptyConstructorParametersUpdated() {
     return (!name.empty() and length != 0 and
             speedLimit != std::numeric_limits<int>::max());
 }
 
+void Road::enterVehicle(Vehicle *vehicle) {
+    REQUIRE(properlyInit(), "The road must be correctly initialized");
+    REQUIRE(vehicle->getCurrentRoad() == this, "The vehicle must be driving on this road");
+    REQUIRE(!hasVehicle(vehicle), "The vehicle can't be in the queue already");
+
+    // Nieuwe voertuigen komen bijna altijd aan het begin van de weg op, dus zoeken we vanaf het begin
+    Vehicle *vehicleAhead = firstVehicle;
+    while (vehicleAhead != NULL and vehicleAhead->getCurrentPosition() < vehicle->getCurrentPosition()) {
+        vehicleAhead = vehicleAhead->vehicleAhead;
+    }
+    linkVehicleBefore(vehicle, vehicleAhead);
 
+    ENSURE(hasVehicle(vehicle), "The vehicle is in the queue of the road");
+}
+
+void Road::exitVehicle(Vehicle *vehicle) {
+    REQUIRE(properlyInit(), "The road must be correctly initialized");
+    REQUIRE(hasVehicle(vehicle), "The vehicle must be in the queue of the road");
+    unlinkVehicle(vehicle);
+    ENSURE(!hasVehicle(vehicle), "The vehicle isn't in the queue anymore");
+}
+
+void Road::updateVehiclePosition(Vehicle *vehicle) {
+    REQUIRE(properlyInit(), "The road must be correctly initialized");
+    REQUIRE(hasVehicle(vehicle), "The vehicle must be in the queue of the road");
+
+    double position = vehicle->getCurrentPosition();
+
+    // Voertuigen halen elkaar bijna nooit in, meestal blijft het voertuig dus op dezelfde plaats in de rij
+    if (vehicle->vehicleAhead != NULL and vehicle->vehicleAhead->getCurrentPosition() < position) {
+        Vehicle *vehicleAhead = vehicle->vehicleAhead;
+        unlinkVehicle(vehicle);
+        while (vehicleAhead != NULL and vehicleAhead->getCurrentPosition() < position) {
+            vehicleAhead = vehicleAhead->vehicleAhead;
+        }
+        linkVehicleBefore(vehicle, vehicleAhead);
+    } else if (vehicle->vehicleBehind != NULL and vehicle->vehicleBehind->getCurrentPosition() > position) {
+        Vehicle *vehicleBehind = vehicle->vehicleBehind;
+        unlinkVehicle(vehicle);
+        while (vehicleBehind != NULL and vehicleBehind->getCurrentPosition() > position) {
+            vehicleBehind = vehicleBehind->vehicleBehind;
+        }
+        linkVehicleBefore(vehicle, vehicleBehind == NULL ? firstVehicle : vehicleBehind->vehicleAhead);
+    }
+}
+
+bool Road::hasVehicle(const Vehicle *vehicle) const {
+    return vehicle->currentRoad == this and (vehicle->vehicleBehind != NULL or firstVehicle == vehicle);
+}
+
+Vehicle *Road::getFirstVehicle() const {
+    REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
+    return firstVehicle;
+}
+
+Vehicle *Road::getLastVehicle() const {
+    REQUIRE(properlyInit(), "de weg moet deftig geinitialiseerd zijn");
+    return lastVehicle;
+}
+
+void Road::linkVehicleBefore(Vehicle *vehicle, Vehicle *vehicleAhead) {
+    Vehicle *vehicleBehind = vehicleAhead == NULL ? lastVehicle : vehicleAhead->vehicleBehind;
+
+    vehicle->vehicleAhead = vehicleAhead;
+    vehicle->vehicleBehind = vehicleBehind;
+
+    if (vehicleBehind == NULL) {
+        firstVehicle = vehicle;
+    } else {
+        vehicleBehind->vehicleAhead = vehicle;
+    }
+
+    if (vehicleAhead == NULL) {
+        lastVehicle = vehicle;
+    } else {
+        vehicleAhead->vehicleBehind = vehicle;
+    }
+
+    // Een voertuig in een grote stap heeft geen voorganger, zodra het er een krijgt moet het weer reageren
+    if (vehicleBehind != NULL) {
+        vehicleBehind->endLargeStep();
+    }
+    if (vehicleAhead != NULL) {
+        vehicle->endLargeStep();
+    }
+}
+
+void Road::unlinkVehicle(Vehicle *vehicle) {
+    if (vehicle->vehicleBehind == NULL) {
+        firstVehicle = vehicle->vehicleAhead;
+    } else {
+        vehicle->vehicleBehind->vehicleAhead = vehicle->vehicleAhead;
+    }
+
+    if (vehicle->vehicleAhead == NULL) {
+        lastVehicle = vehicle->vehicleBehind;
+    } else {
+        vehicle->vehicleAhead->vehicleBehind = vehicle->vehicleBehind;
+    }
+
+    vehicle->vehicleAhead = NULL;
+    vehicle->vehicleBehind = NULL;
+}
@@ -13,8 +13,18 @@
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 #include "TrafficLight.h"
 
+class Vehicle;
+
+/**
+ * A traffic light or bus stop on the timeline of a road
+ */
+struct RoadFeature {
+    double position; /**< The position on the road in m */
+    TrafficLight *trafficLight; /**< The traffic light at this position, NULL for a bus stop */
+};
 
 /**
  * A class used to describe a Road in a RoadNetwork
@@ -43,6 +53,43 @@ public:
      */
     int getSpeedLimit(double position) const;
 
+    /**
+     * @return The speed limit of the road outside of its zones in km/h
+     *
+     * @pre
+     * REQUIRE(ProperlyInit(), "De weg moet deftig geinitialiseerd zijn");
+     */
+    int getSpeedLimit() const;
+
+    /**
+     * Get the speed limit of a road, starting the search from a zone that was found before
+     *
+     * Vehicles only drive forward, so a vehicle that keeps the zone of its previous position mostly finds its speed
+     * limit without searching. When the zone doesn't fit the position (e.g. after changing roads), it's searched again.
+     *
+     * @param position The position on the road
+     * @param zone The number of the zone found for an earlier position, updated to the zone of this position
+     *
+     * @return The maximum legal speed to drive on this road at this position in km/h
+     *
+     * @pre
+     * REQUIRE(ProperlyInit(), "De weg moet deftig geinitialiseerd zijn");
+     */
+    int getSpeedLimit(double position, int &zone) const;
+
+    /**
+     * Find the start of the next zone, starting the search from a zone that was found before
+     *
+     * @param position The position on the road
+     * @param zone The number of the zone found for an earlier position, updated to the zone of this position
+     *
+     * @return The position where the first zone after this position starts, -1 when there is none
+     *
+     * @pre
+     * REQUIRE(ProperlyInit(), "De weg moet deftig geinitialiseerd zijn");
+     */
+    double getNextZoneStart(double position, int &zone) const;
+
     /**
      * Get the length of the road
      *
@@ -206,6 +253,27 @@ public:
       */
     bool addTrafficLight(double position, int time);
 
+    /**
+      * Add a traffic light to the road with a chosen startOffset and its own cycle
+      *
+      * @param position The position on the road to add the light
+      * @param time The startOffset of the light
+      * @param greenDuration The time the light stays green in every cycle
+      * @param orangeDuration The time the light stays orange in every cycle
+      * @param redDuration The time the light stays red in every cycle
+      *
+      * @return true when succesfully added, false when there was an error adding the light
+      *
+      * @pre
+      * REQUIRE(properlyInit(), "The road must be correctly initialized");
+      * REQUIRE(validPositionOnRoad(position), "The position must be on the road");
+      * REQUIRE(greenDuration > 0 and orangeDuration >= 0 and redDuration > 0, "Ongeldige duur van een kleur");
+      *
+      * @post
+      * ENSURE(numberInSet(position, trafficLights), "The traffic light stop has been placed at the specified position")
+      */
+    bool addTrafficLight(double position, int time, double greenDuration, double orangeDuration, double redDuration);
+
 
     double getNextTrafficLight(double position);
 
@@ -226,6 +294,67 @@ public:
      */
     double getNextBusStop(double busPosition);
 
+    /**
+     * Find the next traffic light, starting the search from a feature that was found before
+     *
+     * The traffic lights and bus stops of a road are kept on one sorted timeline. A vehicle keeps the place on the
+     * timeline of its previous position, so the next traffic light or bus stop is mostly found without searching.
+     *
+     * @param position The position on the road
+     * @param feature The place on the timeline found for an earlier position, updated to the first feature at or after
+     * this position
+     *
+     * @return The first traffic light after the position, or NULL when there is none
+     *
+     * @pre
+     * REQUIRE(properlyInit(), "The road must be correctly initialized")
+     */
+    TrafficLight *getNextTrafficLight(double position, int &feature) const;
+
+    /**
+     * Find the next bus stop, starting the search from a feature that was found before
+     *
+     * @param busPosition The position of the bus on the road
+     * @param feature The place on the timeline found for an earlier position, updated to the first feature at or after
+     * this position
+     *
+     * @return the position of the next bus stop on the road or -1 when the last bus stop on the road has been passed
+     *
+     * @pre
+     * REQUIRE(properlyInit(), "The road must be correctly initialized")
+     */
+    double getNextBusStop(double busPosition, int &feature) const;
+
+    /**
+     * @return The traffic lights and bus stops of the road, sorted on position
+     *
+     * @pre
+     * REQUIRE(properlyInit(), de weg moet deftig geinitialiseerd zijn)
+     */
+    const std::vector<RoadFeature> &getFeatures() const;
+
+    /**
+     * Compile the zones, traffic lights and bus stops into the timeline of the road when they've changed
+     *
+     * The timeline is only compiled when it's queried after a change, adding many features costs one compilation.
+     * The queries compile it themselves, but vehicles on different threads query the same road, so the network calls
+     * this before it moves them.
+     *
+     * @pre
+     * REQUIRE(properlyInit(), de weg moet deftig geinitialiseerd zijn)
+     */
+    void prepare() const;
+
+    /**
+     * @return A number that changes every time the name, length, speed limits, intersection, bus stops or traffic lights
+     * of the road change. Two roads never have the same revision, so it can be used to check whether something derived
+     * from a road is still up to date.
+     *
+     * @pre
+     * REQUIRE(properlyInit(), de weg moet deftig geinitialiseerd zijn)
+     */
+    unsigned long getRevision() const;
+
     /**
      * @return a set containing the positions of all busstops on the road
      * @pre
@@ -254,6 +383,67 @@ public:
      */
     bool emptyConstructorParametersUpdated();
 
+    /**
+     * Add a vehicle to the queue of vehicles driving on this road
+     *
+     * The queue is ordered on the position of the vehicles, starting with the vehicle closest to the start of the road.
+     *
+     * @param vehicle The vehicle that enters the road
+     *
+     * @pre
+     * REQUIRE(properlyInit(), "The road must be correctly initialized");
+     * REQUIRE(vehicle->getCurrentRoad() == this, "The vehicle must be driving on this road");
+     * REQUIRE(!hasVehicle(vehicle), "The vehicle can't be in the queue already");
+     *
+     * @post
+     * ENSURE(hasVehicle(vehicle), "The vehicle is in the queue of the road");
+     */
+    void enterVehicle(Vehicle *vehicle);
+
+    /**
+     * Remove a vehicle from the queue of vehicles driving on this road
+     *
+     * @param vehicle The vehicle that leaves the road
+     *
+     * @pre
+     * REQUIRE(properlyInit(), "The road must be correctly initialized");
+     * REQUIRE(hasVehicle(vehicle), "The vehicle must be in the queue of the road");
+     *
+     * @post
+     * ENSURE(!hasVehicle(vehicle), "The vehicle isn't in the queue anymore");
+     */
+    void exitVehicle(Vehicle *vehicle);
+
+    /**
+     * Move a vehicle to its new place in the queue after its position has changed
+     *
+     * @param vehicle The vehicle that has moved
+     *
+     * @pre
+     * REQUIRE(properlyInit(), "The road must be correctly initialized");
+     * REQUIRE(hasVehicle(vehicle), "The vehicle must be in the queue of the road");
+     */
+    void updateVehiclePosition(Vehicle *vehicle);
+
+    /**
+     * @return true when the vehicle is in the queue of this road
+     */
+    bool hasVehicle(const Vehicle *vehicle) const;
+
+    /**
+     * @return the vehicle closest to the start of the road, NULL when there are no vehicles on the road
+     * @pre
+     * REQUIRE(properlyInit(), de weg moet deftig geinitialiseerd zijn)
+     */
+    Vehicle *getFirstVehicle() const;
+
+    /**
+     * @return the vehicle closest to the end of the road, NULL when there are no vehicles on the road
+     * @pre
+     * REQUIRE(properlyInit(), de weg moet deftig geinitialiseerd zijn)
+     */
+    Vehicle *getLastVehicle() const;
+
 private:
 
     Road *_initCheck;
@@ -265,6 +455,31 @@ private:
     std::set<double> busStops; // I'm using a set instead of a vector to keep it all sorted
     std::map<double, TrafficLight *> trafficLights;
     std::map<double, int> zones; // first number is the position, second number the speed_limit
+    mutable bool timelineChanged; /**< Whether the vectors below must be compiled again, see prepare */
+    mutable std::vector<double> zoneStarts; /**< The positions of zones, sorted */
+    mutable std::vector<int> zoneSpeedLimits; /**< The speed limit before the first zone, followed by every zone */
+    mutable std::vector<RoadFeature> features; /**< The traffic lights and bus stops, sorted on position */
+    mutable std::vector<int> nextTrafficLights; /**< For every feature, the first traffic light from there on (or -1) */
+    mutable std::vector<int> nextBusStops; /**< For every feature, the first bus stop from there on (or -1) */
+    Vehicle *firstVehicle; /**< The first vehicle in the queue of vehicles on this road, ordered by position */
+    Vehicle *lastVehicle; /**< The last vehicle in the queue, this is the vehicle furthest on the road */
+    unsigned long revision; /**< See getRevision */
+    static unsigned long nrOfRevisions; /**< The number of revisions given to all roads until now */
+
+    /**
+     * The timeline must be compiled again, the road gets a new revision
+     */
+    void timelineModified();
+
+    void compileZones() const;
+
+    void compileFeatures() const;
+
+    void findFeature(double position, int &feature) const;
+
+    void linkVehicleBefore(Vehicle *vehicle, Vehicle *vehicleAhead);
+
+    void unlinkVehicle(Vehicle *vehicle);
 };
 
 
@@ -0,0 +1,211 @@
+/**
+ * @file RoadGraph.cpp
+ * @brief This file will contain the definitions of the functions in RoadGraph.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include "RoadGraph.h"
+#include "Road.h"
+#include "DesignByContract.h"
+#include <climits>
+
+namespace {
+    // De afstand tussen de labels van opeenvolgende wegen na het spreiden, zo passen er nog 2^32 wegen tussen
+    const unsigned long LABEL_SPACING = 1UL << 32;
+    const unsigned long FIRST_LABEL = 1UL << 62;
+}
+
+RoadGraph::RoadGraph() : orderChanged(false), topologicalOrderChanged(false) {
+    _initCheck = this;
+}
+
+bool RoadGraph::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+void RoadGraph::addRoad(Road *road) {
+    REQUIRE(properlyInitialized(), "The graph must be properly initialized");
+    REQUIRE(road != NULL and findRoad(road->getName()) == NULL, "De weg mag nog niet in de graaf zitten");
+
+    // De weg komt net achter de eerste weg die naar hem leidt, of vooraan als er nog geen is
+    Road *firstPredecessor = getFirstPredecessor(road->getName());
+    std::list<Road *>::iterator position = order.begin();
+    if (firstPredecessor != NULL) {
+        position = nodes.find(firstPredecessor)->second.place;
+        ++position;
+    }
+
+    Node &node = nodes[road];
+    node.place = order.insert(position, road);
+    if (!findLabel(node.place, node.label)) {
+        spreadLabels();
+    }
+    roadsByName[road->getName()] = road;
+    if (road->getIntersection() != NULL) {
+        predecessors[road->getIntersection()->getName()].push_back(road);
+    }
+    orderChanged = true;
+    topologicalOrderChanged = true;
+
+    ENSURE(contains(road), "De weg moet in de graaf zitten");
+}
+
+bool RoadGraph::contains(const Road *road) const {
+    return nodes.find(road) != nodes.end();
+}
+
+Road *RoadGraph::findRoad(const std::string &name) const {
+    std::tr1::unordered_map<std::string, Road *>::const_iterator road = roadsByName.find(name);
+    if (road == roadsByName.end()) {
+        return NULL;
+    }
+    return road->second;
+}
+
+Road *RoadGraph::getSuccessor(const Road *road) const {
+    REQUIRE(contains(road), "De weg moet in de graaf zitten");
+    if (road->getIntersection() == NULL) {
+        return NULL;
+    }
+    return findRoad(road->getIntersection()->getName());
+}
+
+const std::vector<Road *> &RoadGraph::getPredecessors(const std::string &name) const {
+    static const std::vector<Road *> none;
+    std::tr1::unordered_map<std::string, std::vector<Road *> >::const_iterator roadsToName = predecessors.find(name);
+    if (roadsToName == predecessors.end()) {
+        return none;
+    }
+    return roadsToName->second;
+}
+
+Road *RoadGraph::getFirstPredecessor(const std::string &name) const {
+    const std::vector<Road *> &candidates = getPredecessors(name);
+    if (candidates.empty()) {
+        return NULL;
+    }
+
+    Road *firstRoad = candidates[0];
+    for (unsigned int i = 1; i < candidates.size(); ++i) {
+        if (comesBefore(candidates[i], firstRoad)) {
+            firstRoad = candidates[i];
+        }
+    }
+    return firstRoad;
+}
+
+bool RoadGraph::comesBefore(const Road *road, const Road *other) const {
+    REQUIRE(contains(road) and contains(other), "De wegen moeten in de graaf zitten");
+    return nodes.find(road)->second.label < nodes.find(other)->second.label;
+}
+
+void RoadGraph::prepare() {
+    REQUIRE(properlyInitialized(), "The graph must be properly initialized");
+    updateOrder();
+    ENSURE(getRoads().size() == (unsigned int) nrOfRoads(), "Alle wegen moeten in de vector zitten");
+}
+
+const std::vector<Road *> &RoadGraph::getRoads() const {
+    updateOrder();
+    return roads;
+}
+
+const std::vector<Road *> &RoadGraph::getTopologicalOrder() const {
+    if (!topologicalOrderChanged) {
+        return topologicalOrder;
+    }
+
+    // Kahn: begin met de wegen waar geen enkele weg naartoe leidt
+    const std::vector<Road *> &allRoads = getRoads();
+    std::tr1::unordered_map<const Road *, int> remainingPredecessors;
+    std::vector<Road *> ready;
+    for (unsigned int i = 0; i < allRoads.size(); ++i) {
+        int count = getPredecessors(allRoads[i]->getName()).size();
+        remainingPredecessors[allRoads[i]] = count;
+        if (count == 0) {
+            ready.push_back(allRoads[i]);
+        }
+    }
+
+    topologicalOrder.clear();
+    std::tr1::unordered_map<const Road *, bool> placed;
+    for (unsigned int i = 0; i < ready.size(); ++i) {
+        Road *road = ready[i];
+        topologicalOrder.push_back(road);
+        placed[road] = true;
+        Road *successor = getSuccessor(road);
+        if (successor != NULL and --remainingPredecessors[successor] == 0) {
+            ready.push_back(successor);
+        }
+    }
+
+    // Wegen op een cyclus (of die vanuit een cyclus bereikt worden) hebben geen topologische volgorde
+    for (unsigned int i = 0; i < allRoads.size(); ++i) {
+        if (placed.find(allRoads[i]) == placed.end()) {
+            topologicalOrder.push_back(allRoads[i]);
+        }
+    }
+
+    topologicalOrderChanged = false;
+    return topologicalOrder;
+}
+
+int RoadGraph::nrOfRoads() const {
+    return nodes.size();
+}
+
+void RoadGraph::updateOrder() const {
+    if (!orderChanged) {
+        return;
+    }
+    roads.assign(order.begin(), order.end());
+    orderChanged = false;
+}
+
+void RoadGraph::spreadLabels() {
+    unsigned long label = FIRST_LABEL;
+    for (std::list<Road *>::const_iterator road = order.begin(); road != order.end(); ++road) {
+        nodes.find(*road)->second.label = label;
+        label += LABEL_SPACING;
+    }
+}
+
+bool RoadGraph::findLabel(std::list<Road *>::iterator place, unsigned long &label) const {
+    std::list<Road *>::iterator next = place;
+    ++next;
+    bool first = place == order.begin();
+    bool last = next == order.end();
+    if (first and last) {
+        label = FIRST_LABEL;
+        return true;
+    }
+
+    // Vooraan en achteraan komt er een volle afstand bij, ertussen het midden tussen de buren
+    if (first) {
+        unsigned long nextLabel = nodes.find(*next)->second.label;
+        if (nextLabel < LABEL_SPACING) {
+            return false;
+        }
+        label = nextLabel - LABEL_SPACING;
+        return true;
+    }
+    std::list<Road *>::iterator previous = place;
+    --previous;
+    unsigned long previousLabel = nodes.find(*previous)->second.label;
+    if (last) {
+        if (previousLabel > ULONG_MAX - LABEL_SPACING) {
+            return false;
+        }
+        label = previousLabel + LABEL_SPACING;
+        return true;
+    }
+    unsigned long nextLabel = nodes.find(*next)->second.label;
+    if (nextLabel - previousLabel < 2) {
+        return false;
+    }
+    label = previousLabel + (nextLabel - previousLabel) / 2;
+    return true;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file RoadGraph.h
+ * @brief This header file will contain the RoadGraph class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_ROADGRAPH_H
+#define ANTROPSE_ROADGRAPH_H
+
+#include <list>
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+
+class Road;
+
+/**
+ * The roads of a network as a graph, with an edge from every road to its intersection
+ *
+ * The edges are followed on the name of the intersection, because the intersection of a road can be added to the
+ * network after the road itself. The graph keeps
+ *  - the successor of every road (the road in the graph with the name of its intersection)
+ *  - the predecessors of every name (the roads that have an intersection with that name)
+ *  - the order of the roads in the network: a new road is placed right after the first road that leads to it, or in
+ *    front when no road leads to it yet
+ *  - a label for every road that increases along the order, so two roads are compared without counting positions
+ *  - a topological order, in which every road comes before the road it leads to
+ *
+ * Adding a road takes constant time, unless more than one road leads to it. A new road gets the label halfway between
+ * the labels of its neighbours, only when there's no room left all labels are spread out again. The vector of the
+ * roads and the topological order are only built again when they're needed after a road has been added, e.g. in
+ * prepare().
+ */
+class RoadGraph {
+public:
+    RoadGraph();
+
+    /**
+     * Add a road to the graph
+     *
+     * @param road The road to add, with a name that isn't in the graph yet
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The graph must be properly initialized");
+     * REQUIRE(road != NULL and findRoad(road->getName()) == NULL, "De weg mag nog niet in de graaf zitten");
+     *
+     * @post
+     * ENSURE(contains(road), "De weg moet in de graaf zitten");
+     */
+    void addRoad(Road *road);
+
+    /**
+     * @return true when the road is in the graph
+     */
+    bool contains(const Road *road) const;
+
+    /**
+     * @return The road with the given name, or NULL when there is no such road in the graph
+     */
+    Road *findRoad(const std::string &name) const;
+
+    /**
+     * @return The road in the graph with the name of the intersection of road, or NULL when there is none
+     *
+     * @pre
+     * REQUIRE(contains(road), "De weg moet in de graaf zitten");
+     */
+    Road *getSuccessor(const Road *road) const;
+
+    /**
+     * @param name The name of a road, which doesn't need to be in the graph
+     *
+     * @return The roads in the graph with an intersection with this name, in the order in which they were added
+     */
+    const std::vector<Road *> &getPredecessors(const std::string &name) const;
+
+    /**
+     * @param name The name of a road, which doesn't need to be in the graph
+     *
+     * @return The road that comes first in the order of the network of all roads with an intersection with this name,
+     * or NULL when there is none
+     */
+    Road *getFirstPredecessor(const std::string &name) const;
+
+    /**
+     * @return true when road comes before other in the order of the network
+     *
+     * @pre
+     * REQUIRE(contains(road) and contains(other), "De wegen moeten in de graaf zitten");
+     */
+    bool comesBefore(const Road *road, const Road *other) const;
+
+    /**
+     * Build the vector of the roads after roads have been added, so getRoads() only reads afterwards
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The graph must be properly initialized");
+     *
+     * @post
+     * ENSURE(getRoads().size() == (unsigned int) nrOfRoads(), "Alle wegen moeten in de vector zitten");
+     */
+    void prepare();
+
+    /**
+     * @return All roads, in the order of the network
+     */
+    const std::vector<Road *> &getRoads() const;
+
+    /**
+     * Get the roads sorted so that every road comes before its successor
+     *
+     * Roads on a cycle have no such order, these come last, in the order of the network.
+     *
+     * @return All roads, in topological order
+     */
+    const std::vector<Road *> &getTopologicalOrder() const;
+
+    /**
+     * @return The number of roads in the graph
+     */
+    int nrOfRoads() const;
+
+    bool properlyInitialized() const;
+
+private:
+    /**
+     * The place of a road in order, with a label that increases along order
+     */
+    struct Node {
+        std::list<Road *>::iterator place;
+        unsigned long label;
+    };
+
+    void updateOrder() const;
+
+    /**
+     * Give every road a label with the same distance to the labels of its neighbours
+     */
+    void spreadLabels();
+
+    /**
+     * Find a label between the labels of the neighbours of a road in order
+     *
+     * @return false when there's no room between the neighbours, label is unchanged then
+     */
+    bool findLabel(std::list<Road *>::iterator place, unsigned long &label) const;
+
+    std::list<Road *> order; /**< The roads in the order of the network */
+    std::tr1::unordered_map<const Road *, Node> nodes; /**< The place and the label of every road */
+    std::tr1::unordered_map<std::string, Road *> roadsByName;
+    std::tr1::unordered_map<std::string, std::vector<Road *> > predecessors; /**< The reverse edges, on name */
+
+    mutable bool orderChanged;
+    mutable std::vector<Road *> roads; /**< order as a vector, only valid when !orderChanged */
+    mutable bool topologicalOrderChanged;
+    mutable std::vector<Road *> topologicalOrder;
+
+    RoadGraph *_initCheck;
+};
+
+
+#endif //ANTROPSE_ROADGRAPH_H
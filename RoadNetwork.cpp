@@ -12,10 +12,15 @@
 #include <fstream>
 #include "TinyXML/tinyxml.h"
 #include "RoadNetwork.h"
+#include "BulkCarLoader.h"
 #include "Road.h"
 #include "Car.h"
+#include "MotorBike.h"
+#include "Bus.h"
+#include "Truck.h"
 #include "DesignByContract.h"
 #include "sstream"
+#include <limits>
 
 #include "CONST.h"
 
@@ -27,24 +32,9 @@ bool RoadNetwork::addRoad(Road *road) {
     REQUIRE(findRoad(road->getName()) == NULL, "De weg mag nog niet in het netwerk zitten");
 
     // All roads must be sorted. The road on the first index is a road without any connections to.
-
-    std::string roadname = road->getName();
-
-    // Start by finding the index where to add the road
-    unsigned int insertPosition = 0;
-    for (unsigned int i = 0; i < roads.size(); ++i) {
-        // Controleer of deze weg roadname als intersection heeft
-        if (roads[i]->getIntersection() != NULL and
-            roads[i]->getIntersection()->getName() == roadname) {
-            insertPosition = i + 1;
-            break;
-        }
-    }
-
-//    std::cout << "Inserting at positon " << insertPosition << std::endl;
-
-    roads.insert(roads.begin() + insertPosition, road);
-//    roads.push_back(road);
+    // The graph places the road right after the first road that leads to it.
+    roadGraph.addRoad(road);
+    signalsChanged = true;
 
     ENSURE(findRoad(road->getName()) == road, "De weg moet nu wel in het netwerk zitten, omdat hij nu is toegevoegd");
     return true;
@@ -64,15 +54,33 @@ bool RoadNetwork::addCar(Vehicle *car) {
     REQUIRE(car->getCurrentRoad() != NULL, "De auto moet al op een weg geplaatst zijn");
     REQUIRE(findRoad(car->getCurrentRoad()->getName()) != NULL, "De weg moet al in het netwerk gestoken zijn");
 
-    // All cars must be sorted, starting with the first car, going to the last.
-//    std::cout << car->getLicensePlate() << std::endl;
-    int roadAddedCar = findRoadIndex(car->getCurrentRoad()->getName());
-//    std::cout << "Car on road " << roadAddedCar << " at position " << car->getCurrentPosition() << std::endl;
+    if (bulkLoader != NULL) {
+        // Dezelfde plaats en controles, zonder de lijst te overlopen
+        if (!bulkLoader->add(car)) {
+            return false;
+        }
+        carsByLicensePlate[car->getLicensePlate()] = car;
+        stateStore.attach(car);
+        ENSURE(findCar(car->getLicensePlate()) == car,
+               "De auto moet nu wel in het netwerk zitten, omdat hij nu is toegevoegd");
+        return true;
+    }
+
+    // All cars must be sorted, starting with the first car, going to the last. The cars of a road are mostly next to
+    // each other in the list, so the order of a road is only looked up when the road changes.
+    const Road *roadAddedCar = findRoad(car->getCurrentRoad()->getName());
+    const Road *roadCurrentCar = NULL;
+    bool roadAfterAddedCar = false;
 
     int insertPosition = 0;
     for (unsigned int i = 0; i < cars.size(); ++i) {
-        int roadCurrentCar = findRoadIndex(cars[i]->getCurrentRoad()->getName());
-        if (roadCurrentCar > roadAddedCar) {
+        if (cars[i]->getCurrentRoad() != roadCurrentCar) {
+            roadCurrentCar = cars[i]->getCurrentRoad();
+            // Een wagen op een verbinding naar een weg buiten het netwerk komt voor alle wegen
+            roadAfterAddedCar = roadCurrentCar != roadAddedCar and roadGraph.contains(roadCurrentCar) and
+                                roadGraph.comesBefore(roadAddedCar, roadCurrentCar);
+        }
+        if (roadAfterAddedCar) {
             insertPosition = i - 1;
             break;
         } else if (roadCurrentCar == roadAddedCar) {
@@ -90,23 +98,30 @@ bool RoadNetwork::addCar(Vehicle *car) {
         insertPosition = 0;
     }
 
-    cars.insert(cars.begin() + insertPosition, car);
-
-    if (!checkSpaceBetweenCars()) {
-//        cars.pop_back();
-        cars.erase(cars.begin() + insertPosition);
+    // Enkel de afstanden tot de buren in de rij van de weg veranderen
+    car->getCurrentRoad()->enterVehicle(car);
+    if (!checkSpaceAroundCar(car)) {
+        car->getCurrentRoad()->exitVehicle(car);
         return false;
     }
+    cars.insert(cars.begin() + insertPosition, car);
+    carsByLicensePlate[car->getLicensePlate()] = car;
+    stateStore.attach(car);
 
     ENSURE(findCar(car->getLicensePlate()) == car,
            "De auto moet nu wel in het netwerk zitten, omdat hij nu is toegevoegd");
-    ENSURE(check(), "Het netwerk moet nog werken achteraf");
+    ENSURE_FULL(check(), "Het netwerk moet nog werken achteraf");
     return true;
 }
 
 const std::vector<Road *> &RoadNetwork::getRoads() const {
     REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
-    return roads;
+    return roadGraph.getRoads();
+}
+
+const RoadGraph &RoadNetwork::getRoadGraph() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return roadGraph;
 }
 
 const std::vector<Vehicle *> &RoadNetwork::getCars() const {
@@ -114,54 +129,65 @@ const std::vector<Vehicle *> &RoadNetwork::getCars() const {
     return cars;
 }
 
-Road *RoadNetwork::findRoad(std::string nameRoad) {
-    REQUIRE(properlyInitialized(), "The road must be properly initialized");
-    for (std::vector<Road *>::iterator r = roads.begin(); r != roads.end(); r++) {
-        if ((*r)->getName() == nameRoad) {
-            return *r;
-        }
+void RoadNetwork::restoreCar(Vehicle *car) {
+    REQUIRE(car != NULL and car->properlyInitialized(), "De wagen moet correct geinitialiseerd zijn.");
+    REQUIRE(findCar(car->getLicensePlate()) == NULL, "De auto mag nog niet in het netwerk zitten");
+    REQUIRE(car->getCurrentRoad() != NULL and (roadGraph.contains(car->getCurrentRoad()) or
+            !roadGraph.getPredecessors(car->getCurrentRoad()->getName()).empty()),
+            "De auto moet op een weg van het netwerk of op een verbinding ervan staan");
+
+    cars.push_back(car);
+    if (!car->getCurrentRoad()->hasVehicle(car)) {
+        car->getCurrentRoad()->enterVehicle(car);
     }
+    carsByLicensePlate[car->getLicensePlate()] = car;
+    stateStore.attach(car);
 
-    // Indien niet gevonden
-    return NULL;
+    ENSURE(findCar(car->getLicensePlate()) == car, "De auto moet in het netwerk zitten");
+    ENSURE(getCars().back() == car, "De auto moet achteraan in de lijst staan");
+}
+
+void RoadNetwork::reserveCars(unsigned int nrOfCars) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    cars.reserve(nrOfCars);
+    carsByLicensePlate.rehash(nrOfCars);
+}
+
+Road *RoadNetwork::findRoad(const std::string &nameRoad) {
+    REQUIRE(properlyInitialized(), "The road must be properly initialized");
+    return roadGraph.findRoad(nameRoad);
 }
 
 Road *RoadNetwork::retrieveIntersectionRoad(std::string nameRoad) {
     REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
-    for (std::vector<Road *>::iterator road = roads.begin(); road != roads.end(); road++) {
-        if ((*road)->getIntersection() != NULL) {
-            if ((*road)->getIntersection()->getName() == nameRoad) {
-                return (*road)->getIntersection();
-            }
-        }
+
+    // Meerdere wegen kunnen naar dezelfde verbinding wijzen, de eerste weg in het netwerk bepaalt het resultaat
+    Road *firstRoad = roadGraph.getFirstPredecessor(nameRoad);
+    if (firstRoad == NULL) {
+        return NULL;
     }
-    return NULL;
+    return firstRoad->getIntersection();
 }
 
 
 Vehicle *RoadNetwork::findPreviouscar(const Vehicle *car) const {
     REQUIRE(car != NULL, "De wagen moet bestaan");
 
-    std::vector<Vehicle *> previousCars;
-    for (std::vector<Vehicle *>::const_iterator vehicle = cars.begin(); vehicle != cars.end(); vehicle++) {
-        if ((*vehicle)->getCurrentRoad() == car->getCurrentRoad() && (*vehicle)->getCurrentPosition() >
-                                                                     car->getCurrentPosition()) {
-            previousCars.push_back(*vehicle);
-        }
-    }
-    if (previousCars.size() > 0) {
-        Vehicle *previousCar = previousCars[0];
-        for (std::vector<Vehicle *>::iterator vehicle = previousCars.begin();
-             vehicle != previousCars.end(); vehicle++) {
-            if (previousCar->getCurrentPosition() > (*vehicle)->getCurrentPosition()) {
-                previousCar = (*vehicle);
-            }
-        }
-        return previousCar;
+    Vehicle *previousCar;
+    if (car->getCurrentRoad() != NULL and car->getCurrentRoad()->hasVehicle(car)) {
+        // Het voertuig staat in de rij van zijn weg, de voorganger is dus gewoon zijn buur
+        previousCar = car->getVehicleAhead();
+    } else if (car->getCurrentRoad() != NULL) {
+        previousCar = car->getCurrentRoad()->getFirstVehicle();
     } else {
         return NULL;
     }
 
+    // Voertuigen op exact dezelfde positie tellen niet als voorganger
+    while (previousCar != NULL and previousCar->getCurrentPosition() <= car->getCurrentPosition()) {
+        previousCar = previousCar->getVehicleAhead();
+    }
+    return previousCar;
 }
 
 int RoadNetwork::nrOfCars() {
@@ -170,36 +196,47 @@ int RoadNetwork::nrOfCars() {
 
 
 void RoadNetwork::automaticSimulation(std::ofstream &errStream) {
-    REQUIRE(check(), "Roadnetwork not valid");
+    REQUIRE_FULL(check(), "Roadnetwork not valid");
     while (nrOfCars() > 0) {
+        if (timeSkippingEnabled) {
+            skipSteadyIterations(std::numeric_limits<int>::max());
+        }
         moveAllCars(errStream);
     }
 
     ENSURE(nrOfCars() == 0, "alle auto's zijn buiten hun wegen gereden, er zijn geen auto's meer in het netwerk");
-    ENSURE(check(), "Valid roadnnetwork");
+    ENSURE_FULL(check(), "Valid roadnnetwork");
 }
 
 RoadNetwork::RoadNetwork() {
     _initCheck = this;
     iteration = 0;
+    stateStoreEnabled = false;
+    updateMode = sequentialUpdate;
+    workerPool = NULL;
+    signalsChanged = false;
+    timeSkippingEnabled = false;
+    subSteps = 1;
+    bulkLoader = NULL;
+}
+
+RoadNetwork::~RoadNetwork() {
+    delete workerPool;
+    delete bulkLoader;
 }
 
 
 bool RoadNetwork::carOnExistingRoad(Vehicle *car) {
     REQUIRE(car != NULL, "De auto moet bestaan");
     REQUIRE(findCar(car->getLicensePlate()) != NULL, "De auto moet in het netwerk zitten");
-    for (std::vector<Road *>::iterator road = roads.begin(); road != roads.end(); road++) {
-        if (car->getCurrentRoad() == (*road)) {
-            return true;
-        }
-    }
-    return false;
+    return roadGraph.contains(car->getCurrentRoad());
 }
 
 
 bool RoadNetwork::checkIfCarsOnExistingRoad() {
     for (std::vector<Vehicle *>::iterator car = cars.begin(); car != cars.end(); car++) {
-        if (carOnExistingRoad((*car)) == false) {
+        // Een wagen zonder weg heeft het netwerk verlaten en wordt op het einde van de iteratie verwijderd
+        if ((*car)->getCurrentRoad() != NULL and carOnExistingRoad((*car)) == false) {
             return false;
         }
     }
@@ -209,7 +246,8 @@ bool RoadNetwork::checkIfCarsOnExistingRoad() {
 bool RoadNetwork::checkPositionCars() {
     REQUIRE(properlyInitialized(), "Must be properly initialized");
     for (std::vector<Vehicle *>::iterator car = cars.begin(); car != cars.end(); car++) {
-        if ((*car)->getCurrentPosition() > (*car)->getCurrentRoad()->getLength()) {
+        if ((*car)->getCurrentRoad() != NULL and
+            (*car)->getCurrentPosition() > (*car)->getCurrentRoad()->getLength()) {
             return false;
         }
     }
@@ -217,19 +255,10 @@ bool RoadNetwork::checkPositionCars() {
 }
 
 bool RoadNetwork::checkSpaceBetweenCars() {
-//    for(unsigned int i = 0; i < cars.size()-1; i++) {
-//        if(abs(cars[i+1]->getCurrent_position() - cars[i+1]->getLength() - cars[i]->getCurrentPosition()) < 5){
-//            return false;
-//        }
-//    }
-    if (cars.size() == 0) { return true; }
-    for (unsigned int i = 0; i < cars.size(); i++) {
-        Vehicle *previouscar = findPreviouscar(cars[i]);
-        if (previouscar != NULL &&
-            previouscar->getCurrentPosition() - previouscar->getLength() - cars[i]->getCurrentPosition() <
-            CONST::MIN_FOLLOWING_DISTANCE) {
-//            std::cout << previouscar->getLicensePlate() << " " << previouscar->getCurrentPosition() << " " << cars[i]->getLicensePlate() << " " << cars[i]->getCurrentPosition() << std::endl;
-//            std::cout << previouscar->getCurrentPosition() - previouscar->getLength() - cars[i]->getCurrentPosition() << std::endl;
+    REQUIRE(properlyInitialized(), "Must be properly initialized");
+    const std::vector<Road *> &roads = roadGraph.getRoads();
+    for (std::vector<Road *>::const_iterator road = roads.begin(); road != roads.end(); road++) {
+        if (!checkSpaceOnRoad(*road)) {
             return false;
         }
     }
@@ -237,9 +266,11 @@ bool RoadNetwork::checkSpaceBetweenCars() {
 }
 
 bool RoadNetwork::checkIntersections() {
-    for (std::vector<Road *>::iterator road = roads.begin(); road != roads.end(); road++) {
+    REQUIRE(properlyInitialized(), "Must be properly initialized");
+    const std::vector<Road *> &roads = roadGraph.getRoads();
+    for (std::vector<Road *>::const_iterator road = roads.begin(); road != roads.end(); road++) {
         if ((*road)->getIntersection() != NULL &&
-            retrieveIntersectionRoad((*road)->getIntersection()->getName()) == NULL) {
+            roadGraph.getPredecessors((*road)->getIntersection()->getName()).empty()) {
             return false;
         }
 
@@ -248,19 +279,70 @@ bool RoadNetwork::checkIntersections() {
 }
 
 bool RoadNetwork::check() {
-    if (checkIfCarsOnExistingRoad() && checkPositionCars() && checkSpaceBetweenCars() && checkIntersections()) {
-        return true;
-    } else {
+    // Een enkele doorloop van alle wagens en alle wegen, in plaats van de vier checks na elkaar
+    for (std::vector<Vehicle *>::const_iterator car = cars.begin(); car != cars.end(); car++) {
+        if ((*car)->getCurrentRoad() == NULL) {
+            continue; // Heeft het netwerk in deze iteratie verlaten
+        }
+        if (!roadGraph.contains((*car)->getCurrentRoad()) or
+            (*car)->getCurrentPosition() > (*car)->getCurrentRoad()->getLength()) {
+            return false;
+        }
+    }
+
+    const std::vector<Road *> &roads = roadGraph.getRoads();
+    for (std::vector<Road *>::const_iterator road = roads.begin(); road != roads.end(); road++) {
+        if ((*road)->getIntersection() != NULL and
+            roadGraph.getPredecessors((*road)->getIntersection()->getName()).empty()) {
+            return false;
+        }
+        if (!checkSpaceOnRoad(*road)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RoadNetwork::checkSpaceOnRoad(const Road *road) const {
+    // De rij van de weg is gesorteerd, dus volstaat het om elk voertuig met zijn voorganger te vergelijken. We lopen
+    // van voor naar achter, zodat voertuigen op dezelfde positie dezelfde voorganger delen.
+    const Vehicle *previousCar = NULL;
+    for (const Vehicle *car = road->getLastVehicle(); car != NULL; car = car->getVehicleBehind()) {
+        const Vehicle *vehicleAhead = car->getVehicleAhead();
+        if (vehicleAhead != NULL and vehicleAhead->getCurrentPosition() > car->getCurrentPosition()) {
+            previousCar = vehicleAhead;
+        }
+        if (previousCar != NULL and
+            previousCar->getCurrentPosition() - previousCar->getLength() - car->getCurrentPosition() <
+            CONST::MIN_FOLLOWING_DISTANCE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RoadNetwork::checkSpaceAroundCar(const Vehicle *car) const {
+    // Dezelfde afstanden als checkSpaceOnRoad: de voorganger is het eerste voertuig verder op de weg, en het voertuig
+    // achter de wagen staat altijd echt achter hem
+    const Vehicle *previousCar = car->getVehicleAhead();
+    while (previousCar != NULL and previousCar->getCurrentPosition() <= car->getCurrentPosition()) {
+        previousCar = previousCar->getVehicleAhead();
+    }
+    if (previousCar != NULL and
+        previousCar->getCurrentPosition() - previousCar->getLength() - car->getCurrentPosition() <
+        CONST::MIN_FOLLOWING_DISTANCE) {
         return false;
     }
+    const Vehicle *nextCar = car->getVehicleBehind();
+    return nextCar == NULL or car->getCurrentPosition() - car->getLength() - nextCar->getCurrentPosition() >=
+                              CONST::MIN_FOLLOWING_DISTANCE;
 }
 
-Vehicle *RoadNetwork::findCar(std::string license_plate) const {
+Vehicle *RoadNetwork::findCar(const std::string &license_plate) const {
     REQUIRE(properlyInitialized(), "The roadnetwork must be properly initialized");
-    for (std::vector<Vehicle *>::const_iterator car = cars.begin(); car != cars.end(); car++) {
-        if ((*car)->getLicensePlate() == license_plate) {
-            return (*car);
-        }
+    std::tr1::unordered_map<std::string, Vehicle *>::const_iterator car = carsByLicensePlate.find(license_plate);
+    if (car != carsByLicensePlate.end()) {
+        return car->second;
     }
     return NULL;
 }
@@ -270,18 +352,247 @@ void RoadNetwork::removeVehicle(std::string licensePlate) {
     REQUIRE(cars.size() > 0, "De lijst met auto's mag niet leeg zijn");
     unsigned int cars_size = cars.size();
 
+    Vehicle *car = findCar(licensePlate);
+    carsByLicensePlate.erase(licensePlate);
+    if (car->getCurrentRoad() != NULL and car->getCurrentRoad()->hasVehicle(car)) {
+        car->getCurrentRoad()->exitVehicle(car);
+    }
     for (unsigned int i = 0; i < cars.size(); ++i) {
-        if (cars[i]->getLicensePlate() == licensePlate) {
-            delete cars[i];
+        if (cars[i] == car) {
             cars.erase(cars.begin() + i);
+            break;
         }
     }
+    destroyVehicle(car);
 
     ENSURE(findCar(licensePlate) == NULL, "De auto zit niet meer in het netwerk");
     ENSURE(cars_size - 1 == cars.size(), "Er is een element verwijderd uit de lijst");
 
 }
 
+void RoadNetwork::exitVehicle(Vehicle *car) {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    REQUIRE(car != NULL and findCar(car->getLicensePlate()) == car, "De auto moet in het netwerk zitten");
+    REQUIRE(car->getCurrentRoad() != NULL, "De auto moet op een weg rijden");
+
+    if (car->getCurrentRoad()->hasVehicle(car)) {
+        car->getCurrentRoad()->exitVehicle(car);
+    }
+
+    VehicleExit exit;
+    exit.licensePlate = car->getLicensePlate();
+    exit.type = car->getType();
+    exit.roadName = car->getCurrentRoad()->getName();
+    exit.iteration = iteration;
+    exits.push_back(exit);
+    exitQueue.push_back(car);
+
+    ENSURE(getExits().back().licensePlate == car->getLicensePlate(), "Het vertrek moet geregistreerd zijn");
+}
+
+const std::vector<VehicleExit> &RoadNetwork::getExits() const {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    return exits;
+}
+
+void RoadNetwork::removeExitedVehicles() {
+    if (exitQueue.empty()) {
+        return;
+    }
+
+    // De wagens die vertrokken zijn hebben geen weg meer, de rest schuift in een keer op
+    unsigned int remaining = 0;
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        if (cars[i]->getCurrentRoad() != NULL) {
+            cars[remaining++] = cars[i];
+        }
+    }
+    cars.resize(remaining);
+
+    for (unsigned int i = 0; i < exitQueue.size(); ++i) {
+        carsByLicensePlate.erase(exitQueue[i]->getLicensePlate());
+        destroyVehicle(exitQueue[i]);
+    }
+    exitQueue.clear();
+}
+
+Vehicle *RoadNetwork::createVehicle(const std::string &type) {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    if (type == "AUTO") {
+        return carPool.create();
+    } else if (type == "MOTORFIETS") {
+        return motorBikePool.create();
+    } else if (type == "BUS") {
+        return busPool.create();
+    } else if (type == "VRACHTWAGEN") {
+        return truckPool.create();
+    }
+    return NULL;
+}
+
+Road *RoadNetwork::createRoad() {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    return roadPool.create();
+}
+
+void RoadNetwork::destroyVehicle(Vehicle *vehicle) {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    REQUIRE(vehicle != NULL, "Het voertuig moet bestaan");
+
+    // Het type bepaalt in welke pool het voertuig kan zitten, voertuigen die met new gemaakt zijn worden gewoon verwijderd
+    std::string type = vehicle->getType();
+    if (type == "AUTO" and carPool.owns(static_cast<Car *>(vehicle))) {
+        carPool.destroy(static_cast<Car *>(vehicle));
+    } else if (type == "MOTORFIETS" and motorBikePool.owns(static_cast<MotorBike *>(vehicle))) {
+        motorBikePool.destroy(static_cast<MotorBike *>(vehicle));
+    } else if (type == "BUS" and busPool.owns(static_cast<Bus *>(vehicle))) {
+        busPool.destroy(static_cast<Bus *>(vehicle));
+    } else if (type == "VRACHTWAGEN" and truckPool.owns(static_cast<Truck *>(vehicle))) {
+        truckPool.destroy(static_cast<Truck *>(vehicle));
+    } else {
+        delete vehicle;
+    }
+}
+
+void RoadNetwork::destroyRoad(Road *road) {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    REQUIRE(road != NULL, "De weg moet bestaan");
+    REQUIRE(findRoad(road->getName()) != road, "De weg mag niet in het netwerk zitten");
+
+    if (roadPool.owns(road)) {
+        roadPool.destroy(road);
+    } else {
+        delete road;
+    }
+}
+
+TrafficLightColor RoadNetwork::getTrafficLightColor(TrafficLight *light) const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    if (signals.isUpToDate(iteration) and signals.contains(light)) {
+        return signals.getColor(light);
+    }
+    return light->getColor(iteration);
+}
+
+void RoadNetwork::setTimeSkipping(bool enabled) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    timeSkippingEnabled = enabled;
+    ENSURE(usesTimeSkipping() == enabled, "De gekozen manier moet gebruikt worden");
+}
+
+bool RoadNetwork::usesTimeSkipping() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return timeSkippingEnabled;
+}
+
+void RoadNetwork::setSubSteps(int newSubSteps) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(newSubSteps >= 1, "Er moet minstens een stap per iteratie zijn");
+    subSteps = newSubSteps;
+    ENSURE(getSubSteps() == newSubSteps, "Het aantal stappen moet aangepast zijn");
+}
+
+int RoadNetwork::getSubSteps() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return subSteps;
+}
+
+int RoadNetwork::skipSteadyIterations(int maxIterations) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(maxIterations >= 0, "Het aantal iteraties kan niet negatief zijn");
+
+    int iterations = maxIterations;
+    for (unsigned int i = 0; i < cars.size() and iterations > 0; ++i) {
+        iterations = cars[i]->getSteadyIterations(this, iterations);
+    }
+    if (cars.empty() or iterations == 0) {
+        return 0;
+    }
+
+    for (unsigned int i = 0; i < cars.size(); ++i) {
+        cars[i]->advanceSteadily(iterations);
+    }
+    iteration += iterations;
+    for (int i = 0; i < iterations; ++i) {
+        DesignByContract::nextTick();
+    }
+    exits.clear();
+    return iterations;
+}
+
+void RoadNetwork::moveInSubSteps(Vehicle *car, std::ostream &errStream) {
+    double time = CONST::SECONDS_PER_ITERATION / subSteps;
+    for (int step = 0; step < subSteps; ++step) {
+        // Een wagen die het netwerk verlaten heeft, wordt niet verder bewogen
+        if (car->getCurrentRoad() == NULL) {
+            break;
+        }
+        car->move(this, errStream, time);
+    }
+}
+
+bool RoadNetwork::moveAdaptively(Vehicle *car, std::ostream &errStream) {
+    // In vrije doorgang verder in de grote stap die gepland was, zonder iets na te kijken: de stap eindigt voor de
+    // wagen dicht bij een interactie komt, en een wagen die voor hem komt beeindigt ze (zie Vehicle::endLargeStep)
+    if (car->getLargeStepIterations() > 0) {
+        if (stateStoreEnabled) {
+            car->continueLargeStep(stateStore.getNewPosition(car));
+        } else {
+            car->continueLargeStep();
+        }
+        return true;
+    }
+    // Dicht bij een interactie in kleine stappen
+    if (car->isNearInteraction(this)) {
+        moveInSubSteps(car, errStream);
+        return true;
+    }
+    return false;
+}
+
+void RoadNetwork::planLargeStep(Vehicle *car) {
+    // De iteratie is al verhoogd, dus de grote stap begint net als bij skipSteadyIterations in de volgende iteratie
+    if (subSteps > 1 and car->getCurrentRoad() != NULL) {
+        car->planLargeStep(this, std::numeric_limits<int>::max());
+    }
+}
+
+void RoadNetwork::updateSignalStates() {
+    // Nieuwe wegen of een weg met een nieuwe revisie, bv. door een nieuw licht: de tabel wordt opnieuw gevuld. Een weg
+    // krijgt een nieuwe revisie als zijn tijdlijn verandert, die wordt dan ook meteen gecompileerd.
+    const std::vector<Road *> &roads = roadGraph.getRoads();
+    bool changed = signalsChanged;
+    for (unsigned int i = 0; !changed and i < roads.size(); ++i) {
+        changed = roads[i]->getRevision() != signalRevisions[i];
+    }
+    if (changed) {
+        signals.clear();
+        signalRevisions.clear();
+        for (unsigned int i = 0; i < roads.size(); ++i) {
+            roads[i]->prepare();
+            signalRevisions.push_back(roads[i]->getRevision());
+            const std::map<double, TrafficLight *> &trafficLights = roads[i]->getTrafficLights();
+            for (std::map<double, TrafficLight *>::const_iterator light = trafficLights.begin();
+                 light != trafficLights.end(); ++light) {
+                signals.addTrafficLight(light->second);
+            }
+        }
+        signalsChanged = false;
+    }
+    signals.update(iteration);
+}
+
+PoolStatistics RoadNetwork::getPoolStatistics() const {
+    REQUIRE(properlyInitialized(), "The network must be properly initialized");
+    PoolStatistics statistics;
+    statistics += carPool.getStatistics();
+    statistics += motorBikePool.getStatistics();
+    statistics += busPool.getStatistics();
+    statistics += truckPool.getStatistics();
+    statistics += roadPool.getStatistics();
+    return statistics;
+}
+
 bool RoadNetwork::properlyInitialized() const {
     return RoadNetwork::_initCheck == this;
 }
@@ -291,23 +602,186 @@ bool RoadNetwork::isEmpty() {
 }
 
 void RoadNetwork::moveAllCars(std::ostream &errStream) {
+    REQUIRE(!isBulkLoading(), "De wagens moeten eerst in het netwerk geladen zijn");
     iteration++;
+    DesignByContract::nextTick();
+    exits.clear();
+    // De volgorde van de wegen, hun tijdlijnen en de kleuren van de lichten worden hier berekend, zodat de threads ze
+    // enkel nog lezen
+    roadGraph.prepare();
+    updateSignalStates();
 //    int n = nrOfCars(); // Value to check wether a car has been removed
 //    generateOutputFile("simulation.txt");
-    for (int i = nrOfCars() - 1; i >= 0; --i) {
+    if (updateMode == synchronousUpdate) {
+        moveAllCarsSynchronous(errStream);
+        return;
+    }
+
+    if (stateStoreEnabled) {
+        // De toestand van de wagens zit al in de rijstroken van de store, er moet niets gekopieerd worden. Enkel de
+        // wagens die in kleine stappen bewegen, gebruiken de geintegreerde waarden niet.
+        stateStore.integrate(CONST::SECONDS_PER_ITERATION);
+        for (int i = nrOfCars() - 1; i >= 0; --i) {
+            if (subSteps == 1 or !moveAdaptively(cars[i], errStream)) {
+                cars[i]->move(this, errStream, stateStore.getNewPosition(cars[i]), stateStore.getNewSpeed(cars[i]));
+                planLargeStep(cars[i]);
+            }
+        }
+    } else {
+        for (int i = nrOfCars() - 1; i >= 0; --i) {
+            if (subSteps == 1 or !moveAdaptively(cars[i], errStream)) {
+                cars[i]->move(this, errStream);
+                planLargeStep(cars[i]);
+            }
+        }
+    }
+
+    removeExitedVehicles();
+}
+
+/**
+ * Phase 1 of a synchronous iteration: integrate the lanes of the state store, divided round robin over the workers
+ */
+class IntegrateTask : public WorkerPool::Task {
+public:
+    explicit IntegrateTask(VehicleStateStore &store) : store(store) {}
+
+    virtual void execute(int worker, int nrOfWorkers) {
+        for (int lane = worker; lane < store.nrOfLanes(); lane += nrOfWorkers) {
+            store.integrateLane(lane, CONST::SECONDS_PER_ITERATION);
+        }
+    }
+
+private:
+    VehicleStateStore &store;
+};
 
-        cars[i]->move(this, errStream);
+/**
+ * Phase 2 of a synchronous iteration: commit the cars that stay on their road, every worker only touches the queues and
+ * the lanes of its own roads. The cars that drive off their road are only counted, they are handed over afterwards.
+ */
+class CommitTask : public WorkerPool::Task {
+public:
+    CommitTask(RoadNetwork *roadNetwork, const VehicleStateStore &store, int nrOfWorkers)
+            : roadNetwork(roadNetwork), store(store), leavingRoad(nrOfWorkers, 0) {}
+
+    virtual void execute(int worker, int nrOfWorkers) {
+        for (int lane = worker; lane < store.nrOfLanes(); lane += nrOfWorkers) {
+            const std::vector<Vehicle *> &vehicles = store.getLaneVehicles(lane);
+            if (vehicles.empty() or store.getLaneRoad(lane) == NULL) {
+                continue;
+            }
+            double roadLength = store.getLaneRoad(lane)->getLength();
+            for (unsigned int i = 0; i < vehicles.size(); ++i) {
+                if (store.getNewPosition(vehicles[i]) > roadLength) {
+                    ++leavingRoad[worker];
+                } else {
+                    vehicles[i]->commitMove(roadNetwork, store.getNewPosition(vehicles[i]),
+                                            store.getNewSpeed(vehicles[i]));
+                }
+            }
+        }
+    }
+
+    /**
+     * @return The number of cars that drive off their road
+     */
+    int nrOfCarsLeavingRoad() const {
+        int result = 0;
+        for (unsigned int i = 0; i < leavingRoad.size(); ++i) {
+            result += leavingRoad[i];
+        }
+        return result;
+    }
+
+private:
+    RoadNetwork *roadNetwork;
+    const VehicleStateStore &store;
+    std::vector<int> leavingRoad;
+};
+
+/**
+ * Phase 3 of a synchronous iteration: every car reacts to the traffic ahead. The cars are divided in consecutive
+ * blocks, so the errors of the blocks can be joined in the order of the cars.
+ */
+class ReactTask : public WorkerPool::Task {
+public:
+    ReactTask(RoadNetwork *roadNetwork, const std::vector<Vehicle *> &cars, std::ostream &errStream, int nrOfWorkers)
+            : roadNetwork(roadNetwork), cars(cars), errStream(errStream), errors(nrOfWorkers) {}
+
+    virtual void execute(int worker, int nrOfWorkers) {
+        unsigned int first = cars.size() * worker / nrOfWorkers;
+        unsigned int last = cars.size() * (worker + 1) / nrOfWorkers;
+        if (nrOfWorkers == 1) {
+            for (unsigned int i = first; i < last; ++i) {
+                cars[i]->reactToTraffic(roadNetwork, errStream);
+            }
+            return;
+        }
 
-        // Enkel mogelijk indien de wagen verwijjderd is uit het netwerk
-//        if (n != nrOfCars()) {
-//            i++;
-//            n = nrOfCars();
-//        }
+        std::ostringstream blockErrors;
+        for (unsigned int i = first; i < last; ++i) {
+            cars[i]->reactToTraffic(roadNetwork, blockErrors);
+        }
+        errors[worker] = blockErrors.str();
+    }
+
+    void writeErrors() {
+        for (unsigned int i = 0; i < errors.size(); ++i) {
+            errStream << errors[i];
+        }
+    }
+
+private:
+    RoadNetwork *roadNetwork;
+    const std::vector<Vehicle *> &cars;
+    std::ostream &errStream;
+    std::vector<std::string> errors;
+};
+
+void RoadNetwork::moveAllCarsSynchronous(std::ostream &errStream) {
+    int nrOfWorkers = getThreadCount();
+
+    // Fase 1: de volgende toestand van elke wagen wordt berekend uit de toestand van de vorige iteratie
+    IntegrateTask integrateTask(stateStore);
+    runTask(integrateTask);
+
+    // Fase 2: commit per weg. Wagens die van hun weg rijden worden daarna overgedragen, van achter naar voor zoals in de
+    // sequentiele mode. Wagens die het netwerk verlaten worden meteen verwijderd, ze reageren niet meer op het verkeer.
+    CommitTask commitTask(this, stateStore, nrOfWorkers);
+    runTask(commitTask);
+    int nrOfCarsLeavingRoad = commitTask.nrOfCarsLeavingRoad();
+    if (nrOfCarsLeavingRoad > 0) {
+        // Eerst verzamelen, want een overgedragen wagen staat al op zijn nieuwe weg
+        std::vector<Vehicle *> leavingRoad;
+        for (int i = nrOfCars() - 1; i >= 0 and (int) leavingRoad.size() < nrOfCarsLeavingRoad; --i) {
+            if (stateStore.getNewPosition(cars[i]) > cars[i]->getCurrentRoad()->getLength()) {
+                leavingRoad.push_back(cars[i]);
+            }
+        }
+        for (unsigned int i = 0; i < leavingRoad.size(); ++i) {
+            leavingRoad[i]->commitMove(this, stateStore.getNewPosition(leavingRoad[i]),
+                                       stateStore.getNewSpeed(leavingRoad[i]));
+        }
+    }
+    removeExitedVehicles();
+
+    // Fase 3: elke wagen leest enkel de gecommitte posities van de andere wagens
+    ReactTask reactTask(this, cars, errStream, nrOfWorkers);
+    runTask(reactTask);
+    reactTask.writeErrors();
+}
+
+void RoadNetwork::runTask(WorkerPool::Task &task) {
+    if (workerPool == NULL) {
+        task.execute(0, 1);
+    } else {
+        workerPool->run(task);
     }
 }
 
 int RoadNetwork::nrOfRoads() {
-    return roads.size();
+    return roadGraph.nrOfRoads();
 }
 
 int RoadNetwork::getIteration() const {
@@ -315,11 +789,68 @@ int RoadNetwork::getIteration() const {
     return iteration;
 }
 
-int RoadNetwork::findRoadIndex(std::string roadName) const {
-    for (unsigned int i = 0; i < roads.size(); ++i) {
-        if (roads[i]->getName() == roadName) {
-            return i;
-        }
+void RoadNetwork::setIteration(int newIteration) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(newIteration >= 0, "Het aantal iteraties kan niet negatief zijn");
+    iteration = newIteration;
+    ENSURE(getIteration() == newIteration, "De iteratie moet aangepast zijn");
+}
+
+void RoadNetwork::setUseStateStore(bool enabled) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    stateStoreEnabled = enabled;
+    ENSURE(usesStateStore() == enabled, "De gekozen engine moet gebruikt worden");
+}
+
+bool RoadNetwork::usesStateStore() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return stateStoreEnabled;
+}
+
+void RoadNetwork::setUpdateMode(UpdateMode mode) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    updateMode = mode;
+    ENSURE(getUpdateMode() == mode, "De gekozen update mode moet gebruikt worden");
+}
+
+UpdateMode RoadNetwork::getUpdateMode() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return updateMode;
+}
+
+void RoadNetwork::setThreadCount(int threads) {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(threads >= 1, "Er moet minstens 1 thread zijn");
+
+    if (threads != getThreadCount()) {
+        delete workerPool;
+        workerPool = threads > 1 ? new WorkerPool(threads) : NULL;
     }
-    return -1;
+
+    ENSURE(getThreadCount() == threads, "Het gekozen aantal threads moet gebruikt worden");
+}
+
+int RoadNetwork::getThreadCount() const {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    return workerPool == NULL ? 1 : workerPool->getNrOfThreads();
+}
+
+void RoadNetwork::startBulkLoad() {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(!isBulkLoading(), "Het netwerk mag nog niet aan het laden zijn");
+    bulkLoader = new BulkCarLoader(roadGraph, cars);
+    ENSURE(isBulkLoading(), "Het netwerk moet aan het laden zijn");
+}
+
+void RoadNetwork::finishBulkLoad() {
+    REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+    REQUIRE(isBulkLoading(), "Het netwerk moet aan het laden zijn");
+    bulkLoader->finish(cars);
+    delete bulkLoader;
+    bulkLoader = NULL;
+    ENSURE(!isBulkLoading(), "Het netwerk is niet meer aan het laden");
+}
+
+bool RoadNetwork::isBulkLoading() const {
+    return bulkLoader != NULL;
 }
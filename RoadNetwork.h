@@ -11,11 +11,48 @@
 #define ANTROPSE_ROADNETWORK_H
 
 #include "vector"
+#include <string>
+#include <tr1/unordered_map>
+#include "VehicleStateStore.h"
+#include "WorkerPool.h"
+#include "ObjectPool.h"
+#include "RoadGraph.h"
+#include "SignalStateTable.h"
 
 class Road;
 
 class Vehicle;
 
+class Car;
+
+class MotorBike;
+
+class Bus;
+
+class Truck;
+
+class BulkCarLoader;
+
+/**
+ * A vehicle that has driven off the last road of its route and has left the network
+ */
+struct VehicleExit {
+    std::string licensePlate; /**< The license plate of the vehicle */
+    std::string type; /**< The type of the vehicle, e.g. AUTO */
+    std::string roadName; /**< The name of the last road the vehicle drove on */
+    int iteration; /**< The iteration in which the vehicle left the network */
+};
+
+/**
+ * The way moveAllCars updates the cars
+ *
+ * sequentialUpdate: the cars are moved one by one, a car sees the new state of the cars that have already moved
+ * synchronousUpdate: all cars move based on the state of the previous iteration, the order of the cars doesn't matter
+ */
+enum UpdateMode {
+    sequentialUpdate, synchronousUpdate
+};
+
 /**
  * A class used to keep track of all roads and cars in a city
  *
@@ -26,6 +63,8 @@ class RoadNetwork {
 public:
     RoadNetwork();
 
+    ~RoadNetwork();
+
     /**
      * Add a new road to the network
      *
@@ -58,6 +97,41 @@ public:
      */
     bool addCar(Vehicle *car);
 
+    /**
+     * Add a car behind all other cars in the list of cars, to rebuild a network that has been saved or recorded
+     *
+     * addCar keeps the list sorted on the starting positions of the cars, and the cars keep their place while they
+     * move. A saved network is restored by adding its cars in the order of its list, which is only possible with this
+     * function. The spacing between the cars isn't checked. When the car isn't in the queue of its road yet, it's added
+     * to it (see Road::enterVehicle). The road can also be a connection to a road outside the network, which the car
+     * drove onto in its last iteration.
+     *
+     * @param car The car to add, already on a road of the network
+     *
+     * @pre
+     *  REQUIRE(car != NULL and car->properlyInitialized(), "De wagen moet correct geinitialiseerd zijn.");
+     *  REQUIRE(findCar(car->getLicensePlate()) == NULL, "De auto mag nog niet in het netwerk zitten");
+     *  REQUIRE(car->getCurrentRoad() != NULL and (roadGraph.contains(car->getCurrentRoad()) or
+     *          !roadGraph.getPredecessors(car->getCurrentRoad()->getName()).empty()),
+     *          "De auto moet op een weg van het netwerk of op een verbinding ervan staan");
+     *
+     * @post
+     *  ENSURE(findCar(car->getLicensePlate()) == car, "De auto moet in het netwerk zitten");
+     *  ENSURE(getCars().back() == car, "De auto moet achteraan in de lijst staan");
+     */
+    void restoreCar(Vehicle *car);
+
+    /**
+     * Make room for a number of cars that will be added, so the list and the index of the cars don't have to grow
+     * while e.g. a saved network with a million cars is restored
+     *
+     * @param nrOfCars The number of cars the network will contain
+     *
+     * @pre
+     *  REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    void reserveCars(unsigned int nrOfCars);
+
     /**
      * Find a specific road in the RoadNetwork
      *
@@ -68,7 +142,7 @@ public:
      * @pre
      * REQUIRE(properlyInitialized(), "The road must be properly initialized");
      */
-    Road *findRoad(std::string nameRoad);
+    Road *findRoad(const std::string &nameRoad);
 
     /**
      * Get a list of all roads on the RoadNetwork
@@ -90,6 +164,14 @@ public:
      */
     const std::vector<Vehicle *> &getCars() const;
 
+    /**
+     * Get the graph of the roads in the network, e.g. for the predecessors of a road or a topological order
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    const RoadGraph &getRoadGraph() const;
+
     /**
      * check if the road already exists as an intersection of another road
      *
@@ -112,7 +194,7 @@ public:
      * @pre
      * REQUIRE(properlyInitialized(), "The roadnetwork must be properly initialized");
      */
-    Vehicle *findCar(std::string license_plate) const;
+    Vehicle *findCar(const std::string &license_plate) const;
 
     /**
      * Get the number of cars
@@ -139,12 +221,15 @@ public:
     /**
      * Automatische simulatie van het netwerk die door blijft gaan tot er geen wagens meer in het netwerk zitten.
      *
+     * With time skipping enabled, the iterations in which all cars are in a steady state are skipped with
+     * skipSteadyIterations.
+     *
      * @pre
-     *  REQUIRE(check(), "Roadnetwork not valid");
+     *  REQUIRE_FULL(check(), "Roadnetwork not valid");
      *
      * @post
      *  ENSURE(nrOfCars() == 0, "alle auto's zijn buiten hun wegen gereden, er zijn geen auto's meer in het netwerk");
-     *  ENSURE(check(), "Valid roadnnetwork");
+     *  ENSURE_FULL(check(), "Valid roadnnetwork");
      */
     void automaticSimulation(std::ofstream &errStream);
 
@@ -164,6 +249,9 @@ public:
     /**
      * All checks for a valid roadnetwork
      *
+     * Combines checkIfCarsOnExistingRoad, checkPositionCars, checkSpaceBetweenCars and checkIntersections in a single
+     * pass over all cars and over the vehicle queues of all roads, so the cost is linear in the size of the network.
+     *
      * @return true when the roadnetwork is valid
      */
     bool check();
@@ -215,6 +303,97 @@ public:
      */
     void removeVehicle(std::string licensePlate);
 
+    /**
+     * Let a vehicle leave the network at the end of the current iteration
+     *
+     * The vehicle leaves the vehicle queue of its road immediately, so it isn't the vehicle ahead of anyone anymore, but
+     * it stays in the list of cars (without a road) until all cars have moved. The vehicle is then removed and deleted
+     * together with the other vehicles that left in the same iteration, in a single pass over the list of cars.
+     *
+     * @param car The vehicle that drives off the last road of its route
+     *
+     * @pre
+     *  REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     *  REQUIRE(car != NULL and findCar(car->getLicensePlate()) == car, "De auto moet in het netwerk zitten");
+     *  REQUIRE(car->getCurrentRoad() != NULL, "De auto moet op een weg rijden");
+     *
+     * @post
+     *  ENSURE(getExits().back().licensePlate == car->getLicensePlate(), "Het vertrek moet geregistreerd zijn");
+     */
+    void exitVehicle(Vehicle *car);
+
+    /**
+     * Get the vehicles that have left the network during the last iteration
+     *
+     * @return The exits of the last call to moveAllCars, in the order in which the vehicles left
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     */
+    const std::vector<VehicleExit> &getExits() const;
+
+    /**
+     * Create a new vehicle in the pool of its type
+     *
+     * The vehicle is owned by the network: it's destroyed when it's removed from the network, or together with the
+     * network when it's never added. The slot of a destroyed vehicle is reused for the next vehicle of the same type.
+     *
+     * @param type The type of the vehicle: AUTO, MOTORFIETS, BUS or VRACHTWAGEN
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     *
+     * @return The new vehicle, made with its default constructor, or NULL when the type is unknown
+     */
+    Vehicle *createVehicle(const std::string &type);
+
+    /**
+     * Create a new road in the road pool, the road is owned by the network
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     *
+     * @return The new road, made with its default constructor
+     */
+    Road *createRoad();
+
+    /**
+     * Destroy a vehicle that isn't in the network (anymore)
+     *
+     * Vehicles from createVehicle go back to their pool, other vehicles are deleted.
+     *
+     * @param vehicle The vehicle to destroy
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     * REQUIRE(vehicle != NULL, "Het voertuig moet bestaan");
+     */
+    void destroyVehicle(Vehicle *vehicle);
+
+    /**
+     * Destroy a road that isn't in the network
+     *
+     * Roads from createRoad go back to the pool, other roads are deleted.
+     *
+     * @param road The road to destroy
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     * REQUIRE(road != NULL, "De weg moet bestaan");
+     * REQUIRE(findRoad(road->getName()) != road, "De weg mag niet in het netwerk zitten");
+     */
+    void destroyRoad(Road *road);
+
+    /**
+     * Get the allocation counters of the pools of all vehicle types and roads together
+     *
+     * @return The sum of the statistics of all pools
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The network must be properly initialized");
+     */
+    PoolStatistics getPoolStatistics() const;
+
     /**
      * Checks whether there are still cars driving on the roadNetwork
      *
@@ -228,6 +407,8 @@ public:
     /**
      * Move all cars on the road one time unit and increase the current iteration
      *
+     * Every call is one tick for the sampling of the full contracts (see DesignByContract::setSampleInterval).
+     *
      * @pre
      * REQUIRE(properlyInitialized(), "The network must be properly initialized");
      * REQUIRE(check(), "The roadnetwork must be valid);
@@ -263,15 +444,272 @@ public:
      */
     int getIteration() const;
 
+    /**
+     * Set the iteration of the network, to continue a simulation that has been saved or recorded
+     *
+     * @param newIteration The iteration the network is in
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(newIteration >= 0, "Het aantal iteraties kan niet negatief zijn");
+     *
+     * @post
+     * ENSURE(getIteration() == newIteration, "De iteratie moet aangepast zijn");
+     */
+    void setIteration(int newIteration);
+
+    /**
+     * Choose the engine used by moveAllCars to integrate the position and speed of the cars
+     *
+     * The position, speed and speedup of the cars always live in per-road arrays (see VehicleStateStore), the cars
+     * read and write their state there. With the state store engine those arrays are integrated at the start of every
+     * iteration in vectorized loops, without copying anything. The result of the simulation is exactly the same. The
+     * synchronous update mode always integrates in the store, as its next-state buffer.
+     *
+     * @param enabled true to use the state store, false to let every car integrate its own state (default)
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     *
+     * @post
+     * ENSURE(usesStateStore() == enabled, "De gekozen engine moet gebruikt worden");
+     */
+    void setUseStateStore(bool enabled);
+
+    /**
+     * @return true when moveAllCars integrates the kinematics in the state store
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    bool usesStateStore() const;
+
+    /**
+     * Choose how moveAllCars updates the cars
+     *
+     * In synchronous mode an iteration has three phases. First the new position and speed of every car are integrated
+     * from the state of the previous iteration into a next-state buffer (the state store). Then every car commits its
+     * new position and speed, and changes roads or leaves the network. Finally every car calculates its new speedup from
+     * the committed positions. The result is deterministic and independent of the order of the cars.
+     *
+     * @param mode sequentialUpdate (default) or synchronousUpdate
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     *
+     * @post
+     * ENSURE(getUpdateMode() == mode, "De gekozen update mode moet gebruikt worden");
+     */
+    void setUpdateMode(UpdateMode mode);
+
+    /**
+     * @return The way moveAllCars updates the cars
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    UpdateMode getUpdateMode() const;
+
+    /**
+     * Choose the number of threads used by moveAllCars in synchronous update mode
+     *
+     * The roads are divided over the threads. Cars that drive onto another road or leave the network are handed over
+     * after all threads have moved the cars on their own roads, and the errors are written in the order of the cars.
+     * The result is bit-identical to a run with one thread. The sequential update mode always uses one thread.
+     *
+     * @param threads The number of threads, 1 (default) to run everything on the calling thread
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(threads >= 1, "Er moet minstens 1 thread zijn");
+     *
+     * @post
+     * ENSURE(getThreadCount() == threads, "Het gekozen aantal threads moet gebruikt worden");
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @return The number of threads used by moveAllCars in synchronous update mode
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    int getThreadCount() const;
+
+    /**
+     * Get the color of a traffic light in the current iteration
+     *
+     * The colors of all traffic lights in the network are calculated together at the start of every iteration (see
+     * SignalStateTable). For a light that isn't in that table yet, the color is calculated by the light itself.
+     *
+     * @param light A traffic light on a road of the network
+     *
+     * @return The color of the light in the current iteration
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    TrafficLightColor getTrafficLightColor(TrafficLight *light) const;
+
+    /**
+     * Choose whether automaticSimulation skips the iterations in which nothing happens
+     *
+     * @param enabled true to skip iterations with skipSteadyIterations, false to move the cars every iteration (default)
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     *
+     * @post
+     * ENSURE(usesTimeSkipping() == enabled, "De gekozen manier moet gebruikt worden");
+     */
+    void setTimeSkipping(bool enabled);
+
+    /**
+     * @return true when automaticSimulation skips the iterations in which nothing happens
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    bool usesTimeSkipping() const;
+
+    /**
+     * Skip the iterations until the next event, when all cars are in a steady state
+     *
+     * A car is in a steady state when it drives at the speed limit without a car ahead on its road (see
+     * Vehicle::getSteadyIterations). Until one of the cars reaches a zone, traffic light, bus stop or the end of its road,
+     * or a light ahead of a car stops being green, every iteration only moves the cars forward at the same speed. These
+     * iterations are done at once, with exactly the same result as calling moveAllCars for every iteration.
+     *
+     * @param maxIterations The maximum number of iterations to skip
+     *
+     * @return The number of iterations skipped, 0 when a car isn't in a steady state
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(maxIterations >= 0, "Het aantal iteraties kan niet negatief zijn");
+     */
+    int skipSteadyIterations(int maxIterations);
+
+    /**
+     * Choose in how many steps moveAllCars moves the cars that are near a leader, traffic light or bus stop
+     *
+     * These cars (see Vehicle::isNearInteraction) are moved subSteps times with a time step of
+     * CONST::SECONDS_PER_ITERATION / subSteps, so they react more often to what's ahead and brake in time. A car in
+     * free flow, without a car ahead on its road and at a steady speed, takes a large step over the iterations until
+     * it reaches a zone, traffic light, bus stop or the end of its road (see Vehicle::planLargeStep). In those
+     * iterations it's only moved along its trajectory, which is checked once instead of every iteration. The other cars
+     * are moved once per iteration. The iteration counter, and so the colors of the lights and the exports, still go up
+     * by one per iteration: a car in a large step is at the same position every iteration as when it would have been
+     * moved once. Only used in the sequential update mode.
+     *
+     * @param subSteps The number of steps per iteration near an interaction, 1 to move every car once (default)
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(subSteps >= 1, "Er moet minstens een stap per iteratie zijn");
+     *
+     * @post
+     * ENSURE(getSubSteps() == subSteps, "Het aantal stappen moet aangepast zijn");
+     */
+    void setSubSteps(int subSteps);
+
+    /**
+     * @return The number of steps per iteration for the cars that are near an interaction
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     */
+    int getSubSteps() const;
+
+    /**
+     * Start adding many cars at once with addCar
+     *
+     * Until finishBulkLoad, addCar takes O(log N) time instead of O(N), with the same result: the same cars are refused
+     * and the list of cars ends up in the same order (see BulkCarLoader). Roads can still be added and cars and roads
+     * can be found, but the new cars are only in getCars and in the queues of their roads after finishBulkLoad.
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(!isBulkLoading(), "Het netwerk mag nog niet aan het laden zijn");
+     *
+     * @post
+     * ENSURE(isBulkLoading(), "Het netwerk moet aan het laden zijn");
+     */
+    void startBulkLoad();
+
+    /**
+     * Put the cars added since startBulkLoad in the list of cars and in the queues of their roads
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "Het netwerk moet deftig geinitialiseerd zijn");
+     * REQUIRE(isBulkLoading(), "Het netwerk moet aan het laden zijn");
+     *
+     * @post
+     * ENSURE(!isBulkLoading(), "Het netwerk is niet meer aan het laden");
+     */
+    void finishBulkLoad();
+
+    /**
+     * @return true between startBulkLoad and finishBulkLoad
+     */
+    bool isBulkLoading() const;
+
 
 private:
     int iteration;
-    std::vector<Road *> roads; /**< A vector containing all roads in the network */
+    RoadGraph roadGraph; /**< All roads in the network, with their connections */
     std::vector<Vehicle *> cars; /**< A vector containing all registered cars, inside and outside the network, active or
                                * inactive. */
+    std::tr1::unordered_map<std::string, Vehicle *> carsByLicensePlate; /**< Index of all cars on their license plate */
+    bool stateStoreEnabled;
+    UpdateMode updateMode;
+    WorkerPool *workerPool; /**< The threads for the synchronous update mode, NULL when only one thread is used */
+    std::vector<Vehicle *> exitQueue; /**< The cars that left the network in this iteration, deleted at the end */
+    std::vector<VehicleExit> exits; /**< The exits of the last iteration */
+    ObjectPool<Car> carPool;
+    ObjectPool<MotorBike> motorBikePool;
+    ObjectPool<Bus> busPool;
+    ObjectPool<Truck> truckPool;
+    ObjectPool<Road> roadPool;
+    VehicleStateStore stateStore; /**< The position, speed and speedup of all cars */
+    bool timeSkippingEnabled;
+    int subSteps; /**< The number of steps per iteration for the cars near an interaction */
+    BulkCarLoader *bulkLoader; /**< The cars added since startBulkLoad, NULL when the network isn't loading */
+    SignalStateTable signals; /**< The colors of all traffic lights in the current iteration */
+    bool signalsChanged; /**< Whether roads have been added since the lights were put in the table */
+    std::vector<unsigned long> signalRevisions; /**< The revision of every road when the table was filled */
     RoadNetwork *_initCheck;
 
-    int findRoadIndex(std::string roadName) const;
+    bool checkSpaceOnRoad(const Road *road) const;
+
+    /**
+     * Check the space between a car that just entered the queue of its road and its neighbours in that queue
+     */
+    bool checkSpaceAroundCar(const Vehicle *car) const;
+
+    void moveAllCarsSynchronous(std::ostream &errStream);
+
+    void runTask(WorkerPool::Task &task);
+
+    void removeExitedVehicles();
+
+    void updateSignalStates();
+
+    void moveInSubSteps(Vehicle *car, std::ostream &errStream);
+
+    /**
+     * Move a car in the adaptive step mode, in sub-steps or further in its large step
+     *
+     * @return false when the car still has to be moved once
+     */
+    bool moveAdaptively(Vehicle *car, std::ostream &errStream);
+
+    void planLargeStep(Vehicle *car);
+
+    // Het netwerk is eigenaar van de threads, kopieren zou ze twee keer stoppen
+    RoadNetwork(const RoadNetwork &);
+
+    RoadNetwork &operator=(const RoadNetwork &);
 };
 
 
@@ -0,0 +1,61 @@
+/**
+ * @file ScenarioConverter.cpp
+ * @brief This file will contain the converter between xml networks and binary scenarios.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include "MappedFile.h"
+#include "NetworkImporter.h"
+#include "NetworkScenario.h"
+#include "RoadNetwork.h"
+
+/**
+ * ScenarioConverter <input> <output>
+ *
+ * An xml network is written as a binary NetworkScenario, a binary scenario is written as xml.
+ */
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "Gebruik: " << argv[0] << " <input> <output>" << std::endl;
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    // Zoals bij de simulatie krijgt een verkeerslicht zonder offset een willekeurige offset, die wordt bewaard
+    srand(time(0));
+
+    // Het bestand wordt een keer geopend, de eerste bytes zeggen of het xml of een binair scenario is
+    MappedFile file;
+    if (!file.open(input)) {
+        std::cerr << "Het bestand " << input << " kan niet geopend worden" << std::endl;
+        return 1;
+    }
+    bool toXml = NetworkScenario::isScenario(file.getData(), file.getSize());
+    RoadNetwork roadNetwork;
+    SuccessEnum result = NetworkImporter::importRoadNetwork(file.getData(), file.getSize(), std::cerr, &roadNetwork);
+    file.close();
+    if (result == ImportAborted or result == ImportFailed) {
+        return 1;
+    }
+
+    bool written;
+    if (toXml) {
+        std::ofstream outStream(output.c_str());
+        written = outStream and NetworkScenario::saveXml(roadNetwork, outStream);
+    } else {
+        written = NetworkScenario::save(roadNetwork, output);
+    }
+    if (!written) {
+        std::cerr << "Het netwerk kon niet naar " << output << " geschreven worden" << std::endl;
+        return 1;
+    }
+    return result == Success ? 0 : 2;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file SignalStateTable.cpp
+ * @brief This file will contain the definitions of the functions in SignalStateTable.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+// Zoals in VehicleStateStore: zonder -mavx wordt de AVX-lus apart gecompileerd en gekozen als de processor het kan
+#if !defined(__AVX__) and defined(__SSE2__) and (defined(__clang__) or __GNUC__ >= 5)
+#define SIGNALSTATETABLE_AVX_DISPATCH
+#endif
+
+#if defined(__AVX__) or defined(SIGNALSTATETABLE_AVX_DISPATCH)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cmath>
+#include "SignalStateTable.h"
+#include "DesignByContract.h"
+
+namespace {
+    /**
+     * The arrays of the table that are read and written when the time goes up by one
+     */
+    struct PhaseArrays {
+        double *phase;
+        const double *cycle;
+        const double *greenEnd;
+        const double *orangeEnd;
+        int *color;
+    };
+
+    // Een cyclus is minstens 1 lang, dus na een stap van 1 moet er hoogstens een cyclus afgetrokken worden. De kleur
+    // is het aantal grenzen dat al gepasseerd is: 0 voor groen, 1 voor oranje en 2 voor rood. Elke lus begint bij
+    // light en geeft het eerste licht terug dat ze niet deed.
+
+#if defined(__AVX__) or defined(SIGNALSTATETABLE_AVX_DISPATCH)
+#if defined(SIGNALSTATETABLE_AVX_DISPATCH)
+    __attribute__((target("avx")))
+#endif
+    unsigned int advanceAvx(const PhaseArrays &table, unsigned int light, unsigned int size) {
+        const __m256d one4 = _mm256_set1_pd(1);
+        unsigned int i = light;
+        for (; i + 4 <= size; i += 4) {
+            __m256d phase4 = _mm256_add_pd(_mm256_loadu_pd(table.phase + i), one4);
+            __m256d cycle4 = _mm256_loadu_pd(table.cycle + i);
+            phase4 = _mm256_sub_pd(phase4, _mm256_and_pd(_mm256_cmp_pd(phase4, cycle4, _CMP_GE_OQ), cycle4));
+            _mm256_storeu_pd(table.phase + i, phase4);
+
+            __m256d color4 = _mm256_add_pd(
+                    _mm256_and_pd(_mm256_cmp_pd(phase4, _mm256_loadu_pd(table.greenEnd + i), _CMP_GE_OQ), one4),
+                    _mm256_and_pd(_mm256_cmp_pd(phase4, _mm256_loadu_pd(table.orangeEnd + i), _CMP_GE_OQ), one4));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(table.color + i), _mm256_cvttpd_epi32(color4));
+        }
+        return i;
+    }
+#endif
+
+#if defined(__SSE2__)
+    unsigned int advanceSse2(const PhaseArrays &table, unsigned int light, unsigned int size) {
+        const __m128d one2 = _mm_set1_pd(1);
+        unsigned int i = light;
+        for (; i + 2 <= size; i += 2) {
+            __m128d phase2 = _mm_add_pd(_mm_loadu_pd(table.phase + i), one2);
+            __m128d cycle2 = _mm_loadu_pd(table.cycle + i);
+            phase2 = _mm_sub_pd(phase2, _mm_and_pd(_mm_cmpge_pd(phase2, cycle2), cycle2));
+            _mm_storeu_pd(table.phase + i, phase2);
+
+            __m128d color2 = _mm_add_pd(_mm_and_pd(_mm_cmpge_pd(phase2, _mm_loadu_pd(table.greenEnd + i)), one2),
+                                        _mm_and_pd(_mm_cmpge_pd(phase2, _mm_loadu_pd(table.orangeEnd + i)), one2));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(table.color + i), _mm_cvttpd_epi32(color2));
+        }
+        return i;
+    }
+#endif
+
+    void advanceScalar(const PhaseArrays &table, unsigned int light, unsigned int size) {
+        for (unsigned int i = light; i < size; ++i) {
+            table.phase[i] += 1;
+            if (table.phase[i] >= table.cycle[i]) {
+                table.phase[i] -= table.cycle[i];
+            }
+            table.color[i] = (table.phase[i] >= table.greenEnd[i]) + (table.phase[i] >= table.orangeEnd[i]);
+        }
+    }
+}
+
+SignalStateTable::SignalStateTable() : time(0), upToDate(false) {
+    _initCheck = this;
+}
+
+bool SignalStateTable::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+void SignalStateTable::clear() {
+    REQUIRE(properlyInitialized(), "The table must be properly initialized");
+    for (unsigned int i = 0; i < lights.size(); ++i) {
+        lights[i]->setSignalId(-1);
+    }
+    lights.clear();
+    offsets.clear();
+    cycles.clear();
+    greenEnds.clear();
+    orangeEnds.clear();
+    phases.clear();
+    colors.clear();
+    upToDate = false;
+    ENSURE(nrOfTrafficLights() == 0, "De tabel moet leeg zijn");
+}
+
+int SignalStateTable::addTrafficLight(TrafficLight *light) {
+    REQUIRE(properlyInitialized(), "The table must be properly initialized");
+    REQUIRE(light != NULL and !contains(light), "Het licht mag nog niet in de tabel zitten");
+
+    int id = lights.size();
+    lights.push_back(light);
+    offsets.push_back(light->getStartOffset());
+    // In dezelfde volgorde opgeteld als in TrafficLight::getColor, zodat de grenzen bit per bit gelijk zijn
+    cycles.push_back(light->getGreenDuration() + light->getOrangeDuration() + light->getRedDuration());
+    greenEnds.push_back(light->getGreenDuration());
+    orangeEnds.push_back(light->getOrangeDuration() + light->getGreenDuration());
+    phases.push_back(0);
+    colors.push_back(green);
+    light->setSignalId(id);
+    upToDate = false;
+
+    ENSURE(contains(light), "Het licht moet in de tabel zitten");
+    return id;
+}
+
+void SignalStateTable::update(double newTime) {
+    REQUIRE(properlyInitialized(), "The table must be properly initialized");
+
+    if (upToDate and newTime == time + 1) {
+        time = newTime;
+        advancePhases();
+    } else if (!upToDate or newTime != time) {
+        time = newTime;
+        calculatePhases();
+    }
+    upToDate = true;
+
+    ENSURE(isUpToDate(newTime), "De kleuren moeten berekend zijn");
+}
+
+bool SignalStateTable::isUpToDate(double atTime) const {
+    return upToDate and time == atTime;
+}
+
+bool SignalStateTable::contains(const TrafficLight *light) const {
+    int id = light->getSignalId();
+    return id >= 0 and id < (int) lights.size() and lights[id] == light;
+}
+
+TrafficLightColor SignalStateTable::getColor(const TrafficLight *light) const {
+    REQUIRE(contains(light), "Het licht moet in de tabel zitten");
+    return static_cast<TrafficLightColor>(colors[light->getSignalId()]);
+}
+
+const std::vector<int> &SignalStateTable::getColors() const {
+    return colors;
+}
+
+int SignalStateTable::nrOfTrafficLights() const {
+    return lights.size();
+}
+
+void SignalStateTable::calculatePhases() {
+    for (unsigned int i = 0; i < lights.size(); ++i) {
+        phases[i] = std::fmod(time + offsets[i], cycles[i]);
+        if (phases[i] < greenEnds[i]) {
+            colors[i] = green;
+        } else if (phases[i] < orangeEnds[i]) {
+            colors[i] = orange;
+        } else {
+            colors[i] = red;
+        }
+    }
+}
+
+void SignalStateTable::advancePhases() {
+    unsigned int size = lights.size();
+    if (size == 0) {
+        return;
+    }
+
+    PhaseArrays table;
+    table.phase = &phases[0];
+    table.cycle = &cycles[0];
+    table.greenEnd = &greenEnds[0];
+    table.orangeEnd = &orangeEnds[0];
+    table.color = &colors[0];
+
+    unsigned int i = 0;
+#if defined(__AVX__)
+    i = advanceAvx(table, i, size);
+#elif defined(SIGNALSTATETABLE_AVX_DISPATCH)
+    if (__builtin_cpu_supports("avx")) {
+        i = advanceAvx(table, i, size);
+    }
+#endif
+#if defined(__SSE2__)
+    i = advanceSse2(table, i, size);
+#endif
+    advanceScalar(table, i, size);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file SignalStateTable.h
+ * @brief This header file will contain the SignalStateTable class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_SIGNALSTATETABLE_H
+#define ANTROPSE_SIGNALSTATETABLE_H
+
+#include <vector>
+#include "TrafficLight.h"
+
+/**
+ * The colors of all traffic lights of a network at one point in time
+ *
+ * Every light gets an id, its place in flat arrays with the cycle of the light and its place in that cycle. The colors
+ * of all lights are calculated together once per iteration, instead of every time a vehicle or exporter asks for them.
+ * When the time goes up by one, the place in the cycle of every light is updated in a vectorized pass, with AVX when
+ * the processor supports it (also without -mavx), SSE2 or a scalar fallback. After any other change of time, it's
+ * calculated again from the offset of the light, in the same way as TrafficLight::getColor.
+ */
+class SignalStateTable {
+public:
+    SignalStateTable();
+
+    /**
+     * Remove all lights from the table
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The table must be properly initialized");
+     *
+     * @post
+     * ENSURE(nrOfTrafficLights() == 0, "De tabel moet leeg zijn");
+     */
+    void clear();
+
+    /**
+     * Add a light to the table, its color is only known after the next update
+     *
+     * @param light The light to add
+     *
+     * @return The id of the light in the table
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The table must be properly initialized");
+     * REQUIRE(light != NULL and !contains(light), "Het licht mag nog niet in de tabel zitten");
+     *
+     * @post
+     * ENSURE(contains(light), "Het licht moet in de tabel zitten");
+     */
+    int addTrafficLight(TrafficLight *light);
+
+    /**
+     * Calculate the colors of all lights at a point in time
+     *
+     * @param time The time, in the same unit as the durations of the lights
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The table must be properly initialized");
+     *
+     * @post
+     * ENSURE(isUpToDate(time), "De kleuren moeten berekend zijn");
+     */
+    void update(double time);
+
+    /**
+     * @return true when the colors of all lights in the table have been calculated for this time
+     */
+    bool isUpToDate(double time) const;
+
+    /**
+     * @return true when the light is in this table
+     */
+    bool contains(const TrafficLight *light) const;
+
+    /**
+     * @return The color of the light at the time of the last update
+     *
+     * @pre
+     * REQUIRE(contains(light), "Het licht moet in de tabel zitten");
+     */
+    TrafficLightColor getColor(const TrafficLight *light) const;
+
+    /**
+     * @return The colors of all lights at the time of the last update, indexed on the id of the light
+     */
+    const std::vector<int> &getColors() const;
+
+    /**
+     * @return The number of lights in the table
+     */
+    int nrOfTrafficLights() const;
+
+    bool properlyInitialized() const;
+
+private:
+    void calculatePhases();
+
+    void advancePhases();
+
+    std::vector<TrafficLight *> lights;
+    std::vector<double> offsets;
+    std::vector<double> cycles; /**< The sum of the durations of all colors */
+    std::vector<double> greenEnds; /**< The place in the cycle where the light turns orange */
+    std::vector<double> orangeEnds; /**< The place in the cycle where the light turns red */
+    std::vector<double> phases; /**< The place in the cycle of every light at the time of the last update */
+    std::vector<int> colors;
+    double time;
+    bool upToDate; /**< Whether phases and colors belong to time, false after adding a light */
+
+    SignalStateTable *_initCheck;
+};
+
+
+#endif //ANTROPSE_SIGNALSTATETABLE_H
@@ -31,15 +31,16 @@ const TiXmlString::size_type TiXmlString::npos = static_cast< TiXmlString::size_
 
 
 // Null rep.
-TiXmlString::Rep TiXmlString::nullrep_ = { 0, 0, { '\0' } };
+TiXmlString::Rep TiXmlString::nullrep_ = { 0, 0, 0, { '\0' } };
 
 
 void TiXmlString::reserve (size_type cap)
 {
-	if (cap > capacity())
+	// A shared buffer is copied before it can be changed
+	if (cap > capacity() || shared())
 	{
 		TiXmlString tmp;
-		tmp.init(length(), cap);
+		tmp.init(length(), cap > capacity() ? cap : capacity());
 		memcpy(tmp.start(), data(), length());
 		swap(tmp);
 	}
@@ -49,7 +50,7 @@ void TiXmlString::reserve (size_type cap)
 TiXmlString& TiXmlString::assign(const char* str, size_type len)
 {
 	size_type cap = capacity();
-	if (len > cap || cap > 3*(len + 8))
+	if (len > cap || cap > 3*(len + 8) || shared())
 	{
 		TiXmlString tmp;
 		tmp.init(len);
@@ -72,6 +73,10 @@ TiXmlString& TiXmlString::append(const char* str, size_type len)
 	{
 		reserve (newsize + capacity());
 	}
+	else if (shared())
+	{
+		reserve (capacity());
+	}
 	memmove(finish(), str, len);
 	set_size(newsize);
 	return *this;
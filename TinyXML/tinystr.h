@@ -51,6 +51,9 @@ distribution.
    Only the member functions relevant to the TinyXML project have been implemented.
    The buffer allocation is made by a simplistic power of 2 like mechanism : if we increase
    a string and there's no more room, we allocate a buffer twice as big as we need.
+   Copies share the buffer, which is reference counted and copied on the first change, so
+   a TiXmlDocument can intern its names and values (see TiXmlDocument::Intern). The count
+   isn't atomic: copies of one string must stay in one thread.
 */
 class TiXmlString
 {
@@ -67,11 +70,10 @@ class TiXmlString
 	{
 	}
 
-	// TiXmlString copy constructor
-	TiXmlString ( const TiXmlString & copy) : rep_(0)
+	// TiXmlString copy constructor, shares the buffer of copy
+	TiXmlString ( const TiXmlString & copy) : rep_(copy.rep_)
 	{
-		init(copy.length());
-		memcpy(start(), copy.data(), length());
+		acquire();
 	}
 
 	// TiXmlString constructor, based on a string
@@ -101,7 +103,13 @@ class TiXmlString
 
 	TiXmlString& operator = (const TiXmlString & copy)
 	{
-		return assign(copy.start(), copy.length());
+		if (rep_ != copy.rep_)
+		{
+			quit();
+			rep_ = copy.rep_;
+			acquire();
+		}
+		return *this;
 	}
 
 
@@ -150,8 +158,8 @@ class TiXmlString
 		return rep_->str[ index ];
 	}
 
-	// [] operator
-	char& operator [] (size_type index) const
+	// [] operator, read only because the buffer can be shared
+	const char& operator [] (size_type index) const
 	{
 		assert( index < length() );
 		return rep_->str[ index ];
@@ -201,6 +209,9 @@ class TiXmlString
 		other.rep_ = r;
 	}
 
+	// Whether the buffer is shared with other strings
+	bool shared () const { return rep_ != &nullrep_ && rep_->refs > 1; }
+
   private:
 
 	void init(size_type sz) { init(sz, sz); }
@@ -210,7 +221,7 @@ class TiXmlString
 
 	struct Rep
 	{
-		size_type size, capacity;
+		size_type size, capacity, refs;
 		char str[1];
 	};
 
@@ -229,6 +240,7 @@ class TiXmlString
 
 			rep_->str[ rep_->size = sz ] = '\0';
 			rep_->capacity = cap;
+			rep_->refs = 1;
 		}
 		else
 		{
@@ -236,9 +248,17 @@ class TiXmlString
 		}
 	}
 
-	void quit()
+	void acquire()
 	{
 		if (rep_ != &nullrep_)
+		{
+			++rep_->refs;
+		}
+	}
+
+	void quit()
+	{
+		if (rep_ != &nullrep_ && --rep_->refs == 0)
 		{
 			// The rep_ is really an array of ints. (see the allocator, above).
 			// Cast it back before delete, so the compiler won't incorrectly call destructors.
@@ -31,8 +31,42 @@ distribution.
 
 #include "tinyxml.h"
 
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TIXML_MMAP
+#endif
+
 FILE* TiXmlFOpen( const char* filename, const char* mode );
 
+#ifdef TIXML_MMAP
+// Maps length bytes of a file read-only, followed by at least one page of zeros, so the
+// parser finds the terminating 0 right after the data without copying it. The whole
+// mapping is mappedLength bytes long. Returns 0 when the file can't be mapped (a pipe, ...).
+static const char* MapFile( FILE* file, size_t length, size_t* mappedLength )
+{
+	int descriptor = fileno( file );
+	struct stat status;
+	if ( fstat( descriptor, &status ) != 0 || !S_ISREG( status.st_mode ) || (size_t) status.st_size != length )
+		return 0;
+
+	size_t pageSize = (size_t) sysconf( _SC_PAGESIZE );
+	size_t total = ( length / pageSize + 1 ) * pageSize;
+	void* reserved = mmap( 0, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if ( reserved == MAP_FAILED )
+		return 0;
+	// The rest of the last page of the file is filled with zeros, the pages after it stay anonymous.
+	if ( mmap( reserved, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, descriptor, 0 ) == MAP_FAILED )
+	{
+		munmap( reserved, total );
+		return 0;
+	}
+	*mappedLength = total;
+	return static_cast< const char* >( reserved );
+}
+#endif
+
 bool TiXmlBase::condenseWhiteSpace = true;
 
 // Microsoft compiler security
@@ -49,6 +83,111 @@ FILE* TiXmlFOpen( const char* filename, const char* mode )
 	#endif
 }
 
+void* TiXmlArena::Allocate( size_t size )
+{
+	// Rounded up to the size of the header, the alignment of ::operator new is kept for every object
+	size = ( size + sizeof( Block ) - 1 ) / sizeof( Block ) * sizeof( Block );
+	if ( size > left )
+	{
+		size_t blockSize = size > BLOCK_SIZE / 4 ? size + sizeof( Block ) : (size_t) BLOCK_SIZE;
+		Block* block = static_cast< Block* >( ::operator new( blockSize ) );
+		block->next = blocks;
+		block->size = blockSize;
+		blocks = block;
+		free = reinterpret_cast< char* >( block + 1 );
+		left = blockSize - sizeof( Block );
+	}
+	void* object = free;
+	free += size;
+	left -= size;
+	return object;
+}
+
+
+void TiXmlArena::Release( bool keepBlock )
+{
+	Block* kept = 0;
+	while ( blocks )
+	{
+		Block* block = blocks;
+		blocks = block->next;
+		if ( keepBlock && !kept && block->size == BLOCK_SIZE )
+			kept = block;
+		else
+			::operator delete( block );
+	}
+	if ( kept )
+	{
+		kept->next = 0;
+		blocks = kept;
+		free = reinterpret_cast< char* >( kept + 1 );
+		left = BLOCK_SIZE - sizeof( Block );
+	}
+	else
+	{
+		free = 0;
+		left = 0;
+	}
+}
+
+
+void TiXmlStringTable::Intern( TIXML_STRING* text )
+{
+	#ifndef TIXML_USE_STL
+	if ( text->empty() )
+		return;
+	if ( 2 * ( count + 1 ) > capacity )
+		Grow();
+
+	// FNV-1a
+	size_t hash = 2166136261u;
+	for ( size_t i = 0; i < text->length(); ++i )
+		hash = ( hash ^ (unsigned char) (*text)[ i ] ) * 16777619u;
+
+	size_t i = hash & ( capacity - 1 );
+	while ( !slots[ i ].empty() )
+	{
+		if ( slots[ i ] == *text )
+		{
+			*text = slots[ i ];
+			return;
+		}
+		i = ( i + 1 ) & ( capacity - 1 );
+	}
+	slots[ i ] = *text;
+	++count;
+	#else
+	(void) text;
+	#endif
+}
+
+
+void TiXmlStringTable::Clear()
+{
+	delete [] slots;
+	slots = 0;
+	capacity = 0;
+	count = 0;
+}
+
+
+void TiXmlStringTable::Grow()
+{
+	TIXML_STRING* old = slots;
+	size_t oldCapacity = capacity;
+
+	capacity = capacity ? 2 * capacity : 64;
+	slots = new TIXML_STRING[ capacity ];
+	count = 0;
+	for ( size_t i = 0; i < oldCapacity; ++i )
+	{
+		if ( !old[ i ].empty() )
+			Intern( &old[ i ] );
+	}
+	delete [] old;
+}
+
+
 void TiXmlBase::EncodeString( const TIXML_STRING& str, TIXML_STRING* outString )
 {
 	int i=0;
@@ -153,7 +292,7 @@ TiXmlNode::~TiXmlNode()
 	{
 		temp = node;
 		node = node->next;
-		delete temp;
+		Destroy( temp );
 	}	
 }
 
@@ -175,11 +314,14 @@ void TiXmlNode::Clear()
 	{
 		temp = node;
 		node = node->next;
-		delete temp;
+		Destroy( temp );
 	}	
 
 	firstChild = 0;
 	lastChild = 0;
+
+	if ( type == TINYXML_DOCUMENT )
+		static_cast< TiXmlDocument* >( this )->ReleaseParsed();
 }
 
 
@@ -190,7 +332,7 @@ TiXmlNode* TiXmlNode::LinkEndChild( TiXmlNode* node )
 
 	if ( node->Type() == TiXmlNode::TINYXML_DOCUMENT )
 	{
-		delete node;
+		Destroy( node );
 		if ( GetDocument() ) 
 			GetDocument()->SetError( TIXML_ERROR_DOCUMENT_TOP_ONLY, 0, 0, TIXML_ENCODING_UNKNOWN );
 		return 0;
@@ -326,7 +468,7 @@ TiXmlNode* TiXmlNode::ReplaceChild( TiXmlNode* replaceThis, const TiXmlNode& wit
 	else
 		firstChild = node;
 
-	delete replaceThis;
+	Destroy( replaceThis );
 	node->parent = this;
 	return node;
 }
@@ -354,7 +496,7 @@ bool TiXmlNode::RemoveChild( TiXmlNode* removeThis )
 	else
 		firstChild = removeThis->next;
 
-	delete removeThis;
+	Destroy( removeThis );
 	return true;
 }
 
@@ -445,7 +587,7 @@ void TiXmlElement::RemoveAttribute( const char * name )
 	if ( node )
 	{
 		attributeSet.Remove( node );
-		delete node;
+		Destroy( node );
 	}
 }
 
@@ -569,7 +711,7 @@ void TiXmlElement::ClearThis()
 	{
 		TiXmlAttribute* node = attributeSet.First();
 		attributeSet.Remove( node );
-		delete node;
+		Destroy( node );
 	}
 }
 
@@ -943,6 +1085,13 @@ TiXmlDocument::TiXmlDocument( const TiXmlDocument& copy ) : TiXmlNode( TiXmlNode
 }
 
 
+TiXmlDocument::~TiXmlDocument()
+{
+	// The children have to be destructed before their arena is freed.
+	Clear();
+}
+
+
 TiXmlDocument& TiXmlDocument::operator=( const TiXmlDocument& copy )
 {
 	Clear();
@@ -951,6 +1100,13 @@ TiXmlDocument& TiXmlDocument::operator=( const TiXmlDocument& copy )
 }
 
 
+void TiXmlDocument::ReleaseParsed()
+{
+	arena.Release( true );
+	strings.Clear();
+}
+
+
 bool TiXmlDocument::LoadFile( TiXmlEncoding encoding )
 {
 	return LoadFile( Value(), encoding );
@@ -967,7 +1123,7 @@ bool TiXmlDocument::LoadFile( const char* _filename, TiXmlEncoding encoding )
 	TIXML_STRING filename( _filename );
 	value = filename;
 
-	// reading in binary mode so that tinyxml can normalize the EOL
+	// reading in binary mode so that tinyxml can normalize the EOL, and map it when possible
 	FILE* file = TiXmlFOpen( value.c_str (), "rb" );	
 
 	if ( file )
@@ -1018,16 +1174,20 @@ bool TiXmlDocument::LoadFile( FILE* file, TiXmlEncoding encoding )
 	// a single #xA character.
 	// </quote>
 	//
-	// It is not clear fgets does that, and certainly isn't clear it works cross platform. 
-	// Generally, you expect fgets to translate from the convention of the OS to the c/unix
-	// convention, and not work generally.
+	// The parser does that itself while it copies the text (see AppendNormalized), so the
+	// file can be parsed as it is: straight from the mapped pages when it can be mapped,
+	// otherwise from a single copy.
 
-	/*
-	while( fgets( buf, sizeof(buf), file ) )
+	#ifdef TIXML_MMAP
+	size_t mappedLength = 0;
+	const char* mapped = MapFile( file, (size_t) length, &mappedLength );
+	if ( mapped )
 	{
-		data += buf;
+		Parse( mapped, 0, encoding );
+		munmap( const_cast< char* >( mapped ), mappedLength );
+		return !Error();
 	}
-	*/
+	#endif
 
 	char* buf = new char[ length+1 ];
 	buf[0] = 0;
@@ -1037,42 +1197,7 @@ bool TiXmlDocument::LoadFile( FILE* file, TiXmlEncoding encoding )
 		SetError( TIXML_ERROR_OPENING_FILE, 0, 0, TIXML_ENCODING_UNKNOWN );
 		return false;
 	}
-
-	// Process the buffer in place to normalize new lines. (See comment above.)
-	// Copies from the 'p' to 'q' pointer, where p can advance faster if
-	// a newline-carriage return is hit.
-	//
-	// Wikipedia:
-	// Systems based on ASCII or a compatible character set use either LF  (Line feed, '\n', 0x0A, 10 in decimal) or 
-	// CR (Carriage return, '\r', 0x0D, 13 in decimal) individually, or CR followed by LF (CR+LF, 0x0D 0x0A)...
-	//		* LF:    Multics, Unix and Unix-like systems (GNU/Linux, AIX, Xenix, Mac OS X, FreeBSD, etc.), BeOS, Amiga, RISC OS, and others
-    //		* CR+LF: DEC RT-11 and most other early non-Unix, non-IBM OSes, CP/M, MP/M, DOS, OS/2, Microsoft Windows, Symbian OS
-    //		* CR:    Commodore 8-bit machines, Apple II family, Mac OS up to version 9 and OS-9
-
-	const char* p = buf;	// the read head
-	char* q = buf;			// the write head
-	const char CR = 0x0d;
-	const char LF = 0x0a;
-
 	buf[length] = 0;
-	while( *p ) {
-		assert( p < (buf+length) );
-		assert( q <= (buf+length) );
-		assert( q <= p );
-
-		if ( *p == CR ) {
-			*q++ = LF;
-			p++;
-			if ( *p == LF ) {		// check for CR+LF (and skip LF)
-				p++;
-			}
-		}
-		else {
-			*q++ = *p++;
-		}
-	}
-	assert( q <= (buf+length) );
-	*q = 0;
 
 	Parse( buf, 0, encoding );
 
@@ -106,6 +106,71 @@ struct TiXmlCursor
 };
 
 
+/*	Memory for the nodes and attributes a TiXmlDocument parses, taken from big blocks
+	instead of one heap allocation per object. The objects are still destructed one by
+	one (see TiXmlBase::Destroy), but their memory is only given back all at once, when
+	the document is cleared or destroyed.
+*/
+class TiXmlArena
+{
+public:
+	TiXmlArena() : blocks( 0 ), free( 0 ), left( 0 ) {}
+	~TiXmlArena() { Release( false ); }
+
+	// Memory for an object of the given size, aligned for any type.
+	void* Allocate( size_t size );
+
+	/*	Gives back the memory of all objects at once, they must all be destructed. The
+		last block is kept for reuse when keepBlock is true.
+	*/
+	void Release( bool keepBlock );
+
+private:
+	TiXmlArena( const TiXmlArena& );				// not implemented.
+	void operator=( const TiXmlArena& );			// not allowed.
+
+	// The header of a block, the objects follow it
+	struct Block
+	{
+		Block* next;
+		size_t size;
+	};
+	enum { BLOCK_SIZE = 64 * 1024 };
+
+	Block* blocks;		// the most recent block, linked to the ones before it
+	char* free;			// the start of the unused part of the most recent block
+	size_t left;		// the size of that unused part
+};
+
+
+/*	The distinct names and values of a TiXmlDocument. Equal strings share one buffer
+	through the reference count of TiXmlString, so a name that is repeated in every
+	element is only stored once. With std::string (TIXML_USE_STL) nothing is shared.
+*/
+class TiXmlStringTable
+{
+public:
+	TiXmlStringTable() : slots( 0 ), capacity( 0 ), count( 0 ) {}
+	~TiXmlStringTable() { delete [] slots; }
+
+	// Lets text share the buffer of an equal string in the table, which is added when there is none.
+	void Intern( TIXML_STRING* text );
+
+	// Removes all strings, the copies that are still used keep their buffer.
+	void Clear();
+
+private:
+	TiXmlStringTable( const TiXmlStringTable& );	// not implemented.
+	void operator=( const TiXmlStringTable& );		// not allowed.
+
+	void Grow();
+
+	TIXML_STRING* slots;	// open addressing, an empty string is an empty slot
+	size_t capacity;		// a power of 2
+	size_t count;
+};
+
+
 /**
 	Implements the interface to the "Visitor pattern" (see the Accept() method.)
 	If you call the Accept() method, it requires being passed a TiXmlVisitor
@@ -198,9 +263,26 @@ class TiXmlBase
 	friend class TiXmlDocument;
 
 public:
-	TiXmlBase()	:	userData(0)		{}
+	TiXmlBase()	:	userData(0), inArena(false)		{}
 	virtual ~TiXmlBase()			{}
 
+	// Nodes and attributes are created on the heap, or with new( arena ) in the arena of a document.
+	static void* operator new( size_t size )						{ return ::operator new( size ); }
+	static void* operator new( size_t size, TiXmlArena* arena )	{ return arena ? arena->Allocate( size ) : ::operator new( size ); }
+	static void operator delete( void* p )							{ ::operator delete( p ); }
+	static void operator delete( void* p, TiXmlArena* arena )		{ if ( !arena ) ::operator delete( p ); }
+
+	/*	Deletes an object that may be in the arena of its document. Nodes and attributes
+		the DOM owns are always removed through this, never with delete.
+	*/
+	static void Destroy( TiXmlBase* object )
+	{
+		if ( object->inArena )
+			object->~TiXmlBase();
+		else
+			delete object;
+	}
+
 	/**	All TinyXml classes can print themselves to a filestream
 		or the string class (TiXmlString in non-STL mode, std::string
 		in STL mode.) Either or both cfile and str can be null.
@@ -319,6 +401,22 @@ protected:
 									bool ignoreCase,			// whether to ignore case in the end tag
 									TiXmlEncoding encoding );	// the current encoding
 
+	/*	Appends the character at p to the text, with "\r\n" and a single "\r" translated
+		to "\n" as the XML spec (2.11 End-of-Line Handling) requires. The input isn't
+		normalized before parsing, so every loop that copies raw characters uses this.
+		Returns a pointer past the character(s) read.
+	*/
+	inline static const char* AppendNormalized( const char* p, TIXML_STRING* text )
+	{
+		if ( *p == '\r' )
+		{
+			*text += '\n';
+			return ( *(p+1) == '\n' ) ? p+2 : p+1;
+		}
+		*text += *p;
+		return p+1;
+	}
+
 	// If an entity has been found, transform it into a character.
 	static const char* GetEntity( const char* in, char* value, int* length, TiXmlEncoding encoding );
 
@@ -374,6 +472,9 @@ protected:
 
     /// Field containing a generic user pointer
 	void*			userData;
+
+	// Whether the object was created in the arena of its document (see Destroy)
+	bool			inArena;
 	
 	// None of these methods are reliable for any language except English.
 	// Good for approximation, not great for accuracy.
@@ -1392,6 +1493,10 @@ private:
 */
 class TiXmlDocument : public TiXmlNode
 {
+	friend class TiXmlNode;
+	friend class TiXmlElement;
+	friend class TiXmlAttribute;
+
 public:
 	/// Create an empty document, that has no name.
 	TiXmlDocument();
@@ -1406,7 +1511,7 @@ public:
 	TiXmlDocument( const TiXmlDocument& copy );
 	TiXmlDocument& operator=( const TiXmlDocument& copy );
 
-	virtual ~TiXmlDocument() {}
+	virtual ~TiXmlDocument();
 
 	/** Load a file using the current document value.
 		Returns true if successful. Will delete any existing
@@ -1546,6 +1651,16 @@ protected :
 private:
 	void CopyTo( TiXmlDocument* target ) const;
 
+	/*	Called by TiXmlNode::Clear when the document has no children anymore: the arena
+		and the string table only hold what the children used.
+	*/
+	void ReleaseParsed();
+
+	// Lets a parsed name or value share its buffer with the equal ones in the document.
+	void Intern( TIXML_STRING* text )	{ strings.Intern( text ); }
+
+	TiXmlArena arena;				// the nodes and attributes that have been parsed
+	TiXmlStringTable strings;		// their distinct names and values
 	bool error;
 	int  errorId;
 	TIXML_STRING errorDesc;
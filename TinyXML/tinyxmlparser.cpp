@@ -587,6 +587,11 @@ const char* TiXmlBase::ReadText(	const char* p,
 				&& !StringEqual( p, endTag, caseInsensitive, encoding )
 			  )
 		{
+			if ( *p == '\r' )
+			{
+				p = AppendNormalized( p, text );
+				continue;
+			}
 			int len;
 			char cArr[4] = { 0, 0, 0, 0 };
 			p = GetChar( p, cArr, &len, encoding );
@@ -678,7 +683,7 @@ void TiXmlDocument::StreamIn( std::istream * in, TIXML_STRING * tag )
 			{
 				node->StreamIn( in, tag );
 				bool isElement = node->ToElement() != 0;
-				delete node;
+				Destroy( node );
 				node = 0;
 
 				// If this is the root element, we're done. Parsing will be
@@ -839,6 +844,10 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 	// - Everthing else is unknown to tinyxml.
 	//
 
+	// The nodes of a document are created in its arena
+	TiXmlDocument* document = GetDocument();
+	TiXmlArena* arena = document ? &document->arena : 0;
+
 	const char* xmlHeader = { "<?xml" };
 	const char* commentHeader = { "<!--" };
 	const char* dtdHeader = { "<!" };
@@ -849,21 +858,21 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Declaration\n" );
 		#endif
-		returnNode = new TiXmlDeclaration();
+		returnNode = new( arena ) TiXmlDeclaration();
 	}
 	else if ( StringEqual( p, commentHeader, false, encoding ) )
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Comment\n" );
 		#endif
-		returnNode = new TiXmlComment();
+		returnNode = new( arena ) TiXmlComment();
 	}
 	else if ( StringEqual( p, cdataHeader, false, encoding ) )
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing CDATA\n" );
 		#endif
-		TiXmlText* text = new TiXmlText( "" );
+		TiXmlText* text = new( arena ) TiXmlText( "" );
 		text->SetCDATA( true );
 		returnNode = text;
 	}
@@ -872,7 +881,7 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Unknown(1)\n" );
 		#endif
-		returnNode = new TiXmlUnknown();
+		returnNode = new( arena ) TiXmlUnknown();
 	}
 	else if (    IsAlpha( *(p+1), encoding )
 			  || *(p+1) == '_' )
@@ -880,20 +889,21 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Element\n" );
 		#endif
-		returnNode = new TiXmlElement( "" );
+		returnNode = new( arena ) TiXmlElement( "" );
 	}
 	else
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Unknown(2)\n" );
 		#endif
-		returnNode = new TiXmlUnknown();
+		returnNode = new( arena ) TiXmlUnknown();
 	}
 
 	if ( returnNode )
 	{
 		// Set the parent, so it can report errors
 		returnNode->parent = this;
+		returnNode->inArena = arena != 0;
 	}
 	return returnNode;
 }
@@ -1074,6 +1084,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 		if ( document )	document->SetError( TIXML_ERROR_FAILED_TO_READ_ELEMENT_NAME, pErr, data, encoding );
 		return 0;
 	}
+	if ( document ) document->Intern( &value );
 
     TIXML_STRING endTag ("</");
 	endTag += value;
@@ -1139,11 +1150,13 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 		else
 		{
 			// Try to read an attribute:
-			TiXmlAttribute* attrib = new TiXmlAttribute();
+			TiXmlArena* arena = document ? &document->arena : 0;
+			TiXmlAttribute* attrib = new( arena ) TiXmlAttribute();
 			if ( !attrib )
 			{
 				return 0;
 			}
+			attrib->inArena = arena != 0;
 
 			attrib->SetDocument( document );
 			pErr = p;
@@ -1152,7 +1165,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			if ( !p || !*p )
 			{
 				if ( document ) document->SetError( TIXML_ERROR_PARSING_ELEMENT, pErr, data, encoding );
-				delete attrib;
+				Destroy( attrib );
 				return 0;
 			}
 
@@ -1165,7 +1178,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 			if ( node )
 			{
 				if ( document ) document->SetError( TIXML_ERROR_PARSING_ELEMENT, pErr, data, encoding );
-				delete attrib;
+				Destroy( attrib );
 				return 0;
 			}
 
@@ -1189,12 +1202,14 @@ const char* TiXmlElement::ReadValue( const char* p, TiXmlParsingData* data, TiXm
 		if ( *p != '<' )
 		{
 			// Take what we have, make a text element.
-			TiXmlText* textNode = new TiXmlText( "" );
+			TiXmlArena* arena = document ? &document->arena : 0;
+			TiXmlText* textNode = new( arena ) TiXmlText( "" );
 
 			if ( !textNode )
 			{
 			    return 0;
 			}
+			textNode->inArena = arena != 0;
 
 			if ( TiXmlBase::IsWhiteSpaceCondensed() )
 			{
@@ -1208,9 +1223,12 @@ const char* TiXmlElement::ReadValue( const char* p, TiXmlParsingData* data, TiXm
 			}
 
 			if ( !textNode->Blank() )
+			{
+				if ( document ) document->Intern( &textNode->value );
 				LinkEndChild( textNode );
+			}
 			else
-				delete textNode;
+				Destroy( textNode );
 		} 
 		else 
 		{
@@ -1292,8 +1310,7 @@ const char* TiXmlUnknown::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 
 	while ( p && *p && *p != '>' )
 	{
-		value += *p;
-		++p;
+		p = AppendNormalized( p, &value );
 	}
 
 	if ( !p )
@@ -1379,8 +1396,7 @@ const char* TiXmlComment::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 	// Keep all the white space.
 	while (	p && *p && !StringEqual( p, endTag, false, encoding ) )
 	{
-		value.append( p, 1 );
-		++p;
+		p = AppendNormalized( p, &value );
 	}
 	if ( p && *p ) 
 		p += strlen( endTag );
@@ -1459,6 +1475,11 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 			++p;
 		}
 	}
+	if ( document )
+	{
+		document->Intern( &name );
+		document->Intern( &value );
+	}
 	return p;
 }
 
@@ -1525,8 +1546,7 @@ const char* TiXmlText::Parse( const char* p, TiXmlParsingData* data, TiXmlEncodi
 				&& !StringEqual( p, endTag, false, encoding )
 			  )
 		{
-			value += *p;
-			++p;
+			p = AppendNormalized( p, &value );
 		}
 
 		TIXML_STRING dummy; 
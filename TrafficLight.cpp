@@ -8,18 +8,30 @@
 #include "DesignByContract.h"
 
 TrafficLight::TrafficLight(double position, double startOffset) : startOffset(startOffset), position(position),
+                                                                  greenDuration(CONST::GREEN_DURATION),
+                                                                  orangeDuration(CONST::ORANGE_DURATION),
+                                                                  redDuration(CONST::RED_DURATION), signalId(-1),
                                                                   _initCheck(this) {
     REQUIRE(position >= 0, "Huidige positie moet op de weg liggen");
     REQUIRE(startOffset >= 0, "De offset mag niet kleiner zijn dan 0");
 }
 
+TrafficLight::TrafficLight(double position, double startOffset, double greenDuration, double orangeDuration,
+                           double redDuration) : startOffset(startOffset), position(position),
+                                                 greenDuration(greenDuration), orangeDuration(orangeDuration),
+                                                 redDuration(redDuration), signalId(-1), _initCheck(this) {
+    REQUIRE(position >= 0, "Huidige positie moet op de weg liggen");
+    REQUIRE(startOffset >= 0, "De offset mag niet kleiner zijn dan 0");
+    REQUIRE(greenDuration > 0 and orangeDuration >= 0 and redDuration > 0, "Ongeldige duur van een kleur");
+    REQUIRE(greenDuration + orangeDuration + redDuration >= 1, "Een cyclus moet minstens 1 lang zijn");
+}
+
 TrafficLightColor TrafficLight::getColor(double time) {
     REQUIRE(properlyInit(), "Het verkeerslicht moet deftig geinitialiseerd zijn");
-    double cycletime = std::fmod((time + startOffset),
-                                 (CONST::GREEN_DURATION + CONST::ORANGE_DURATION + CONST::RED_DURATION));
-    if (cycletime < CONST::GREEN_DURATION) {
+    double cycletime = std::fmod((time + startOffset), (greenDuration + orangeDuration + redDuration));
+    if (cycletime < greenDuration) {
         return green;
-    } else if (cycletime < CONST::ORANGE_DURATION + CONST::GREEN_DURATION) {
+    } else if (cycletime < orangeDuration + greenDuration) {
         return orange;
     } else {
         return red;
@@ -30,13 +42,40 @@ double TrafficLight::getPosition() const {
     return position;
 }
 
+double TrafficLight::getStartOffset() const {
+    return startOffset;
+}
+
+double TrafficLight::getGreenDuration() const {
+    return greenDuration;
+}
+
+double TrafficLight::getOrangeDuration() const {
+    return orangeDuration;
+}
+
+double TrafficLight::getRedDuration() const {
+    return redDuration;
+}
+
+int TrafficLight::getSignalId() const {
+    return signalId;
+}
+
+void TrafficLight::setSignalId(int newSignalId) {
+    signalId = newSignalId;
+}
+
 bool TrafficLight::properlyInit() {
     return _initCheck == this;
 }
 
 char TrafficLight::getColorChar(double time) {
     REQUIRE(properlyInit(), "Het verkeerslicht moet deftig geinitialiseerd zijn");
-    TrafficLightColor trafficLightColor = getColor(time);
+    return getColorChar(getColor(time));
+}
+
+char TrafficLight::getColorChar(TrafficLightColor trafficLightColor) {
     if (trafficLightColor == red) {
         return '|';
     } else if (trafficLightColor == orange) {
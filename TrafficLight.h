@@ -30,6 +30,24 @@ public:
      */
     TrafficLight(double position, double startOffset);
 
+    /**
+     * Constructor for a trafficlight with its own cycle
+     *
+     * @param position of the trafficlight on the road
+     * @param startoffset is the time of when it should count to see what color it is next (0 is always Green)
+     * @param greenDuration the time the light stays green in every cycle
+     * @param orangeDuration the time the light stays orange in every cycle
+     * @param redDuration the time the light stays red in every cycle
+     *
+     * @pre
+     *  REQUIRE(position >= 0, "Huidige positie moet op de weg liggen");
+     *  REQUIRE(startoffset >= 0, "De offset mag niet kleiner zijn dan 0");
+     *  REQUIRE(greenDuration > 0 and orangeDuration >= 0 and redDuration > 0, "Ongeldige duur van een kleur");
+     *  REQUIRE(greenDuration + orangeDuration + redDuration >= 1, "Een cyclus moet minstens 1 lang zijn");
+     */
+    TrafficLight(double position, double startOffset, double greenDuration, double orangeDuration,
+                 double redDuration);
+
     /**
      * Get the color of a trafficLight
      *
@@ -50,6 +68,38 @@ public:
      */
     double getPosition() const;
 
+    /**
+     * @return The time added to the current time before calculating the color
+     */
+    double getStartOffset() const;
+
+    /**
+     * @return The time the light stays green in every cycle
+     */
+    double getGreenDuration() const;
+
+    /**
+     * @return The time the light stays orange in every cycle
+     */
+    double getOrangeDuration() const;
+
+    /**
+     * @return The time the light stays red in every cycle
+     */
+    double getRedDuration() const;
+
+    /**
+     * @return The id of the light in the signal state table of its network, -1 when it isn't in a table
+     */
+    int getSignalId() const;
+
+    /**
+     * Set the id of the light in the signal state table of its network
+     *
+     * @param newSignalId The place of the light in the table, -1 to remove it
+     */
+    void setSignalId(int newSignalId);
+
     bool properlyInit();
 
     /**
@@ -64,9 +114,22 @@ public:
      */
     char getColorChar(double time);
 
+    /**
+     * Get the char of a color of a trafficLight
+     *
+     * @param color the color
+     *
+     * @return The char used for this color in the graphic impression
+     */
+    static char getColorChar(TrafficLightColor color);
+
 private:
     double startOffset;
     double position;     /**< The position on the road of where the trafficLight is */
+    double greenDuration;
+    double orangeDuration;
+    double redDuration;
+    int signalId;
     TrafficLight *_initCheck;
 };
 
@@ -0,0 +1,180 @@
+/**
+ * @file TrajectoryExporter.cpp
+ * @brief This file will contain the definitions of the functions in TrajectoryExporter.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include "TrajectoryExporter.h"
+#include "BinaryIO.h"
+#include "DesignByContract.h"
+#include "Road.h"
+#include "Vehicle.h"
+
+const char TrajectoryExporter::MAGIC[4] = {'A', 'T', 'R', 'J'};
+const uint8_t TrajectoryExporter::FORMAT_VERSION = 2;
+const uint8_t TrajectoryExporter::HEADER_BLOCK = 'H';
+const uint8_t TrajectoryExporter::FRAME_BLOCK = 'F';
+
+TrajectoryExporter::TrajectoryExporter() : magicWritten(false), frameIteration(0) {}
+
+void TrajectoryExporter::documentStart(std::ostream &onStream) {
+    REQUIRE(properlyInitialized(), "The exporter must be properly initialized");
+    NetworkExporter::documentStart(onStream);
+    magicWritten = false;
+    roads.clear();
+    roadRevisions.clear();
+    roadIndices.clear();
+    vehicleTypes.clear();
+    vehicleSlots.clear();
+    positionBits.clear();
+    speedBits.clear();
+    present.clear();
+    ENSURE(documentStarted(), "The document is started");
+}
+
+void TrajectoryExporter::sectionStart(std::ostream &onStream, const std::string sectionTitle) {
+    // De titel wordt niet geschreven, het frame bevat de iteratie zelf
+    frameRoads.clear();
+    frameVehicles.clear();
+}
+
+void TrajectoryExporter::roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork) {
+    frameIteration = roadNetwork.getIteration();
+}
+
+void TrajectoryExporter::roadAdd(std::ostream &onStream, const Road *road, RoadNetwork &roadNetwork) {
+    frameRoads.push_back(road);
+}
+
+void TrajectoryExporter::vehicleAdd(std::ostream &onStream, const Vehicle *vehicle) {
+    frameVehicles.push_back(vehicle);
+}
+
+void TrajectoryExporter::sectionEnd(std::ostream &onStream) {
+    if (!magicWritten) {
+        onStream.write(MAGIC, sizeof(MAGIC));
+        BinaryIO::writeUInt8(onStream, FORMAT_VERSION);
+        magicWritten = true;
+        writeHeader(onStream);
+    } else if (headerChanged()) {
+        writeHeader(onStream);
+    }
+    writeFrame(onStream);
+}
+
+void TrajectoryExporter::roadNetworkEnd(std::ostream &onStream) {}
+
+bool TrajectoryExporter::headerChanged() const {
+    if (frameRoads.size() != roads.size()) {
+        return true;
+    }
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        if (frameRoads[i] != roads[i] or roads[i]->getRevision() != roadRevisions[i]) {
+            return true;
+        }
+    }
+
+    // De voertuigen moeten in de tabel zitten, in dezelfde volgorde, en mogen het netwerk nog niet verlaten hebben
+    int previousSlot = -1;
+    for (unsigned int i = 0; i < frameVehicles.size(); ++i) {
+        std::tr1::unordered_map<std::string, int>::const_iterator slot =
+                vehicleSlots.find(frameVehicles[i]->getLicensePlate());
+        if (slot == vehicleSlots.end() or slot->second <= previousSlot or !present[slot->second] or
+            vehicleTypes[slot->second] != frameVehicles[i]->getType()) {
+            return true;
+        }
+        previousSlot = slot->second;
+    }
+    return false;
+}
+
+void TrajectoryExporter::writeHeader(std::ostream &onStream) {
+    roads = frameRoads;
+    roadRevisions.clear();
+    roadIndices.clear();
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        roadRevisions.push_back(roads[i]->getRevision());
+        roadIndices[roads[i]] = i;
+    }
+
+    BinaryIO::writeUInt8(onStream, HEADER_BLOCK);
+    BinaryIO::writeUInt32(onStream, roads.size());
+    for (unsigned int i = 0; i < roads.size(); ++i) {
+        const Road *road = roads[i];
+        BinaryIO::writeString(onStream, road->getName());
+        BinaryIO::writeInt32(onStream, road->getSpeedLimit());
+        BinaryIO::writeDouble(onStream, road->getLength());
+        std::tr1::unordered_map<const Road *, int32_t>::const_iterator intersection =
+                roadIndices.find(road->getIntersection());
+        BinaryIO::writeInt32(onStream, intersection == roadIndices.end() ? -1 : intersection->second);
+
+        const std::map<double, int> &zones = road->getZones();
+        BinaryIO::writeUInt32(onStream, zones.size());
+        for (std::map<double, int>::const_iterator zone = zones.begin(); zone != zones.end(); ++zone) {
+            BinaryIO::writeDouble(onStream, zone->first);
+            BinaryIO::writeInt32(onStream, zone->second);
+        }
+
+        const std::set<double> &busStops = road->getBusStops();
+        BinaryIO::writeUInt32(onStream, busStops.size());
+        for (std::set<double>::const_iterator busStop = busStops.begin(); busStop != busStops.end(); ++busStop) {
+            BinaryIO::writeDouble(onStream, *busStop);
+        }
+
+        const std::map<double, TrafficLight *> &trafficLights = road->getTrafficLights();
+        BinaryIO::writeUInt32(onStream, trafficLights.size());
+        for (std::map<double, TrafficLight *>::const_iterator trafficLight = trafficLights.begin();
+             trafficLight != trafficLights.end(); ++trafficLight) {
+            BinaryIO::writeDouble(onStream, trafficLight->first);
+            BinaryIO::writeDouble(onStream, trafficLight->second->getStartOffset());
+            BinaryIO::writeDouble(onStream, trafficLight->second->getGreenDuration());
+            BinaryIO::writeDouble(onStream, trafficLight->second->getOrangeDuration());
+            BinaryIO::writeDouble(onStream, trafficLight->second->getRedDuration());
+        }
+    }
+
+    vehicleTypes.clear();
+    vehicleSlots.clear();
+    BinaryIO::writeUInt32(onStream, frameVehicles.size());
+    for (unsigned int i = 0; i < frameVehicles.size(); ++i) {
+        vehicleTypes.push_back(frameVehicles[i]->getType());
+        vehicleSlots[frameVehicles[i]->getLicensePlate()] = i;
+        BinaryIO::writeString(onStream, frameVehicles[i]->getType());
+        BinaryIO::writeString(onStream, frameVehicles[i]->getLicensePlate());
+    }
+    positionBits.assign(frameVehicles.size(), 0);
+    speedBits.assign(frameVehicles.size(), 0);
+    present.assign(frameVehicles.size(), true);
+}
+
+void TrajectoryExporter::writeFrame(std::ostream &onStream) {
+    std::vector<const Vehicle *> slots(vehicleTypes.size(), static_cast<const Vehicle *>(NULL));
+    for (unsigned int i = 0; i < frameVehicles.size(); ++i) {
+        slots[vehicleSlots.find(frameVehicles[i]->getLicensePlate())->second] = frameVehicles[i];
+    }
+
+    BinaryIO::writeUInt8(onStream, FRAME_BLOCK);
+    BinaryIO::writeInt32(onStream, frameIteration);
+    for (unsigned int slot = 0; slot < slots.size(); ++slot) {
+        const Vehicle *vehicle = slots[slot];
+        int32_t road = -1;
+        uint64_t position = positionBits[slot];
+        uint64_t speed = speedBits[slot];
+        if (vehicle != NULL) {
+            std::tr1::unordered_map<const Road *, int32_t>::const_iterator index =
+                    roadIndices.find(vehicle->getCurrentRoad());
+            road = index == roadIndices.end() ? -1 : index->second;
+            position = BinaryIO::doubleToBits(vehicle->getCurrentPosition());
+            speed = BinaryIO::doubleToBits(vehicle->getCurrentSpeed());
+        }
+        BinaryIO::writeVarUInt(onStream, road + 1);
+        BinaryIO::writeTrimmedUInt64(onStream, position ^ positionBits[slot]);
+        BinaryIO::writeTrimmedUInt64(onStream, speed ^ speedBits[slot]);
+        positionBits[slot] = position;
+        speedBits[slot] = speed;
+        present[slot] = road != -1;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file TrajectoryExporter.h
+ * @brief This header file will contain the TrajectoryExporter class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_TRAJECTORYEXPORTER_H
+#define ANTROPSE_TRAJECTORYEXPORTER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+#include "NetworkExporter.h"
+
+/**
+ * An exporter that writes a compact binary trajectory instead of text
+ *
+ * The stream starts with MAGIC and FORMAT_VERSION, followed by blocks. A header block (HEADER_BLOCK) contains the
+ * road table (name, speed limit, length, intersection, zones, bus stops and traffic lights of every road) and the
+ * vehicle table (type and license plate of every vehicle). Every exportOn writes a frame block (FRAME_BLOCK) with the
+ * iteration (RoadNetwork::getIteration) and a record for every vehicle in the table: the index of its road plus one
+ * (0 when it isn't in the network anymore) as a BinaryIO::writeVarUInt, and its position and speed. The position and
+ * speed are delta-encoded: the bits of the double are XOR'ed with the bits of the previous frame, so they are restored
+ * exactly, and the zero bytes at both ends of the delta are left out (BinaryIO::writeTrimmedUInt64). A value that
+ * didn't change takes one byte, e.g. the speed of a car driving at the speed limit, so a frame of such cars takes 3 to
+ * 11 bytes per vehicle instead of 20.
+ *
+ * A new header is written before the first frame, and before every frame in which the roads have changed, or a vehicle
+ * isn't in the table or comes back after it has left the network. So the vehicles in a frame are always the vehicles
+ * of the header that haven't left yet, in the order of the network. The deltas start again from zero after a header.
+ * See TrajectoryReader to read the trajectory and turn it back into the text of another exporter.
+ */
+class TrajectoryExporter : public NetworkExporter {
+public:
+    TrajectoryExporter();
+
+    /**
+     * Initialize the exporter for writing a new trajectory, the next export starts with a header
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The exporter must be properly initialized");
+     *
+     * @post
+     * ENSURE(documentStarted(), "The document is started");
+     */
+    virtual void documentStart(std::ostream &onStream);
+
+    static const char MAGIC[4];
+    static const uint8_t FORMAT_VERSION;
+    static const uint8_t HEADER_BLOCK;
+    static const uint8_t FRAME_BLOCK;
+
+protected:
+    virtual void sectionStart(std::ostream &onStream, const std::string sectionTitle);
+
+    virtual void roadNetworkStart(std::ostream &onStream, RoadNetwork &roadNetwork);
+
+    virtual void roadAdd(std::ostream &onStream, const Road *road, RoadNetwork &roadNetwork);
+
+    virtual void vehicleAdd(std::ostream &onStream, const Vehicle *vehicle);
+
+    virtual void sectionEnd(std::ostream &onStream);
+
+    virtual void roadNetworkEnd(std::ostream &onStream);
+
+private:
+    bool headerChanged() const;
+
+    void writeHeader(std::ostream &onStream);
+
+    void writeFrame(std::ostream &onStream);
+
+    bool magicWritten;
+    int frameIteration; /**< The iteration of the export that is being written */
+    std::vector<const Road *> frameRoads; /**< The roads of the export that is being written */
+    std::vector<const Vehicle *> frameVehicles; /**< The vehicles of the export that is being written */
+
+    std::vector<const Road *> roads; /**< The road table of the last header */
+    std::vector<unsigned long> roadRevisions; /**< Road::getRevision of every road when the last header was written */
+    std::tr1::unordered_map<const Road *, int32_t> roadIndices;
+    std::vector<std::string> vehicleTypes; /**< The vehicle table of the last header */
+    std::tr1::unordered_map<std::string, int> vehicleSlots; /**< The place in the table of every license plate */
+    std::vector<uint64_t> positionBits; /**< The position of every vehicle in the last frame, to encode the deltas */
+    std::vector<uint64_t> speedBits; /**< The speed of every vehicle in the last frame, to encode the deltas */
+    std::vector<bool> present; /**< Whether every vehicle was in the network in the last frame */
+};
+
+
+#endif //ANTROPSE_TRAJECTORYEXPORTER_H
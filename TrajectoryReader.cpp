@@ -0,0 +1,246 @@
+/**
+ * @file TrajectoryReader.cpp
+ * @brief This file will contain the definitions of the functions in TrajectoryReader.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include "TrajectoryReader.h"
+#include "TrajectoryExporter.h"
+#include "BinaryIO.h"
+#include "DesignByContract.h"
+#include "RoadNetwork.h"
+#include "Road.h"
+#include "Vehicle.h"
+
+TrajectoryReader::TrajectoryReader(std::istream &inStream) : inStream(inStream), network(NULL), started(false),
+                                                             damaged(false), framesRead(0) {
+    _initCheck = this;
+    ENSURE(properlyInitialized(), "The reader must be properly initialized");
+}
+
+TrajectoryReader::~TrajectoryReader() {
+    // De wegen en voertuigen komen uit de pools van het netwerk en verdwijnen samen met het netwerk
+    delete network;
+}
+
+bool TrajectoryReader::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+bool TrajectoryReader::readFrame() {
+    REQUIRE(properlyInitialized(), "The reader must be properly initialized");
+    if (damaged or (!started and !readStart())) {
+        return false;
+    }
+
+    uint8_t block;
+    while (BinaryIO::readUInt8(inStream, block)) {
+        if (block == TrajectoryExporter::HEADER_BLOCK) {
+            if (!readHeader()) {
+                damaged = true;
+                return false;
+            }
+        } else if (block == TrajectoryExporter::FRAME_BLOCK and network != NULL) {
+            if (!readVehicleRecords()) {
+                damaged = true;
+                return false;
+            }
+            framesRead++;
+            return true;
+        } else {
+            damaged = true;
+            return false;
+        }
+    }
+    return false;
+}
+
+RoadNetwork &TrajectoryReader::getNetwork() {
+    REQUIRE(properlyInitialized(), "The reader must be properly initialized");
+    REQUIRE(getNrOfFramesRead() > 0, "Er moet al een frame gelezen zijn");
+    return *network;
+}
+
+int TrajectoryReader::getNrOfFramesRead() const {
+    return framesRead;
+}
+
+bool TrajectoryReader::isDamaged() const {
+    return damaged;
+}
+
+int TrajectoryReader::convert(std::istream &inStream, std::ostream &outStream, NetworkExporter &exporter) {
+    REQUIRE(exporter.documentStarted(), "Het document van de exporter moet gestart zijn");
+    TrajectoryReader reader(inStream);
+    while (reader.readFrame()) {
+        exporter.exportOn(outStream, reader.getNetwork());
+    }
+    return reader.getNrOfFramesRead();
+}
+
+bool TrajectoryReader::readStart() {
+    char magic[sizeof(TrajectoryExporter::MAGIC)];
+    uint8_t version;
+    if (!inStream.read(magic, sizeof(magic)) or
+        std::memcmp(magic, TrajectoryExporter::MAGIC, sizeof(magic)) != 0 or
+        !BinaryIO::readUInt8(inStream, version) or version != TrajectoryExporter::FORMAT_VERSION) {
+        damaged = true;
+        return false;
+    }
+    started = true;
+    return true;
+}
+
+bool TrajectoryReader::readHeader() {
+    delete network;
+    network = new RoadNetwork();
+    roads.clear();
+    vehicles.clear();
+
+    uint32_t nrOfRoads;
+    if (!BinaryIO::readUInt32(inStream, nrOfRoads)) {
+        return false;
+    }
+    std::vector<int32_t> intersections;
+    for (uint32_t i = 0; i < nrOfRoads; ++i) {
+        std::string name;
+        int32_t speedLimit;
+        double length;
+        int32_t intersection;
+        if (!BinaryIO::readString(inStream, name) or !BinaryIO::readInt32(inStream, speedLimit) or
+            !BinaryIO::readDouble(inStream, length) or !BinaryIO::readInt32(inStream, intersection)) {
+            return false;
+        }
+        Road *road = network->createRoad();
+        if (!road->setName(name) or !road->setSpeedLimit(speedLimit) or !road->setLength(length) or
+            intersection < -1 or intersection >= (int32_t) nrOfRoads) {
+            return false;
+        }
+        roads.push_back(road);
+        intersections.push_back(intersection);
+
+        uint32_t nrOfZones;
+        if (!BinaryIO::readUInt32(inStream, nrOfZones)) {
+            return false;
+        }
+        // De zones worden pas na de lichten toegevoegd, een licht kan niet op het begin van een zone gezet worden
+        std::vector<std::pair<double, int32_t> > zones;
+        for (uint32_t zone = 0; zone < nrOfZones; ++zone) {
+            double position;
+            int32_t zoneSpeedLimit;
+            if (!BinaryIO::readDouble(inStream, position) or !BinaryIO::readInt32(inStream, zoneSpeedLimit)) {
+                return false;
+            }
+            zones.push_back(std::make_pair(position, zoneSpeedLimit));
+        }
+
+        uint32_t nrOfBusStops;
+        if (!BinaryIO::readUInt32(inStream, nrOfBusStops)) {
+            return false;
+        }
+        for (uint32_t busStop = 0; busStop < nrOfBusStops; ++busStop) {
+            double position;
+            if (!BinaryIO::readDouble(inStream, position) or !road->addBusStop((int) position)) {
+                return false;
+            }
+        }
+
+        uint32_t nrOfTrafficLights;
+        if (!BinaryIO::readUInt32(inStream, nrOfTrafficLights)) {
+            return false;
+        }
+        for (uint32_t trafficLight = 0; trafficLight < nrOfTrafficLights; ++trafficLight) {
+            double position, offset, greenDuration, orangeDuration, redDuration;
+            if (!BinaryIO::readDouble(inStream, position) or !BinaryIO::readDouble(inStream, offset) or
+                !BinaryIO::readDouble(inStream, greenDuration) or !BinaryIO::readDouble(inStream, orangeDuration) or
+                !BinaryIO::readDouble(inStream, redDuration) or
+                !road->addTrafficLight(position, (int) offset, greenDuration, orangeDuration, redDuration)) {
+                return false;
+            }
+        }
+
+        for (unsigned int zone = 0; zone < zones.size(); ++zone) {
+            if (!road->addZone(zones[zone].first, zones[zone].second)) {
+                return false;
+            }
+        }
+    }
+
+    // De wegen worden in de volgorde van de export toegevoegd, zodat het netwerk ze in dezelfde volgorde zet
+    for (uint32_t i = 0; i < nrOfRoads; ++i) {
+        if (intersections[i] != -1) {
+            roads[i]->setIntersection(roads[intersections[i]]);
+        }
+    }
+    for (uint32_t i = 0; i < nrOfRoads; ++i) {
+        if (!network->addRoad(roads[i])) {
+            return false;
+        }
+    }
+
+    uint32_t nrOfVehicles;
+    if (!BinaryIO::readUInt32(inStream, nrOfVehicles)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < nrOfVehicles; ++i) {
+        std::string type;
+        std::string licensePlate;
+        if (!BinaryIO::readString(inStream, type) or !BinaryIO::readString(inStream, licensePlate)) {
+            return false;
+        }
+        Vehicle *vehicle = network->createVehicle(type);
+        if (vehicle == NULL or !vehicle->setLicensePlate(licensePlate)) {
+            return false;
+        }
+        vehicles.push_back(vehicle);
+    }
+    inNetwork.assign(nrOfVehicles, false);
+    positionBits.assign(nrOfVehicles, 0);
+    speedBits.assign(nrOfVehicles, 0);
+    return true;
+}
+
+bool TrajectoryReader::readVehicleRecords() {
+    int32_t iteration;
+    if (!BinaryIO::readInt32(inStream, iteration) or iteration < 0) {
+        return false;
+    }
+    network->setIteration(iteration);
+
+    for (unsigned int slot = 0; slot < vehicles.size(); ++slot) {
+        uint64_t roadNumber;
+        uint64_t positionDelta;
+        uint64_t speedDelta;
+        if (!BinaryIO::readVarUInt(inStream, roadNumber) or !BinaryIO::readTrimmedUInt64(inStream, positionDelta) or
+            !BinaryIO::readTrimmedUInt64(inStream, speedDelta) or roadNumber > roads.size()) {
+            return false;
+        }
+        int32_t road = (int32_t) roadNumber - 1;
+        positionBits[slot] ^= positionDelta;
+        speedBits[slot] ^= speedDelta;
+
+        Vehicle *vehicle = vehicles[slot];
+        if (road == -1) {
+            // Het voertuig heeft het netwerk verlaten, het kan niet meer terugkomen zonder nieuwe header
+            if (inNetwork[slot] and vehicle != NULL) {
+                network->removeVehicle(vehicle->getLicensePlate());
+                vehicles[slot] = NULL;
+            }
+            continue;
+        }
+        double position = BinaryIO::bitsToDouble(positionBits[slot]);
+        if (vehicle == NULL or !(position >= 0 and position <= roads[road]->getLength())) {
+            return false;
+        }
+        vehicle->restoreState(roads[road], position, BinaryIO::bitsToDouble(speedBits[slot]));
+        if (!inNetwork[slot]) {
+            network->restoreCar(vehicle);
+            inNetwork[slot] = true;
+        }
+    }
+    return true;
+}
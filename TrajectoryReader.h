@@ -0,0 +1,115 @@
+/**
+ * @file TrajectoryReader.h
+ * @brief This header file will contain the TrajectoryReader class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_TRAJECTORYREADER_H
+#define ANTROPSE_TRAJECTORYREADER_H
+
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+class RoadNetwork;
+class NetworkExporter;
+class Road;
+class Vehicle;
+
+/**
+ * Reads a trajectory written by the TrajectoryExporter, frame by frame
+ *
+ * The reader rebuilds the network of every header with its own roads and vehicles. After every frame, the vehicles
+ * that are still in the network are on the road and at the position and speed of that frame, and the network is in
+ * the iteration of that frame. So every exporter can write the same text as when it would have exported the original
+ * network (see convert). The exits of a network aren't in the trajectory.
+ */
+class TrajectoryReader {
+public:
+    /**
+     * @param inStream The stream with the trajectory, opened in binary mode
+     *
+     * @post
+     * ENSURE(properlyInitialized(), "The reader must be properly initialized");
+     */
+    explicit TrajectoryReader(std::istream &inStream);
+
+    ~TrajectoryReader();
+
+    bool properlyInitialized() const;
+
+    /**
+     * Read the next frame, and the header before it when there is one
+     *
+     * @return true when a frame has been read, false at the end of the trajectory or when it is damaged
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The reader must be properly initialized");
+     */
+    bool readFrame();
+
+    /**
+     * @return The network in the state of the last frame
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The reader must be properly initialized");
+     * REQUIRE(getNrOfFramesRead() > 0, "Er moet al een frame gelezen zijn");
+     */
+    RoadNetwork &getNetwork();
+
+    /**
+     * @return The number of frames read until now
+     */
+    int getNrOfFramesRead() const;
+
+    /**
+     * @return true when the stream isn't a trajectory, or ends in the middle of a block
+     */
+    bool isDamaged() const;
+
+    /**
+     * Export every frame of a trajectory with another exporter, e.g. to turn it back into the text of the
+     * NetworkExporter or the GraphicImpressionExporter
+     *
+     * @param inStream The stream with the trajectory
+     * @param outStream The stream to export the frames on
+     * @param exporter The exporter, with a started document
+     *
+     * @return The number of frames exported
+     *
+     * @pre
+     * REQUIRE(exporter.documentStarted(), "Het document van de exporter moet gestart zijn");
+     */
+    static int convert(std::istream &inStream, std::ostream &outStream, NetworkExporter &exporter);
+
+private:
+    bool readStart();
+
+    bool readHeader();
+
+    bool readVehicleRecords();
+
+    std::istream &inStream;
+    RoadNetwork *network; /**< The network of the last header, NULL before the first header */
+    std::vector<Road *> roads; /**< The road table of the last header */
+    std::vector<Vehicle *> vehicles; /**< The vehicle table of the last header, NULL when it has left the network */
+    std::vector<bool> inNetwork; /**< Whether every vehicle of the table has been added to the network */
+    std::vector<uint64_t> positionBits; /**< The position of every vehicle in the last frame, to decode the deltas */
+    std::vector<uint64_t> speedBits; /**< The speed of every vehicle in the last frame, to decode the deltas */
+    bool started; /**< Whether the magic and the version have been read */
+    bool damaged;
+    int framesRead;
+    TrajectoryReader *_initCheck;
+
+    // De lezer is eigenaar van het netwerk, kopieren zou het twee keer verwijderen
+    TrajectoryReader(const TrajectoryReader &);
+
+    TrajectoryReader &operator=(const TrajectoryReader &);
+};
+
+
+#endif //ANTROPSE_TRAJECTORYREADER_H
@@ -21,7 +21,9 @@
 Vehicle::Vehicle(const std::string &license_plate, Road *current_road, double current_position, double current_speed)
         : licensePlate(license_plate), currentRoad(current_road),
           currentPosition(current_position), currentSpeed(current_speed), currentSpeedup(0),
-          slowingDownForPreviousCar(false), slowingDownForTrafficLight(false), slowingDownForVehicleSpecific(false) {
+          slowingDownForPreviousCar(false), slowingDownForTrafficLight(false), slowingDownForVehicleSpecific(false),
+          stateIndex(0), vehicleAhead(NULL), vehicleBehind(NULL), currentZone(0), currentFeature(0),
+          stepTime(CONST::SECONDS_PER_ITERATION), largeStepIterations(0), stateLane(NULL) {
     _initCheck = this;
     ENSURE(properlyInitialized(), "The vehicle has been properly initialized");
 }
@@ -39,12 +41,12 @@ Road *Vehicle::getCurrentRoad() const {
 
 double Vehicle::getCurrentPosition() const {
     REQUIRE(properlyInitialized(), "Het voertuig moet deftig geinitialiseerd zijn");
-    return currentPosition;
+    return statePosition();
 }
 
 double Vehicle::getCurrentSpeed() const {
     REQUIRE(properlyInitialized(), "Het voertuig moet deftig geinitialiseerd zijn");
-    return currentSpeed;
+    return stateSpeed();
 }
 
 bool Vehicle::setLicensePlate(const std::string &newLicensePlate) {
@@ -58,12 +60,20 @@ bool Vehicle::setLicensePlate(const std::string &newLicensePlate) {
 }
 
 bool Vehicle::setCurrentRoad(Road *newCurrentRoad) {
-    if (newCurrentRoad == NULL or currentSpeed > newCurrentRoad->getSpeedLimit(currentPosition)) {
+    if (newCurrentRoad == NULL or stateSpeed() > newCurrentRoad->getSpeedLimit(statePosition())) {
         return false;
     }
-    REQUIRE(currentSpeed <= newCurrentRoad->getSpeedLimit(currentPosition),
+    REQUIRE(stateSpeed() <= newCurrentRoad->getSpeedLimit(statePosition()),
             "De huidige nelheid van je voertuig moet kleiner zijn dan de max toegelaten snelheid op de weg");
-    Vehicle::currentRoad = newCurrentRoad;
+    if (currentRoad != NULL and currentRoad->hasVehicle(this)) {
+        currentRoad->exitVehicle(this);
+        Vehicle::currentRoad = newCurrentRoad;
+        currentRoad->enterVehicle(this);
+    } else {
+        Vehicle::currentRoad = newCurrentRoad;
+    }
+    updateStateLane();
+    largeStepIterations = 0;
     ENSURE(getCurrentRoad() == newCurrentRoad, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
@@ -78,7 +88,11 @@ bool Vehicle::setCurrentPosition(int newCurrentPosition) {
     REQUIRE((currentRoad != NULL and newCurrentPosition <= currentRoad->getLength()) or
             currentRoad == NULL, "De positie valt buiten de weg");
 
-    Vehicle::currentPosition = newCurrentPosition;
+    setStatePosition(newCurrentPosition);
+    largeStepIterations = 0;
+    if (currentRoad != NULL and currentRoad->hasVehicle(this)) {
+        currentRoad->updateVehiclePosition(this);
+    }
     ENSURE(getCurrentPosition() == newCurrentPosition, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
@@ -86,16 +100,17 @@ bool Vehicle::setCurrentPosition(int newCurrentPosition) {
 bool Vehicle::setCurrentSpeed(double newCurrentSpeed) {
 
     if (!(newCurrentSpeed <= getMaxSpeed() and
-          ((currentRoad != NULL and newCurrentSpeed <= currentRoad->getSpeedLimit(currentPosition)) or
+          ((currentRoad != NULL and newCurrentSpeed <= getCurrentSpeedLimit()) or
            currentRoad == NULL) and newCurrentSpeed >= getMinSpeed() and newCurrentSpeed == (int) newCurrentSpeed)) {
         return false;
     }
     REQUIRE(newCurrentSpeed <= getMaxSpeed(), "Maximumsnelheid voor wagen overschreven");
-    REQUIRE((currentRoad != NULL and newCurrentSpeed <= currentRoad->getSpeedLimit(currentPosition)) or
+    REQUIRE((currentRoad != NULL and newCurrentSpeed <= getCurrentSpeedLimit()) or
             currentRoad == NULL, "Te snel rijden is verboden");
 
-    Vehicle::currentSpeed = newCurrentSpeed;
-    ENSURE(getCurrentSpeed() == currentSpeed, "Als je de waarde opvraagt, krijg je de nieuwe waarde");
+    setStateSpeed(newCurrentSpeed);
+    largeStepIterations = 0;
+    ENSURE(getCurrentSpeed() == stateSpeed(), "Als je de waarde opvraagt, krijg je de nieuwe waarde");
     return true;
 }
 
@@ -114,31 +129,172 @@ bool Vehicle::setCurrentSpeed(double newCurrentSpeed) {
 Vehicle::Vehicle() : licensePlate(""), currentRoad(NULL),
                      currentPosition(0), currentSpeed(0),
                      currentSpeedup(0), slowingDownForPreviousCar(false), slowingDownForTrafficLight(false),
-                     slowingDownForVehicleSpecific(false) {
+                     slowingDownForVehicleSpecific(false), stateIndex(0), vehicleAhead(NULL), vehicleBehind(NULL),
+                     currentZone(0), currentFeature(0), stepTime(CONST::SECONDS_PER_ITERATION),
+                     largeStepIterations(0), stateLane(NULL) {
     _initCheck = this;
     ENSURE(properlyInitialized(), "The vehicle has been properly initialized");
 }
 
 bool Vehicle::emptyConstructorParametersUpdated() {
     return (!licensePlate.empty() and currentRoad != NULL and
-            currentRoad->getSpeedLimit(currentPosition) >= currentSpeed);
+            getCurrentSpeedLimit() >= stateSpeed());
 }
 
 bool Vehicle::move(RoadNetwork *roadNetwork, std::ostream &errStream) {
-    REQUIRE(roadNetwork->checkPositionCars(), "position");
-    REQUIRE(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
+    REQUIRE_FULL(roadNetwork->checkPositionCars(), "position");
+    REQUIRE_FULL(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
     REQUIRE(roadNetwork->findCar(licensePlate) != NULL, "De wagen moet in het netwerk zitten");
 
-    double time = CONST::SECONDS_PER_ITERATION;
+    return move(roadNetwork, errStream, CONST::SECONDS_PER_ITERATION);
+}
 
+bool Vehicle::move(RoadNetwork *roadNetwork, std::ostream &errStream, double time) {
+    REQUIRE_FULL(roadNetwork->checkPositionCars(), "position");
+    REQUIRE_FULL(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
+    REQUIRE(time > 0, "Tijd moet positief zijn");
+    REQUIRE(roadNetwork->findCar(licensePlate) != NULL, "De wagen moet in het netwerk zitten");
+
+    stepTime = time;
+    largeStepIterations = 0;
     updateCurrentPosition(time);
     updateCurrentSpeed(time);
+    updateAfterMove(time, roadNetwork, errStream);
+
+//    std::cout << "Car " << licensePlate << " " << currentPosition << std::endl;
+    ENSURE_FULL(roadNetwork->checkPositionCars(), "position");
+    ENSURE_FULL(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
+    return true;
+}
+
+bool Vehicle::isNearInteraction(RoadNetwork *roadNetwork) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+
+    if (currentRoad == NULL) {
+        return false;
+    }
+
+    Vehicle *previousCar = roadNetwork->findPreviouscar(this);
+    if (previousCar != NULL and previousCar->getCurrentPosition() - previousCar->getLength() - statePosition() <
+                                2 * getIdealDistance(roadNetwork)) {
+        return true;
+    }
+
+    double horizon = statePosition() + CONST::METERS_BEFORE_SLOWING_DOWN +
+                     Convert::kmhToMs(stateSpeed()) * CONST::SECONDS_PER_ITERATION;
+    TrafficLight *nextTrafficLight = currentRoad->getNextTrafficLight(statePosition(), currentFeature);
+    if (nextTrafficLight != NULL and nextTrafficLight->getPosition() < horizon) {
+        return true;
+    }
+
+    double specificPosition = getNextSpecificPosition();
+    return specificPosition != -1 and specificPosition < horizon - CONST::METERS_BEFORE_SLOWING_DOWN;
+}
+
+bool Vehicle::move(RoadNetwork *roadNetwork, std::ostream &errStream, double newPosition, double newSpeed) {
+    REQUIRE_FULL(roadNetwork->checkPositionCars(), "position");
+    REQUIRE_FULL(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
+    REQUIRE(roadNetwork->findCar(licensePlate) != NULL, "De wagen moet in het netwerk zitten");
+    REQUIRE(newPosition >= statePosition(), "Een voertuig kan niet achteruit rijden");
+
+    stepTime = CONST::SECONDS_PER_ITERATION;
+    largeStepIterations = 0;
+    setMovedPosition(newPosition);
+    setStateSpeed(newSpeed);
+    updateAfterMove(CONST::SECONDS_PER_ITERATION, roadNetwork, errStream);
+
+    ENSURE_FULL(roadNetwork->checkPositionCars(), "position");
+    ENSURE_FULL(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
+    return true;
+}
+
+bool Vehicle::commitMove(RoadNetwork *roadNetwork, double newPosition, double newSpeed) {
+    REQUIRE(roadNetwork->findCar(licensePlate) != NULL, "De wagen moet in het netwerk zitten");
+    REQUIRE(newPosition >= statePosition(), "Een voertuig kan niet achteruit rijden");
+
+    stepTime = CONST::SECONDS_PER_ITERATION;
+    largeStepIterations = 0;
+    setMovedPosition(newPosition);
+    setStateSpeed(newSpeed);
+    changeRoads(roadNetwork);
+    return true;
+}
+
+bool Vehicle::restoreState(Road *road, double position, double speed) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    REQUIRE(road != NULL and position >= 0 and (position <= road->getLength() or road->getLength() == 0),
+            "De positie moet op de weg liggen");
+
+    bool inQueue = currentRoad != NULL and currentRoad->hasVehicle(this);
+    if (inQueue) {
+        currentRoad->exitVehicle(this);
+    }
+    currentRoad = road;
+    updateStateLane();
+    setStatePosition(position);
+    setStateSpeed(speed);
+    currentZone = 0;
+    currentFeature = 0;
+    largeStepIterations = 0;
+    if (inQueue) {
+        currentRoad->enterVehicle(this);
+    }
+
+    ENSURE(getCurrentRoad() == road and getCurrentPosition() == position and getCurrentSpeed() == speed,
+           "De toestand moet hersteld zijn");
+    return true;
+}
+
+VehicleState Vehicle::getState() const {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    VehicleState state;
+    state.position = statePosition();
+    state.speed = stateSpeed();
+    state.speedup = stateSpeedup();
+    state.slowingDownForPreviousCar = slowingDownForPreviousCar;
+    state.slowingDownForTrafficLight = slowingDownForTrafficLight;
+    state.slowingDownForVehicleSpecific = slowingDownForVehicleSpecific;
+    state.specificState = getSpecificState();
+    return state;
+}
+
+bool Vehicle::restoreState(Road *road, const VehicleState &state) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    REQUIRE(road != NULL and state.position >= 0 and
+            (state.position <= road->getLength() or road->getLength() == 0), "De positie moet op de weg liggen");
+
+    restoreState(road, state.position, state.speed);
+    setStateSpeedup(state.speedup);
+    slowingDownForPreviousCar = state.slowingDownForPreviousCar;
+    slowingDownForTrafficLight = state.slowingDownForTrafficLight;
+    slowingDownForVehicleSpecific = state.slowingDownForVehicleSpecific;
+    setSpecificState(state.specificState);
+
+    ENSURE(getCurrentRoad() == road and getCurrentSpeedup() == state.speedup, "De toestand moet hersteld zijn");
+    return true;
+}
+
+bool Vehicle::reactToTraffic(RoadNetwork *roadNetwork, std::ostream &errStream) {
+    REQUIRE(roadNetwork->findCar(licensePlate) != NULL, "De wagen moet in het netwerk zitten");
+
+    updateCurrentSpeedup(CONST::SECONDS_PER_ITERATION, roadNetwork);
+    checkTrafficAhead(roadNetwork, errStream);
+    return true;
+}
+
+void Vehicle::updateAfterMove(double time, RoadNetwork *roadNetwork, std::ostream &errStream) {
     updateCurrentSpeedup(time, roadNetwork);
+    changeRoads(roadNetwork);
+    checkTrafficAhead(roadNetwork, errStream);
+}
 
+void Vehicle::changeRoads(RoadNetwork *roadNetwork) {
     while (!checkCurrentPositionOnRoad()) {
         setCurrentPositionOnNewRoad(roadNetwork);
     }
+}
 
+void Vehicle::checkTrafficAhead(RoadNetwork *roadNetwork, std::ostream &errStream) {
     if (currentRoad != NULL) {
         checkForTrafficLight(roadNetwork, errStream);
         checkVehicleSpecificMove(roadNetwork, errStream);
@@ -148,11 +304,6 @@ bool Vehicle::move(RoadNetwork *roadNetwork, std::ostream &errStream) {
     slowingDownForPreviousCar = false;
     slowingDownForTrafficLight = false;
     slowingDownForVehicleSpecific = false;
-
-//    std::cout << "Car " << licensePlate << " " << currentPosition << std::endl;
-    ENSURE(roadNetwork->checkPositionCars(), "position");
-    ENSURE(roadNetwork->checkIfCarsOnExistingRoad(), "exist on road");
-    return true;
 }
 
 //Vehicle::Vehicle(const Vehicle *vehicle) : licensePlate(vehicle->getLicensePlate()),
@@ -167,11 +318,13 @@ bool Vehicle::move(RoadNetwork *roadNetwork, std::ostream &errStream) {
 
 double Vehicle::getCurrentSpeedup() const {
     REQUIRE(properlyInitialized(), "Het voertuig moet deftig geinitialiseerd zijn");
-    return currentSpeedup;
+    return stateSpeedup();
 }
 
 Vehicle::~Vehicle() {
-
+    if (stateLane != NULL) {
+        stateLane->store->detach(this);
+    }
 }
 
 bool Vehicle::properlyInitialized() const {
@@ -180,13 +333,20 @@ bool Vehicle::properlyInitialized() const {
 
 void Vehicle::updateCurrentPosition(double time) {
     // Bereken nieuwe positie van voertuig
-    currentPosition = Convert::kmhToMs(currentSpeed) * time + currentPosition;
+    setMovedPosition(Convert::kmhToMs(stateSpeed()) * time + statePosition());
+}
+
+void Vehicle::setMovedPosition(double newPosition) {
+    setStatePosition(newPosition);
+    if (currentRoad != NULL and currentRoad->hasVehicle(this)) {
+        currentRoad->updateVehiclePosition(this);
+    }
 
 }
 
 void Vehicle::updateCurrentSpeed(double time) {
     // Bereken nieuwe snelheid van voertuig
-    double currentSpeedMS = currentSpeedup * time + Convert::kmhToMs(currentSpeed);
+    double currentSpeedMS = stateSpeedup() * time + Convert::kmhToMs(stateSpeed());
     double newCurrentSpeed = Convert::msToKmh(currentSpeedMS);
 
 
@@ -199,24 +359,33 @@ void Vehicle::updateCurrentSpeed(double time) {
         newCurrentSpeed = getMinSpeed();
     }
 
-    currentSpeed = newCurrentSpeed;
+    setStateSpeed(newCurrentSpeed);
 }
 
 bool Vehicle::checkCurrentPositionOnRoad() {
-    return !(currentRoad != NULL && currentPosition > currentRoad->getLength());
+    return !(currentRoad != NULL && statePosition() > currentRoad->getLength());
 }
 
 void Vehicle::setCurrentPositionOnNewRoad(RoadNetwork *roadNetwork) {
     REQUIRE(!checkCurrentPositionOnRoad(), "De wagen moet buiten de weg vallen");
-    currentPosition = currentPosition - currentRoad->getLength();
+    setStatePosition(statePosition() - currentRoad->getLength());
     if (currentRoad->getIntersection() != NULL) {
         // IF huidige baan heeft verbinding
         // Zet voertuig op verbindingsbaan
+        bool inQueue = currentRoad->hasVehicle(this);
+        if (inQueue) {
+            currentRoad->exitVehicle(this);
+        }
         currentRoad = currentRoad->getIntersection();
+        updateStateLane();
+        if (inQueue) {
+            currentRoad->enterVehicle(this);
+        }
     } else {
         // ELSE
         // Verwijder voertuig uit simulatie
-        roadNetwork->removeVehicle(licensePlate);
+        // Het voertuig blijft bestaan tot alle voertuigen bewogen hebben
+        roadNetwork->exitVehicle(this);
         removeCurrentRoad();
     }
 }
@@ -231,15 +400,15 @@ void Vehicle::updateCurrentSpeedup(const double &time, RoadNetwork *roadNetwork)
 
         double idealFollowingDistance = getIdealDistance(roadNetwork);
         double actualFollowingDistance =
-                previousCar->getCurrentPosition() - previousCar->getLength() - currentPosition;
+                previousCar->getCurrentPosition() - previousCar->getLength() - statePosition();
 
 
         double newSpeedup = (actualFollowingDistance - idealFollowingDistance) / 2;
 
         if (slowingDownForTrafficLight or slowingDownForVehicleSpecific) {
-            currentSpeedup = currentSpeedup < newSpeedup ? currentSpeedup : newSpeedup;
+            setStateSpeedup(stateSpeedup() < newSpeedup ? stateSpeedup() : newSpeedup);
         } else {
-            currentSpeedup = newSpeedup;
+            setStateSpeedup(newSpeedup);
             slowingDownForPreviousCar = true;
         }
 
@@ -250,8 +419,8 @@ void Vehicle::updateCurrentSpeedup(const double &time, RoadNetwork *roadNetwork)
 
         slowingDownForPreviousCar = false;
 
-        currentSpeedup = -(Convert::kmhToMs(currentSpeed) -
-                           Convert::kmhToMs(currentRoad->getSpeedLimit(currentPosition)));
+        setStateSpeedup(-(Convert::kmhToMs(stateSpeed()) -
+                          Convert::kmhToMs(getCurrentSpeedLimit())));
 //        if(currentSpeed < currentRoad->getSpeedLimit(currentPosition)){
 //            currentSpeedup = getMaxSpeedup();
 //        } else {
@@ -259,8 +428,8 @@ void Vehicle::updateCurrentSpeedup(const double &time, RoadNetwork *roadNetwork)
 //        }
     }
 
-    if (currentSpeedup > getMaxSpeedup()) {
-        currentSpeedup = getMaxSpeedup();
+    if (stateSpeedup() > getMaxSpeedup()) {
+        setStateSpeedup(getMaxSpeedup());
     }
 }
 
@@ -269,7 +438,7 @@ double Vehicle::getIdealDistance(RoadNetwork *roadNetwork) const {
     if (previousCar == NULL) {
         return std::numeric_limits<double>::max();
     }
-    return (3 * currentSpeed) / 4 + previousCar->getLength() + CONST::MIN_FOLLOWING_DISTANCE;
+    return (3 * stateSpeed()) / 4 + previousCar->getLength() + CONST::MIN_FOLLOWING_DISTANCE;
 }
 
 void Vehicle::checkForTrafficLight(RoadNetwork *roadNetwork, std::ostream &errStream) {
@@ -278,29 +447,29 @@ void Vehicle::checkForTrafficLight(RoadNetwork *roadNetwork, std::ostream &errSt
         return;
     }
 
-    double positionNextTrafficLight = currentRoad->getNextTrafficLight(currentPosition);
+    TrafficLight *nextTrafficLight = currentRoad->getNextTrafficLight(statePosition(), currentFeature);
 
-    if (positionNextTrafficLight == -1) {
+    if (nextTrafficLight == NULL) {
         return;
     }
 
-    if (positionNextTrafficLight - currentPosition < 2 * getIdealDistance(roadNetwork)) {
-        TrafficLightColor trafficLightColor = currentRoad->getTrafficLight(positionNextTrafficLight)->getColor(
-                roadNetwork->getIteration());
+    double positionNextTrafficLight = nextTrafficLight->getPosition();
+    if (positionNextTrafficLight - statePosition() < 2 * getIdealDistance(roadNetwork)) {
+        TrafficLightColor trafficLightColor = roadNetwork->getTrafficLightColor(nextTrafficLight);
 
         if (trafficLightColor == red or trafficLightColor == orange) {
 
-            if (currentPosition == positionNextTrafficLight and currentSpeed > 0 and trafficLightColor == red) {
+            if (statePosition() == positionNextTrafficLight and stateSpeed() > 0 and trafficLightColor == red) {
                 errStream << "woopsiepoopsie door rood licht gereden, let's pretend I didn't see that ;)" << std::endl;
 //                move(roadNetwork);
             }
             double slowDown = calculateSlowDownForPosition(positionNextTrafficLight);
-            if (slowDown < currentSpeedup) {
-                currentSpeedup = slowDown;
+            if (slowDown < stateSpeedup()) {
+                setStateSpeedup(slowDown);
             }
-            currentSpeedup = calculateSlowDownForPosition(positionNextTrafficLight);
+            setStateSpeedup(calculateSlowDownForPosition(positionNextTrafficLight));
 
-            if (currentSpeedup < getMinSpeedup() and trafficLightColor == red) {
+            if (stateSpeedup() < getMinSpeedup() and trafficLightColor == red) {
                 errStream << "Impossible to stop before the traffic light" << std::endl;
                 updateCurrentSpeedup(1, roadNetwork);
             }
@@ -310,12 +479,12 @@ void Vehicle::checkForTrafficLight(RoadNetwork *roadNetwork, std::ostream &errSt
 }
 
 double Vehicle::calculateSlowDownForPosition(double stopPosition) {
-    double deltaP = stopPosition - currentPosition; // - Convert::kmhToMs(currentSpeed);
+    double deltaP = stopPosition - statePosition(); // - Convert::kmhToMs(currentSpeed);
     if (deltaP == 0) {
         return 0;
     }
 
-    if (currentSpeed == 0 or (deltaP > -(getMinSpeedup() * 2) and currentSpeed < -(getMinSpeedup()))) {
+    if (stateSpeed() == 0 or (deltaP > -(getMinSpeedup() * 2) and stateSpeed() < -(getMinSpeedup()))) {
         return deltaP / RELATIVE_SLOW_DOWN; // Een beetje versnellen
     }
 
@@ -323,12 +492,177 @@ double Vehicle::calculateSlowDownForPosition(double stopPosition) {
 //    std::cout << "Positie van stilstand: " << stopPosition << std::endl;
 //    std::cout << "Huidige positie: " << currentPosition << std::endl;
 //    std::cout << "Aantal m voor stilstand: " << deltaP << std::endl;
-    double speedMS = Convert::kmhToMs(currentSpeed);
+    double speedMS = Convert::kmhToMs(stateSpeed());
     return -(speedMS * speedMS) / deltaP;
 }
 
 void Vehicle::checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &errStream) {}
 
+double Vehicle::getNextSpecificPosition() {
+    return -1;
+}
+
+double Vehicle::getSpecificState() const {
+    return 0;
+}
+
+void Vehicle::setSpecificState(double specificState) {}
+
+int Vehicle::getSteadyIterations(RoadNetwork *roadNetwork, int maxIterations) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+
+    if (currentRoad == NULL) {
+        return 0;
+    }
+
+    // Dezelfde berekeningen als updateCurrentSpeed en updateCurrentSpeedup: de snelheid en versnelling moeten blijven.
+    // Dat is zo aan de snelheidslimiet, aan de maximumsnelheid van het voertuig onder de limiet, of ver genoeg achter
+    // een voorganger om de maximale versnelling te houden.
+    double time = CONST::SECONDS_PER_ITERATION;
+    double newSpeed = Convert::msToKmh(stateSpeedup() * time + Convert::kmhToMs(stateSpeed()));
+    if (newSpeed > getMaxSpeed()) {
+        newSpeed = getMaxSpeed();
+    }
+    if (newSpeed < getMinSpeed()) {
+        newSpeed = getMinSpeed();
+    }
+    if (newSpeed != stateSpeed() or newSpeed <= 0) {
+        return 0;
+    }
+
+    double step = Convert::kmhToMs(stateSpeed()) * time;
+    Vehicle *previousCar = roadNetwork->findPreviouscar(this);
+    double freeSpeedup = calculateFreeSpeedup();
+    // Ook het teken van een versnelling van 0 moet blijven, anders verschilt de uitvoer van een gewone simulatie
+    if (previousCar == NULL and (freeSpeedup != stateSpeedup() or
+                                 (freeSpeedup == 0 and 1 / freeSpeedup != 1 / stateSpeedup()))) {
+        return 0;
+    }
+    if (previousCar != NULL and stateSpeedup() != getMaxSpeedup()) {
+        return 0;
+    }
+
+    // Het eerste punt waar er iets verandert voor het voertuig
+    double eventPosition = currentRoad->getLength();
+    double nextZone = currentRoad->getNextZoneStart(statePosition(), currentZone);
+    if (nextZone != -1 and nextZone < eventPosition) {
+        eventPosition = nextZone;
+    }
+    TrafficLight *nextTrafficLight = currentRoad->getNextTrafficLight(statePosition(), currentFeature);
+    if (nextTrafficLight != NULL and nextTrafficLight->getPosition() < eventPosition) {
+        eventPosition = nextTrafficLight->getPosition();
+    }
+    double specificPosition = getNextSpecificPosition();
+    if (specificPosition != -1 and specificPosition < eventPosition) {
+        eventPosition = specificPosition;
+    }
+
+    // Een iteratie marge, zodat afrondingsfouten bij het optellen van de stappen geen verschil maken
+    double iterationsBeforeEvent = (eventPosition - statePosition()) / step - 1;
+
+    if (previousCar != NULL) {
+        // De afstand tot de voorganger moet groot genoeg blijven om de maximale versnelling te houden. Afhankelijk van
+        // de volgorde van de wagens is de voorganger al verplaatst of niet, dus wordt er een stap van hem niet geteld.
+        double previousStep = Convert::kmhToMs(previousCar->getCurrentSpeed()) * time;
+        double spareDistance = previousCar->getCurrentPosition() - previousCar->getLength() - statePosition() -
+                               getIdealDistance(roadNetwork) - 2 * getMaxSpeedup() - previousStep - 2 * step;
+        if (spareDistance < 0) {
+            return 0;
+        }
+        if (step > previousStep and spareDistance / (step - previousStep) < iterationsBeforeEvent) {
+            iterationsBeforeEvent = spareDistance / (step - previousStep);
+        }
+    }
+
+    if (iterationsBeforeEvent < 1) {
+        return 0;
+    }
+    int iterations = iterationsBeforeEvent < maxIterations ? (int) iterationsBeforeEvent : maxIterations;
+
+    // Het voertuig reageert op een oranje of rood licht voor hem op de weg
+    if (nextTrafficLight != NULL) {
+        for (int i = 1; i <= iterations; ++i) {
+            if (nextTrafficLight->getColor(roadNetwork->getIteration() + i) != green) {
+                return i - 1;
+            }
+        }
+    }
+    return iterations;
+}
+
+void Vehicle::advanceSteadily(int iterations) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    REQUIRE(currentRoad != NULL, "Het voertuig moet op een weg staan");
+
+    // Stap per stap opgeteld zoals updateCurrentPosition, zodat de positie bit per bit gelijk is
+    double time = CONST::SECONDS_PER_ITERATION;
+    double newPosition = statePosition();
+    for (int i = 0; i < iterations; ++i) {
+        newPosition = Convert::kmhToMs(stateSpeed()) * time + newPosition;
+    }
+    setMovedPosition(newPosition);
+    // Overgeslagen iteraties horen ook bij een grote stap die al gepland was
+    largeStepIterations = largeStepIterations > iterations ? largeStepIterations - iterations : 0;
+}
+
+void Vehicle::planLargeStep(RoadNetwork *roadNetwork, int maxIterations) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+
+    // Met een voorganger hangt de versnelling af van hoe die rijdt, en die kan elke iteratie remmen
+    if (currentRoad == NULL or roadNetwork->findPreviouscar(this) != NULL) {
+        largeStepIterations = 0;
+    } else {
+        largeStepIterations = getSteadyIterations(roadNetwork, maxIterations);
+    }
+
+    // De stap wordt niet meer nagekeken, dus moet hij eindigen voor het voertuig dicht bij het volgende licht komt. Met
+    // een iteratie marge, zodat afrondingsfouten bij het optellen van de stappen geen verschil maken.
+    TrafficLight *nextTrafficLight = largeStepIterations == 0 ? NULL :
+                                     currentRoad->getNextTrafficLight(statePosition(), currentFeature);
+    if (nextTrafficLight != NULL) {
+        double step = Convert::kmhToMs(stateSpeed()) * CONST::SECONDS_PER_ITERATION;
+        double iterationsBeforeLight =
+                (nextTrafficLight->getPosition() - CONST::METERS_BEFORE_SLOWING_DOWN - statePosition()) / step - 1;
+        if (iterationsBeforeLight < largeStepIterations) {
+            largeStepIterations = iterationsBeforeLight < 1 ? 0 : (int) iterationsBeforeLight;
+        }
+    }
+    ENSURE(getLargeStepIterations() >= 0 and getLargeStepIterations() <= maxIterations, "Te grote stap");
+}
+
+void Vehicle::continueLargeStep() {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    REQUIRE(getLargeStepIterations() > 0, "Het voertuig moet in een grote stap zitten");
+    stepTime = CONST::SECONDS_PER_ITERATION;
+    advanceSteadily(1);
+}
+
+void Vehicle::continueLargeStep(double newPosition) {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    REQUIRE(getLargeStepIterations() > 0, "Het voertuig moet in een grote stap zitten");
+    stepTime = CONST::SECONDS_PER_ITERATION;
+    setMovedPosition(newPosition);
+    largeStepIterations--;
+}
+
+void Vehicle::endLargeStep() {
+    largeStepIterations = 0;
+    ENSURE(getLargeStepIterations() == 0, "De grote stap moet beeindigd zijn");
+}
+
+int Vehicle::getLargeStepIterations() const {
+    return largeStepIterations;
+}
+
+double Vehicle::calculateFreeSpeedup() {
+    // Zoals updateCurrentSpeedup zonder voertuig voor zich
+    double speedup = -(Convert::kmhToMs(stateSpeed()) - Convert::kmhToMs(getCurrentSpeedLimit()));
+    if (speedup > getMaxSpeedup()) {
+        speedup = getMaxSpeedup();
+    }
+    return speedup;
+}
+
 //void Vehicle::disableSpeedupUpdates() {
 //    speedupUpdates = false;
 //}
@@ -341,6 +675,28 @@ void Vehicle::checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &e
 //    return speedupUpdates;
 //}
 
+Vehicle *Vehicle::getVehicleAhead() const {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    return vehicleAhead;
+}
+
+Vehicle *Vehicle::getVehicleBehind() const {
+    REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+    return vehicleBehind;
+}
+
+int Vehicle::getCurrentSpeedLimit() {
+    REQUIRE(currentRoad != NULL, "Het voertuig moet op een weg staan");
+    return currentRoad->getSpeedLimit(statePosition(), currentZone);
+}
+
 void Vehicle::removeCurrentRoad() {
     currentRoad = NULL;
+    updateStateLane();
+}
+
+void Vehicle::updateStateLane() {
+    if (stateLane != NULL) {
+        stateLane->store->changeRoad(this);
+    }
 }
@@ -12,15 +12,36 @@
 
 
 #include <string>
+#include "VehicleStateStore.h"
 
 class Road;
 
 class RoadNetwork;
 
+/**
+ * The state of a vehicle that changes while it drives, without its road, used to save and restore a vehicle
+ */
+struct VehicleState {
+    double position; /**< The position on the road in m */
+    double speed; /**< The speed in km/h */
+    double speedup; /**< The speedup in m / s^2 */
+    bool slowingDownForPreviousCar;
+    bool slowingDownForTrafficLight;
+    bool slowingDownForVehicleSpecific;
+    double specificState; /**< The state of a specific kind of vehicle, e.g. the waiting time of a bus */
+};
+
 /**
  * A class used to describe a Vehicle on a RoadNetwork
+ *
+ * The position, speed and speedup are kept by the vehicle itself, or by a VehicleStateStore the vehicle is attached
+ * to. The getters and setters work the same in both cases.
  */
 class Vehicle {
+    friend class Road;
+
+    friend class VehicleStateStore;
+
 public:
 
     /**
@@ -150,19 +171,259 @@ public:
      * @param roadNetwork The network containing the traffic situation.
      *
      * @pre The systems contains a scheme of the virtual traffic situation. There is a vehicle on a road.
-     * REQUIRE(roadNetwork->check_position_cars(), "position");
-     * REQUIRE(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     * REQUIRE_FULL(roadNetwork->check_position_cars(), "position");
+     * REQUIRE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
      * REQUIRE(time >= 0, "Tijd moet positief zijn");
      * REQUIRE(roadNetwork->findCar(license_plate) != NULL, "De wagen moet in het netwerk zitten");
      *
      * @post The vehicle has a new position.
-     * ENSURE(roadNetwork->check_position_cars(), "position");
-     * ENSURE(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     * ENSURE_FULL(roadNetwork->check_position_cars(), "position");
+     * ENSURE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
      *
      * @return true when successfully added, false when the prerequisites weren't met
      */
     bool move(RoadNetwork *roadNetwork, std::ostream &errStream);
 
+    /**
+     * Move the vehicle over a part of an iteration
+     *
+     * The same as move, but with a shorter time step. This is used to sub-step the vehicles that are near a leader,
+     * traffic light or vehicle specific position (see isNearInteraction), so they can react to it more than once per
+     * iteration.
+     *
+     * @param roadNetwork The network containing the traffic situation.
+     * @param errStream The stream to which the errors should be outputed
+     * @param time The time between the current position and the new position in s
+     *
+     * @pre
+     * REQUIRE_FULL(roadNetwork->check_position_cars(), "position");
+     * REQUIRE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     * REQUIRE(time > 0, "Tijd moet positief zijn");
+     * REQUIRE(roadNetwork->findCar(license_plate) != NULL, "De wagen moet in het netwerk zitten");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check_position_cars(), "position");
+     * ENSURE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     *
+     * @return true when successfully moved
+     */
+    bool move(RoadNetwork *roadNetwork, std::ostream &errStream, double time);
+
+    /**
+     * Check whether the vehicle has to react to something in the next iteration
+     *
+     * This is the case when the vehicle ahead on its road is closer than twice the ideal following distance, or when
+     * the next traffic light or vehicle specific position (see getNextSpecificPosition) is within
+     * CONST::METERS_BEFORE_SLOWING_DOWN plus the distance driven in one iteration.
+     *
+     * @param roadNetwork The network the vehicle is driving in
+     *
+     * @return true when the vehicle is near a leader, traffic light or vehicle specific position
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     */
+    bool isNearInteraction(RoadNetwork *roadNetwork);
+
+    /**
+     * Move the vehicle to a position and speed that have already been integrated over one iteration
+     *
+     * This is used by the VehicleStateStore, which integrates the position and speed of all vehicles at once. The rest
+     * of the move (speedup, changing roads, traffic lights, vehicle specific moves) is the same as in move.
+     *
+     * @param roadNetwork The network containing the traffic situation.
+     * @param errStream The stream to which the errors should be outputed
+     * @param newPosition The position of the vehicle after one iteration
+     * @param newSpeed The speed of the vehicle after one iteration
+     *
+     * @pre
+     * REQUIRE_FULL(roadNetwork->check_position_cars(), "position");
+     * REQUIRE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     * REQUIRE(roadNetwork->findCar(license_plate) != NULL, "De wagen moet in het netwerk zitten");
+     * REQUIRE(newPosition >= currentPosition, "Een voertuig kan niet achteruit rijden");
+     *
+     * @post
+     * ENSURE_FULL(roadNetwork->check_position_cars(), "position");
+     * ENSURE_FULL(roadNetwork->check_if_cars_on_existing_road(), "exist on road");
+     *
+     * @return true when successfully moved
+     */
+    bool move(RoadNetwork *roadNetwork, std::ostream &errStream, double newPosition, double newSpeed);
+
+    /**
+     * First half of a synchronous move: take over a position and speed that have already been integrated over one
+     * iteration, and drive onto the next road when the end of the current road has been passed
+     *
+     * The vehicle only changes its own state and its place in the vehicle queues of the roads, it doesn't look at other
+     * vehicles. When the last road has been passed, the vehicle leaves the network (see RoadNetwork::exitVehicle).
+     *
+     * @param roadNetwork The network containing the traffic situation.
+     * @param newPosition The position of the vehicle after one iteration
+     * @param newSpeed The speed of the vehicle after one iteration
+     *
+     * @pre
+     * REQUIRE(roadNetwork->findCar(license_plate) != NULL, "De wagen moet in het netwerk zitten");
+     * REQUIRE(newPosition >= currentPosition, "Een voertuig kan niet achteruit rijden");
+     *
+     * @return true when successfully moved
+     */
+    bool commitMove(RoadNetwork *roadNetwork, double newPosition, double newSpeed);
+
+    /**
+     * Put the vehicle back in a state that has been saved or recorded
+     *
+     * Unlike the setters, any position on the road and any speed can be restored, so a restored vehicle continues
+     * exactly where it was. When the vehicle is in the queue of a road, it moves to the queue of the new road. A road
+     * without a length is a connection to a road outside the network (see NetworkImporter): a vehicle that drove onto
+     * it is past its end until it leaves the network, so any position can be restored on it.
+     *
+     * @param road The road the vehicle was driving on
+     * @param position The position on that road in m
+     * @param speed The speed in km/h
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     * REQUIRE(road != NULL and position >= 0 and (position <= road->getLength() or road->getLength() == 0),
+     *         "De positie moet op de weg liggen");
+     *
+     * @post
+     * ENSURE(getCurrentRoad() == road and getCurrentPosition() == position and getCurrentSpeed() == speed,
+     *        "De toestand moet hersteld zijn");
+     *
+     * @return true when the state has been restored
+     */
+    bool restoreState(Road *road, double position, double speed);
+
+    /**
+     * @return Everything that changes while the vehicle drives, except its road
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     */
+    VehicleState getState() const;
+
+    /**
+     * Put the vehicle back in a state returned by getState, including its speedup and the state of the specific kind
+     * of vehicle, so it continues exactly as the saved vehicle would have
+     *
+     * @param road The road the vehicle was driving on
+     * @param state The state of the vehicle on that road
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     * REQUIRE(road != NULL and state.position >= 0 and
+     *         (state.position <= road->getLength() or road->getLength() == 0), "De positie moet op de weg liggen");
+     *
+     * @post
+     * ENSURE(getCurrentRoad() == road and getCurrentSpeedup() == state.speedup, "De toestand moet hersteld zijn");
+     *
+     * @return true when the state has been restored
+     */
+    bool restoreState(Road *road, const VehicleState &state);
+
+    /**
+     * Second half of a synchronous move: calculate the new speedup from the vehicle ahead, traffic lights and vehicle
+     * specific rules (e.g. bus stops)
+     *
+     * Other vehicles are only read (position and length), so the result doesn't depend on the order in which the
+     * vehicles react, as long as all of them have committed their move first.
+     *
+     * @param roadNetwork The network containing the traffic situation.
+     * @param errStream The stream to which the errors should be outputed
+     *
+     * @pre
+     * REQUIRE(roadNetwork->findCar(license_plate) != NULL, "De wagen moet in het netwerk zitten");
+     *
+     * @return true when successfully updated
+     */
+    bool reactToTraffic(RoadNetwork *roadNetwork, std::ostream &errStream);
+
+    /**
+     * Count the iterations in which the vehicle keeps driving at the same speed without reacting to anything
+     *
+     * The vehicle is in a steady state when its speed and speedup don't change: at the speed limit (or its own maximum
+     * speed) without a vehicle ahead on its road, or at its maximum speed far enough behind the vehicle ahead to keep
+     * its maximum speedup. It stays in that state until it reaches the next zone, traffic light, vehicle specific
+     * position (see getNextSpecificPosition) or the end of its road, until it gets too close to the vehicle ahead, or
+     * until the next traffic light stops being green.
+     *
+     * @param roadNetwork The network the vehicle is driving in
+     * @param maxIterations The maximum number of iterations to count
+     *
+     * @return The number of iterations the vehicle can be moved with advanceSteadily, 0 when it isn't in a steady state
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     */
+    int getSteadyIterations(RoadNetwork *roadNetwork, int maxIterations);
+
+    /**
+     * Move a vehicle in a steady state, with the same result as calling move for every iteration
+     *
+     * @param iterations The number of iterations, at most the result of getSteadyIterations
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     * REQUIRE(currentRoad != NULL, "Het voertuig moet op een weg staan");
+     */
+    void advanceSteadily(int iterations);
+
+    /**
+     * Plan a large step for a vehicle in free flow, after it has been moved in the current iteration
+     *
+     * Used in the adaptive step mode (see RoadNetwork::setSubSteps). Without a vehicle ahead on its road, the vehicle
+     * keeps driving at the same speed for getSteadyIterations iterations, so its trajectory over those iterations is
+     * already known. The step also ends before the vehicle gets near the next traffic light (see isNearInteraction).
+     * continueLargeStep then moves it along that trajectory.
+     *
+     * @param roadNetwork The network the vehicle is driving in
+     * @param maxIterations The maximum length of the step in iterations
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     *
+     * @post
+     * ENSURE(getLargeStepIterations() >= 0 and getLargeStepIterations() <= maxIterations, "Te grote stap");
+     */
+    void planLargeStep(RoadNetwork *roadNetwork, int maxIterations);
+
+    /**
+     * Move the vehicle over the next iteration of its large step, with the same result as move
+     *
+     * Only its position changes, its speed and speedup stay the same during the step. Nothing is checked: the step
+     * ends before the vehicle gets near an interaction (see planLargeStep), and a vehicle that comes ahead of it in the
+     * queue of its road ends the step right away (see endLargeStep).
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     * REQUIRE(getLargeStepIterations() > 0, "Het voertuig moet in een grote stap zitten");
+     */
+    void continueLargeStep();
+
+    /**
+     * Move the vehicle over the next iteration of its large step, to a position that has already been calculated
+     *
+     * @param newPosition The position after one iteration at its speed, e.g. from VehicleStateStore::getNewPosition
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized");
+     * REQUIRE(getLargeStepIterations() > 0, "Het voertuig moet in een grote stap zitten");
+     */
+    void continueLargeStep(double newPosition);
+
+    /**
+     * End the large step of the vehicle, from now on it's moved every iteration again
+     *
+     * @post
+     * ENSURE(getLargeStepIterations() == 0, "De grote stap moet beeindigd zijn");
+     */
+    void endLargeStep();
+
+    /**
+     * @return The number of iterations left in the large step of the vehicle, 0 when it's moved every iteration
+     */
+    int getLargeStepIterations() const;
+
     /**
      * Get the type of the Vehicle as a string.
      *
@@ -286,6 +547,26 @@ public:
      */
     virtual void checkVehicleSpecificMove(RoadNetwork *roadNetwork, std::ostream &errStream);
 
+    /**
+     * @return The first position on the current road where checkVehicleSpecificMove can change the speedup of the
+     * vehicle, -1 when there is none
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized")
+     * REQUIRE(currentRoad != NULL, "Het voertuig moet op een weg staan");
+     */
+    virtual double getNextSpecificPosition();
+
+    /**
+     * @return The state of the specific kind of vehicle that changes while it drives, 0 when there is none
+     */
+    virtual double getSpecificState() const;
+
+    /**
+     * Restore a state returned by getSpecificState
+     */
+    virtual void setSpecificState(double specificState);
+
 //    bool speedupUpdateEnabled() const;
 
     /**
@@ -302,6 +583,28 @@ public:
      */
     bool emptyConstructorParametersUpdated();
 
+    /**
+     * Get the next vehicle in the queue of the road the vehicle is driving on
+     *
+     * @return The vehicle directly in front of this vehicle, NULL when there is none or when the vehicle isn't in the
+     * queue of its road
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized")
+     */
+    Vehicle *getVehicleAhead() const;
+
+    /**
+     * Get the previous vehicle in the queue of the road the vehicle is driving on
+     *
+     * @return The vehicle directly behind this vehicle, NULL when there is none or when the vehicle isn't in the queue
+     * of its road
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The vehicle should be properly initialized")
+     */
+    Vehicle *getVehicleBehind() const;
+
 
 protected:
     std::string licensePlate; /**< A unique ID for each vehicle */
@@ -312,10 +615,69 @@ protected:
                                 * be greater than or equal to 0.*/
     double currentSpeedup; /**< The speed by which the vehicle is accelerated in m / s^2. */
 
+    // Binnen de klasse gedefinieerd, zodat de oproep verdwijnt: de toestand wordt bij elke stap vele keren gelezen
+    /**
+     * @return The position of the vehicle, in its slot of the state store when it's attached to one
+     */
+    double statePosition() const {
+        return stateLane != NULL ? stateLane->position[stateIndex] : currentPosition;
+    }
+
+    void setStatePosition(double value) {
+        if (stateLane != NULL) {
+            stateLane->position[stateIndex] = value;
+        } else {
+            currentPosition = value;
+        }
+    }
+
+    /**
+     * @return The speed of the vehicle, in its slot of the state store when it's attached to one
+     */
+    double stateSpeed() const {
+        return stateLane != NULL ? stateLane->speed[stateIndex] : currentSpeed;
+    }
+
+    void setStateSpeed(double value) {
+        if (stateLane != NULL) {
+            stateLane->speed[stateIndex] = value;
+        } else {
+            currentSpeed = value;
+        }
+    }
+
+    /**
+     * @return The speedup of the vehicle, in its slot of the state store when it's attached to one
+     */
+    double stateSpeedup() const {
+        return stateLane != NULL ? stateLane->speedup[stateIndex] : currentSpeedup;
+    }
+
+    void setStateSpeedup(double value) {
+        if (stateLane != NULL) {
+            stateLane->speedup[stateIndex] = value;
+        } else {
+            currentSpeedup = value;
+        }
+    }
+
+    /**
+     * Move the slot in the state store along when the vehicle has changed roads
+     */
+    void updateStateLane();
+
     Vehicle *_initCheck;
 
     void updateCurrentPosition(double time);
 
+    void setMovedPosition(double newPosition);
+
+    void updateAfterMove(double time, RoadNetwork *roadNetwork, std::ostream &errStream);
+
+    void changeRoads(RoadNetwork *roadNetwork);
+
+    void checkTrafficAhead(RoadNetwork *roadNetwork, std::ostream &errStream);
+
     void updateCurrentSpeed(double time);
 
     bool checkCurrentPositionOnRoad();
@@ -332,9 +694,22 @@ protected:
 
     void removeCurrentRoad();
 
+    int getCurrentSpeedLimit();
+
+    double calculateFreeSpeedup();
+
     bool slowingDownForPreviousCar;
     bool slowingDownForTrafficLight;
     bool slowingDownForVehicleSpecific;
+    unsigned int stateIndex; /**< The slot of the vehicle in stateLane, maintained by VehicleStateStore */
+
+    Vehicle *vehicleAhead; /**< The next vehicle in the queue of currentRoad, maintained by Road */
+    Vehicle *vehicleBehind; /**< The previous vehicle in the queue of currentRoad, maintained by Road */
+    int currentZone; /**< The zone of currentRoad the vehicle was in last time its speed limit was needed */
+    int currentFeature; /**< The place on the timeline of currentRoad, last time a traffic light or stop was needed */
+    double stepTime; /**< The time in s of the last move, shorter than an iteration when sub-stepped */
+    int largeStepIterations; /**< The iterations left in the large step of the vehicle, see planLargeStep */
+    VehicleStateStore::Lane *stateLane; /**< The lane that keeps the state of the vehicle, NULL when it keeps it itself */
 
 //    void setSpeedupBetweenAllowedRange(double speedup);
 //
@@ -0,0 +1,308 @@
+/**
+ * @file VehicleStateStore.cpp
+ * @brief This file will contain the definitions of the functions in VehicleStateStore.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+// Zonder -mavx wordt de AVX-lus apart voor AVX gecompileerd en pas gekozen wanneer de processor het ondersteunt
+#if !defined(__AVX__) and defined(__SSE2__) and (defined(__clang__) or __GNUC__ >= 5)
+#define VEHICLESTATESTORE_AVX_DISPATCH
+#endif
+
+#if defined(__AVX__) or defined(VEHICLESTATESTORE_AVX_DISPATCH)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "VehicleStateStore.h"
+#include "Vehicle.h"
+#include "CONST.h"
+#include "DesignByContract.h"
+
+namespace {
+    /**
+     * The arrays of one lane that are read and written by the integration
+     */
+    struct LaneArrays {
+        const double *position;
+        const double *speed;
+        const double *speedup;
+        const double *minSpeed;
+        const double *maxSpeed;
+        double *newPosition;
+        double *newSpeed;
+    };
+
+    // Dezelfde bewerkingen in dezelfde volgorde als Vehicle::updateCurrentPosition en Vehicle::updateCurrentSpeed,
+    // zodat het resultaat bit per bit gelijk is. min(max, v) en max(min, v) geven net als de vergelijkingen daar v
+    // terug wanneer beide gelijk zijn. Elke lus begint bij vehicle en geeft het eerste voertuig terug dat ze niet deed.
+
+#if defined(__AVX__) or defined(VEHICLESTATESTORE_AVX_DISPATCH)
+#if defined(VEHICLESTATESTORE_AVX_DISPATCH)
+    __attribute__((target("avx")))
+#endif
+    unsigned int integrateAvx(const LaneArrays &lane, double time, unsigned int vehicle, unsigned int size) {
+        const __m256d ratio4 = _mm256_set1_pd(CONST::MS_KMH_RATIO);
+        const __m256d time4 = _mm256_set1_pd(time);
+        unsigned int i = vehicle;
+        for (; i + 4 <= size; i += 4) {
+            __m256d speedMs = _mm256_div_pd(_mm256_loadu_pd(lane.speed + i), ratio4);
+            _mm256_storeu_pd(lane.newPosition + i,
+                             _mm256_add_pd(_mm256_mul_pd(speedMs, time4), _mm256_loadu_pd(lane.position + i)));
+
+            __m256d speedKmh = _mm256_mul_pd(
+                    _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(lane.speedup + i), time4), speedMs), ratio4);
+            speedKmh = _mm256_min_pd(_mm256_loadu_pd(lane.maxSpeed + i), speedKmh);
+            speedKmh = _mm256_max_pd(_mm256_loadu_pd(lane.minSpeed + i), speedKmh);
+            _mm256_storeu_pd(lane.newSpeed + i, speedKmh);
+        }
+        return i;
+    }
+#endif
+
+#if defined(__SSE2__)
+    unsigned int integrateSse2(const LaneArrays &lane, double time, unsigned int vehicle, unsigned int size) {
+        const __m128d ratio2 = _mm_set1_pd(CONST::MS_KMH_RATIO);
+        const __m128d time2 = _mm_set1_pd(time);
+        unsigned int i = vehicle;
+        for (; i + 2 <= size; i += 2) {
+            __m128d speedMs = _mm_div_pd(_mm_loadu_pd(lane.speed + i), ratio2);
+            _mm_storeu_pd(lane.newPosition + i,
+                          _mm_add_pd(_mm_mul_pd(speedMs, time2), _mm_loadu_pd(lane.position + i)));
+
+            __m128d speedKmh = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(lane.speedup + i), time2), speedMs),
+                                          ratio2);
+            speedKmh = _mm_min_pd(_mm_loadu_pd(lane.maxSpeed + i), speedKmh);
+            speedKmh = _mm_max_pd(_mm_loadu_pd(lane.minSpeed + i), speedKmh);
+            _mm_storeu_pd(lane.newSpeed + i, speedKmh);
+        }
+        return i;
+    }
+#endif
+
+    unsigned int integrateScalar(const LaneArrays &lane, double time, unsigned int vehicle, unsigned int size) {
+        unsigned int i = vehicle;
+        for (; i < size; ++i) {
+            double speedMs = lane.speed[i] / CONST::MS_KMH_RATIO;
+            lane.newPosition[i] = speedMs * time + lane.position[i];
+
+            double speedKmh = (lane.speedup[i] * time + speedMs) * CONST::MS_KMH_RATIO;
+            if (speedKmh > lane.maxSpeed[i]) {
+                speedKmh = lane.maxSpeed[i];
+            }
+            if (speedKmh < lane.minSpeed[i]) {
+                speedKmh = lane.minSpeed[i];
+            }
+            lane.newSpeed[i] = speedKmh;
+        }
+        return i;
+    }
+}
+
+VehicleStateStore::VehicleStateStore() : vehicles(0) {
+    _initCheck = this;
+    ENSURE(properlyInitialized() and nrOfVehicles() == 0, "The store must be properly initialized and empty");
+}
+
+VehicleStateStore::~VehicleStateStore() {
+    detachAll();
+    for (unsigned int i = 0; i < lanes.size(); ++i) {
+        delete lanes[i];
+    }
+}
+
+bool VehicleStateStore::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+VehicleStateStore::Lane *VehicleStateStore::findLane(const Road *road) {
+    std::tr1::unordered_map<const Road *, Lane *>::iterator found = laneOfRoad.find(road);
+    if (found != laneOfRoad.end()) {
+        // Een weg op het adres van een verwijderde weg krijgt diens lege rijstrook
+        found->second->road = road;
+        return found->second;
+    }
+
+    Lane *lane = new Lane();
+    lane->store = this;
+    lane->road = road;
+    lanes.push_back(lane);
+    laneOfRoad[road] = lane;
+    return lane;
+}
+
+void VehicleStateStore::addSlot(Lane *lane, Vehicle *vehicle, double position, double speed, double speedup,
+                                double newPosition, double newSpeed) {
+    vehicle->stateLane = lane;
+    vehicle->stateIndex = lane->vehicles.size();
+    lane->vehicles.push_back(vehicle);
+    lane->position.push_back(position);
+    lane->speed.push_back(speed);
+    lane->speedup.push_back(speedup);
+    lane->newPosition.push_back(newPosition);
+    lane->newSpeed.push_back(newSpeed);
+}
+
+void VehicleStateStore::removeSlot(Lane *lane, unsigned int index) {
+    unsigned int last = lane->vehicles.size() - 1;
+    if (index != last) {
+        lane->vehicles[index] = lane->vehicles[last];
+        lane->vehicles[index]->stateIndex = index;
+        lane->position[index] = lane->position[last];
+        lane->speed[index] = lane->speed[last];
+        lane->speedup[index] = lane->speedup[last];
+        lane->length[index] = lane->length[last];
+        lane->minSpeed[index] = lane->minSpeed[last];
+        lane->maxSpeed[index] = lane->maxSpeed[last];
+        lane->newPosition[index] = lane->newPosition[last];
+        lane->newSpeed[index] = lane->newSpeed[last];
+    }
+    lane->vehicles.pop_back();
+    lane->position.pop_back();
+    lane->speed.pop_back();
+    lane->speedup.pop_back();
+    lane->length.pop_back();
+    lane->minSpeed.pop_back();
+    lane->maxSpeed.pop_back();
+    lane->newPosition.pop_back();
+    lane->newSpeed.pop_back();
+}
+
+void VehicleStateStore::attach(Vehicle *vehicle) {
+    REQUIRE(properlyInitialized(), "The store must be properly initialized");
+    REQUIRE(!contains(vehicle), "Het voertuig mag nog niet in de store zitten");
+
+    Lane *lane = findLane(vehicle->getCurrentRoad());
+    // De constanten van het type worden maar een keer opgevraagd, niet elke iteratie
+    lane->length.push_back(vehicle->getLength());
+    lane->minSpeed.push_back(vehicle->getMinSpeed());
+    lane->maxSpeed.push_back(vehicle->getMaxSpeed());
+    addSlot(lane, vehicle, vehicle->currentPosition, vehicle->currentSpeed, vehicle->currentSpeedup,
+            vehicle->currentPosition, vehicle->currentSpeed);
+    ++vehicles;
+
+    ENSURE(contains(vehicle), "Het voertuig moet in de store zitten");
+}
+
+void VehicleStateStore::detach(Vehicle *vehicle) {
+    REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+
+    Lane *lane = vehicle->stateLane;
+    unsigned int index = vehicle->stateIndex;
+    vehicle->currentPosition = lane->position[index];
+    vehicle->currentSpeed = lane->speed[index];
+    vehicle->currentSpeedup = lane->speedup[index];
+    removeSlot(lane, index);
+    vehicle->stateLane = NULL;
+    --vehicles;
+
+    ENSURE(!contains(vehicle), "Het voertuig mag niet meer in de store zitten");
+}
+
+void VehicleStateStore::detachAll() {
+    REQUIRE(properlyInitialized(), "The store must be properly initialized");
+    for (unsigned int i = 0; i < lanes.size(); ++i) {
+        while (!lanes[i]->vehicles.empty()) {
+            detach(lanes[i]->vehicles.back());
+        }
+    }
+    ENSURE(nrOfVehicles() == 0, "De store moet leeg zijn");
+}
+
+void VehicleStateStore::changeRoad(Vehicle *vehicle) {
+    REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+
+    Lane *lane = vehicle->stateLane;
+    if (lane->road == vehicle->getCurrentRoad()) {
+        return;
+    }
+    unsigned int index = vehicle->stateIndex;
+    Lane *newLane = findLane(vehicle->getCurrentRoad());
+    newLane->length.push_back(lane->length[index]);
+    newLane->minSpeed.push_back(lane->minSpeed[index]);
+    newLane->maxSpeed.push_back(lane->maxSpeed[index]);
+    addSlot(newLane, vehicle, lane->position[index], lane->speed[index], lane->speedup[index],
+            lane->newPosition[index], lane->newSpeed[index]);
+    removeSlot(lane, index);
+}
+
+bool VehicleStateStore::contains(const Vehicle *vehicle) const {
+    return vehicle->stateLane != NULL and vehicle->stateLane->store == this;
+}
+
+void VehicleStateStore::integrate(double time) {
+    REQUIRE(properlyInitialized(), "The store must be properly initialized");
+    REQUIRE(time >= 0, "De tijd kan niet negatief zijn");
+
+    for (unsigned int i = 0; i < lanes.size(); ++i) {
+        integrateArrays(*lanes[i], time);
+    }
+}
+
+void VehicleStateStore::integrateLane(int lane, double time) {
+    REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+    REQUIRE(time >= 0, "De tijd kan niet negatief zijn");
+    integrateArrays(*lanes[lane], time);
+}
+
+const std::vector<Vehicle *> &VehicleStateStore::getLaneVehicles(int lane) const {
+    REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+    return lanes[lane]->vehicles;
+}
+
+const Road *VehicleStateStore::getLaneRoad(int lane) const {
+    REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+    REQUIRE(!getLaneVehicles(lane).empty(), "De weg van een lege rijstrook bestaat misschien niet meer");
+    return lanes[lane]->road;
+}
+
+void VehicleStateStore::integrateArrays(Lane &lane, double time) {
+    unsigned int size = lane.position.size();
+    if (size == 0) {
+        return;
+    }
+
+    LaneArrays arrays;
+    arrays.position = &lane.position[0];
+    arrays.speed = &lane.speed[0];
+    arrays.speedup = &lane.speedup[0];
+    arrays.minSpeed = &lane.minSpeed[0];
+    arrays.maxSpeed = &lane.maxSpeed[0];
+    arrays.newPosition = &lane.newPosition[0];
+    arrays.newSpeed = &lane.newSpeed[0];
+
+    unsigned int i = 0;
+#if defined(__AVX__)
+    i = integrateAvx(arrays, time, i, size);
+#elif defined(VEHICLESTATESTORE_AVX_DISPATCH)
+    if (__builtin_cpu_supports("avx")) {
+        i = integrateAvx(arrays, time, i, size);
+    }
+#endif
+#if defined(__SSE2__)
+    i = integrateSse2(arrays, time, i, size);
+#endif
+    integrateScalar(arrays, time, i, size);
+}
+
+double VehicleStateStore::getNewPosition(const Vehicle *vehicle) const {
+    REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+    return vehicle->stateLane->newPosition[vehicle->stateIndex];
+}
+
+double VehicleStateStore::getNewSpeed(const Vehicle *vehicle) const {
+    REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+    return vehicle->stateLane->newSpeed[vehicle->stateIndex];
+}
+
+int VehicleStateStore::nrOfVehicles() const {
+    return vehicles;
+}
+
+int VehicleStateStore::nrOfLanes() const {
+    return lanes.size();
+}
@@ -0,0 +1,216 @@
+/**
+ * @file VehicleStateStore.h
+ * @brief This header file will contain the VehicleStateStore class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_VEHICLESTATESTORE_H
+#define ANTROPSE_VEHICLESTATESTORE_H
+
+#include <vector>
+#include <tr1/unordered_map>
+
+class Road;
+
+class Vehicle;
+
+/**
+ * The kinematic state of the vehicles in a network, stored per road as a structure of arrays
+ *
+ * Every road gets a lane with contiguous arrays for the position, speed, speedup, length and speed limits of the
+ * vehicles driving on it. A vehicle that is attached to the store doesn't keep its position, speed and speedup itself:
+ * its getters and setters read and write its slot in the lane of its road (see Vehicle::getCurrentPosition), so the
+ * Vehicle API stays a facade over the store. When the vehicle changes roads, its slot moves to the lane of the new
+ * road. The length and speed limits of the vehicle type are fetched once, when the vehicle is attached.
+ *
+ * The integration of the position and the speed (including the clamping to the speed limits of the vehicle type) runs
+ * over the lanes with AVX or SSE2, with a scalar fallback. The AVX loop is also compiled without -mavx, and is then
+ * only used when the processor supports AVX. The results are bit-identical to Vehicle::updateCurrentPosition and
+ * Vehicle::updateCurrentSpeed.
+ */
+class VehicleStateStore {
+public:
+    /**
+     * The vehicles on one road, every vector has one element per vehicle
+     */
+    struct Lane {
+        VehicleStateStore *store;
+        const Road *road; /**< Only valid while there are vehicles in the lane, a road can be destroyed afterwards */
+        std::vector<Vehicle *> vehicles;
+        std::vector<double> position;
+        std::vector<double> speed;
+        std::vector<double> speedup;
+        std::vector<double> length;
+        std::vector<double> minSpeed;
+        std::vector<double> maxSpeed;
+        std::vector<double> newPosition;
+        std::vector<double> newSpeed;
+    };
+
+    /**
+     * @post
+     * ENSURE(properlyInitialized() and nrOfVehicles() == 0, "The store must be properly initialized and empty");
+     */
+    VehicleStateStore();
+
+    /**
+     * Every vehicle that is still attached gets its state back
+     */
+    ~VehicleStateStore();
+
+    /**
+     * Move the state of a vehicle into the lane of its road, from now on the vehicle reads and writes it there
+     *
+     * @param vehicle The vehicle, on a road or not
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The store must be properly initialized");
+     * REQUIRE(!contains(vehicle), "Het voertuig mag nog niet in de store zitten");
+     *
+     * @post
+     * ENSURE(contains(vehicle), "Het voertuig moet in de store zitten");
+     */
+    void attach(Vehicle *vehicle);
+
+    /**
+     * Give a vehicle its state back and remove it from its lane
+     *
+     * @pre
+     * REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+     *
+     * @post
+     * ENSURE(!contains(vehicle), "Het voertuig mag niet meer in de store zitten");
+     */
+    void detach(Vehicle *vehicle);
+
+    /**
+     * Give every vehicle its state back
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The store must be properly initialized");
+     *
+     * @post
+     * ENSURE(nrOfVehicles() == 0, "De store moet leeg zijn");
+     */
+    void detachAll();
+
+    /**
+     * Move the slot of a vehicle to the lane of the road it's driving on now, with its integrated state
+     *
+     * @pre
+     * REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+     */
+    void changeRoad(Vehicle *vehicle);
+
+    /**
+     * @return true when the vehicle reads and writes its state in this store
+     */
+    bool contains(const Vehicle *vehicle) const;
+
+    /**
+     * Integrate the position and the speed of all vehicles over a period of time
+     *
+     * The vehicles keep their state, the results can be fetched with getNewPosition and getNewSpeed.
+     *
+     * @param time The time in seconds over which the vehicles are moved
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The store must be properly initialized");
+     * REQUIRE(time >= 0, "De tijd kan niet negatief zijn");
+     */
+    void integrate(double time);
+
+    /**
+     * Integrate the position and the speed of the vehicles on one road, lanes can be integrated on different threads
+     *
+     * @param lane The number of the lane, from 0 to nrOfLanes() - 1
+     * @param time The time in seconds over which the vehicles are moved
+     *
+     * @pre
+     * REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+     * REQUIRE(time >= 0, "De tijd kan niet negatief zijn");
+     */
+    void integrateLane(int lane, double time);
+
+    /**
+     * @param lane The number of the lane, from 0 to nrOfLanes() - 1
+     *
+     * @pre
+     * REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+     *
+     * @return The vehicles of the lane, in no particular order
+     */
+    const std::vector<Vehicle *> &getLaneVehicles(int lane) const;
+
+    /**
+     * @param lane The number of the lane, from 0 to nrOfLanes() - 1
+     *
+     * @pre
+     * REQUIRE(lane >= 0 and lane < nrOfLanes(), "De rijstrook moet bestaan");
+     * REQUIRE(!getLaneVehicles(lane).empty(), "De weg van een lege rijstrook bestaat misschien niet meer");
+     *
+     * @return The road of the lane, NULL for the vehicles that have left the network
+     */
+    const Road *getLaneRoad(int lane) const;
+
+    /**
+     * @pre
+     * REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+     *
+     * @return The position of the vehicle after the last integration
+     */
+    double getNewPosition(const Vehicle *vehicle) const;
+
+    /**
+     * @pre
+     * REQUIRE(contains(vehicle), "Het voertuig moet in de store zitten");
+     *
+     * @return The speed of the vehicle after the last integration
+     */
+    double getNewSpeed(const Vehicle *vehicle) const;
+
+    /**
+     * @return The number of vehicles in the store
+     */
+    int nrOfVehicles() const;
+
+    /**
+     * @return The number of lanes, including the lanes without vehicles
+     */
+    int nrOfLanes() const;
+
+    bool properlyInitialized() const;
+
+private:
+    Lane *findLane(const Road *road);
+
+    /**
+     * Add a slot at the end of a lane, with the state of the vehicle
+     */
+    void addSlot(Lane *lane, Vehicle *vehicle, double position, double speed, double speedup, double newPosition,
+                 double newSpeed);
+
+    /**
+     * Remove a slot from its lane, the last slot of the lane takes its place
+     */
+    void removeSlot(Lane *lane, unsigned int index);
+
+    static void integrateArrays(Lane &lane, double time);
+
+    std::vector<Lane *> lanes;
+    std::tr1::unordered_map<const Road *, Lane *> laneOfRoad;
+    int vehicles;
+
+    VehicleStateStore *_initCheck;
+
+    // Elke rijstrook hoort bij een store, en de voertuigen verwijzen naar hun rijstrook
+    VehicleStateStore(const VehicleStateStore &);
+
+    VehicleStateStore &operator=(const VehicleStateStore &);
+};
+
+
+#endif //ANTROPSE_VEHICLESTATESTORE_H
@@ -0,0 +1,80 @@
+/**
+ * @file WorkerPool.cpp
+ * @brief This file will contain the definitions of the functions in WorkerPool.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include "WorkerPool.h"
+#include "DesignByContract.h"
+
+WorkerPool::Task::~Task() {}
+
+WorkerPool::WorkerPool(int nrOfThreads) : nrOfThreads(nrOfThreads), currentTask(NULL), stopping(false) {
+    REQUIRE(nrOfThreads >= 1, "Er moet minstens 1 thread zijn");
+    _initCheck = this;
+
+    pthread_barrier_init(&startBarrier, NULL, nrOfThreads);
+    pthread_barrier_init(&endBarrier, NULL, nrOfThreads);
+
+    // De vector mag na het starten van de threads niet meer verplaatst worden
+    workers.resize(nrOfThreads - 1);
+    for (unsigned int i = 0; i < workers.size(); ++i) {
+        workers[i].pool = this;
+        workers[i].number = i + 1;
+        pthread_create(&workers[i].thread, NULL, workerMain, &workers[i]);
+    }
+
+    ENSURE(properlyInitialized(), "The pool must be properly initialized");
+    ENSURE(getNrOfThreads() == nrOfThreads, "Het aantal threads moet kloppen");
+}
+
+WorkerPool::~WorkerPool() {
+    stopping = true;
+    pthread_barrier_wait(&startBarrier);
+    for (unsigned int i = 0; i < workers.size(); ++i) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    pthread_barrier_destroy(&startBarrier);
+    pthread_barrier_destroy(&endBarrier);
+}
+
+void *WorkerPool::workerMain(void *argument) {
+    Worker *worker = static_cast<Worker *>(argument);
+    WorkerPool *pool = worker->pool;
+    while (true) {
+        // De barriers zorgen ervoor dat currentTask en stopping zichtbaar zijn voor alle threads
+        pthread_barrier_wait(&pool->startBarrier);
+        if (pool->stopping) {
+            break;
+        }
+        pool->currentTask->execute(worker->number, pool->nrOfThreads);
+        pthread_barrier_wait(&pool->endBarrier);
+    }
+    return NULL;
+}
+
+void WorkerPool::run(Task &task) {
+    REQUIRE(properlyInitialized(), "The pool must be properly initialized");
+
+    if (nrOfThreads == 1) {
+        task.execute(0, 1);
+        return;
+    }
+
+    currentTask = &task;
+    pthread_barrier_wait(&startBarrier);
+    task.execute(0, nrOfThreads);
+    pthread_barrier_wait(&endBarrier);
+    currentTask = NULL;
+}
+
+int WorkerPool::getNrOfThreads() const {
+    return nrOfThreads;
+}
+
+bool WorkerPool::properlyInitialized() const {
+    return _initCheck == this;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file WorkerPool.h
+ * @brief This header file will contain the WorkerPool class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_WORKERPOOL_H
+#define ANTROPSE_WORKERPOOL_H
+
+#include <vector>
+#include <pthread.h>
+
+/**
+ * A fixed group of threads that execute the same task together
+ *
+ * The calling thread is worker 0, so a pool of n threads starts n - 1 extra threads. The threads wait on a barrier
+ * between two tasks, so no threads are created during the simulation.
+ */
+class WorkerPool {
+public:
+    /**
+     * A piece of work that is split over the workers of the pool
+     */
+    class Task {
+    public:
+        /**
+         * Execute the part of the work for one worker
+         *
+         * @param worker The number of this worker, from 0 to nrOfWorkers - 1
+         * @param nrOfWorkers The number of workers executing the task
+         */
+        virtual void execute(int worker, int nrOfWorkers) = 0;
+
+        virtual ~Task();
+    };
+
+    /**
+     * Start the threads of the pool
+     *
+     * @param nrOfThreads The number of threads executing a task, including the calling thread
+     *
+     * @pre
+     * REQUIRE(nrOfThreads >= 1, "Er moet minstens 1 thread zijn");
+     *
+     * @post
+     * ENSURE(properlyInitialized(), "The pool must be properly initialized");
+     * ENSURE(getNrOfThreads() == nrOfThreads, "Het aantal threads moet kloppen");
+     */
+    explicit WorkerPool(int nrOfThreads);
+
+    /**
+     * Stop and join all threads of the pool
+     */
+    ~WorkerPool();
+
+    /**
+     * Execute a task on all threads, returns when every worker has finished its part
+     *
+     * @param task The task to execute
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The pool must be properly initialized");
+     */
+    void run(Task &task);
+
+    /**
+     * @return The number of threads executing a task, including the calling thread
+     */
+    int getNrOfThreads() const;
+
+    bool properlyInitialized() const;
+
+private:
+    struct Worker {
+        WorkerPool *pool;
+        int number;
+        pthread_t thread;
+    };
+
+    static void *workerMain(void *argument);
+
+    int nrOfThreads;
+    std::vector<Worker> workers;
+    pthread_barrier_t startBarrier;
+    pthread_barrier_t endBarrier;
+    Task *currentTask;
+    bool stopping;
+
+    WorkerPool *_initCheck;
+
+    // Een pool kan niet gekopieerd worden, de threads hebben een pointer naar de pool
+    WorkerPool(const WorkerPool &);
+
+    WorkerPool &operator=(const WorkerPool &);
+};
+
+
+#endif //ANTROPSE_WORKERPOOL_H
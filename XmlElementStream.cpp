@@ -0,0 +1,234 @@
+/**
+ * @file XmlElementStream.cpp
+ * @brief This file will contain the definitions of the functions in XmlElementStream.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#include <cstring>
+#include "XmlElementStream.h"
+#include "DesignByContract.h"
+
+XmlElementStream::XmlElementStream(std::istream &inStream) : inStream(&inStream), buffer(BLOCK_SIZE),
+                                                             block(&buffer[0]), position(0), blockSize(0),
+                                                             previousWasCarriageReturn(false), rootOpen(false),
+                                                             damaged(false) {
+    _initCheck = this;
+}
+
+XmlElementStream::XmlElementStream(const char *data, std::size_t size) : inStream(NULL), block(data), position(0),
+                                                                        blockSize(size),
+                                                                        previousWasCarriageReturn(false),
+                                                                        rootOpen(false), damaged(false) {
+    _initCheck = this;
+}
+
+bool XmlElementStream::properlyInitialized() const {
+    return _initCheck == this;
+}
+
+bool XmlElementStream::isDamaged() const {
+    return damaged;
+}
+
+int XmlElementStream::get() {
+    while (true) {
+        if (position == blockSize) {
+            if (inStream == NULL) {
+                return -1; // Het hele document zit al in het geheugen
+            }
+            inStream->read(&buffer[0], BLOCK_SIZE);
+            blockSize = inStream->gcount();
+            position = 0;
+            if (blockSize == 0) {
+                return -1;
+            }
+        }
+        char c = block[position++];
+        if (c == '\n' and previousWasCarriageReturn) {
+            // De '\n' van "\r\n" is al teruggegeven voor de '\r'
+            previousWasCarriageReturn = false;
+            continue;
+        }
+        previousWasCarriageReturn = c == '\r';
+        return c == '\r' ? '\n' : (unsigned char) c;
+    }
+}
+
+bool XmlElementStream::readUntil(const char *terminator, std::string *text) {
+    std::size_t length = std::strlen(terminator);
+    std::string window;
+    while (true) {
+        int c = get();
+        if (c == -1) {
+            return false;
+        }
+        if (text != NULL) {
+            *text += (char) c;
+        }
+        window += (char) c;
+        if (window.size() > length) {
+            window.erase(0, 1);
+        }
+        if (window == terminator) {
+            return true;
+        }
+    }
+}
+
+bool XmlElementStream::readMarkup(std::string *text, MarkupType &type) {
+    if (text != NULL) {
+        *text += '<';
+    }
+    int c = get();
+    if (c == -1) {
+        return false;
+    }
+    if (text != NULL) {
+        *text += (char) c;
+    }
+
+    type = otherMarkup;
+    if (c == '!') {
+        c = get();
+        if (c == -1) {
+            return false;
+        }
+        if (text != NULL) {
+            *text += (char) c;
+        }
+        if (c == '-') {
+            return readUntil("-->", text);
+        } else if (c == '[') {
+            return readUntil("]]>", text);
+        }
+        return readUntil(">", text);
+    } else if (c == '?') {
+        return readUntil("?>", text);
+    } else if (c == '/') {
+        type = endTag;
+        return readUntil(">", text);
+    }
+
+    // Een start tag, een '>' binnen de waarde van een attribuut sluit hem niet af
+    char quote = 0;
+    char last = c;
+    while (true) {
+        c = get();
+        if (c == -1) {
+            return false;
+        }
+        if (text != NULL) {
+            *text += (char) c;
+        }
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' or c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            type = last == '/' ? emptyTag : startTag;
+            return true;
+        } else if (c != ' ' and c != '\t' and c != '\n') {
+            last = c;
+        }
+    }
+}
+
+bool XmlElementStream::openRoot(const std::string &rootName) {
+    REQUIRE(properlyInitialized(), "The stream must be properly initialized");
+
+    while (true) {
+        int c = get();
+        if (c == -1) {
+            return false;
+        }
+        if (c != '<') {
+            continue;
+        }
+
+        std::string markup;
+        MarkupType type;
+        if (!readMarkup(&markup, type)) {
+            damaged = true;
+            return false;
+        }
+        if (type == otherMarkup) {
+            continue; // De xml declaratie, commentaar, ...
+        }
+        if (type == endTag) {
+            return false;
+        }
+
+        std::size_t nameEnd = markup.find_first_of(" \t\n/>", 1);
+        if (markup.compare(1, nameEnd - 1, rootName) != 0) {
+            return false;
+        }
+        rootOpen = type == startTag;
+        return true;
+    }
+}
+
+bool XmlElementStream::nextElement(std::string &element) {
+    REQUIRE(properlyInitialized(), "The stream must be properly initialized");
+
+    element.clear();
+    while (rootOpen) {
+        int c = get();
+        if (c == -1) {
+            damaged = true;
+            rootOpen = false;
+            break;
+        }
+        if (c != '<') {
+            continue; // Tekst tussen de elementen, zoals bij NextSiblingElement
+        }
+
+        MarkupType type;
+        if (!readMarkup(&element, type)) {
+            damaged = true;
+            rootOpen = false;
+            break;
+        }
+        if (type == endTag) {
+            rootOpen = false; // Het einde van de root
+            break;
+        }
+        if (type == otherMarkup) {
+            element.clear();
+            continue;
+        }
+        if (type == emptyTag) {
+            return true;
+        }
+
+        int depth = 1;
+        while (depth > 0) {
+            c = get();
+            if (c == -1) {
+                damaged = true;
+                rootOpen = false;
+                element.clear();
+                return false;
+            }
+            if (c != '<') {
+                element += (char) c;
+            } else if (!readMarkup(&element, type)) {
+                damaged = true;
+                rootOpen = false;
+                element.clear();
+                return false;
+            } else if (type == startTag) {
+                depth++;
+            } else if (type == endTag) {
+                depth--;
+            }
+        }
+        return true;
+    }
+    element.clear();
+    return false;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file XmlElementStream.h
+ * @brief This header file will contain the XmlElementStream class.
+ *
+ * @author Arno Deceuninck
+ *
+ * @date 17/10/2026
+ */
+
+#ifndef ANTROPSE_XMLELEMENTSTREAM_H
+#define ANTROPSE_XMLELEMENTSTREAM_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * Reads the children of the root element of an xml document one by one, without parsing the whole document
+ *
+ * A stream is read in blocks of BLOCK_SIZE bytes, a document in memory is read in place. Only the structure of the
+ * markup is followed (tags, comments, CDATA sections, declarations and quoted attribute values), enough to know where
+ * each child of the root ends. The complete text of a child is returned, with line endings converted to '\n' like
+ * TiXmlDocument::LoadFile does, so it can be parsed on its own. The memory used is the block plus the largest child of
+ * the root.
+ */
+class XmlElementStream {
+public:
+    /**
+     * @param inStream The stream with the xml document
+     */
+    explicit XmlElementStream(std::istream &inStream);
+
+    /**
+     * Read an xml document from memory, without copying it
+     *
+     * @param data The xml document, which doesn't have to end with '\0'
+     * @param size The number of bytes in the document
+     */
+    XmlElementStream(const char *data, std::size_t size);
+
+    /**
+     * Read until the start tag of the root element
+     *
+     * @param rootName The name the root element must have
+     *
+     * @return true when the first element of the document has the name rootName
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The stream must be properly initialized");
+     */
+    bool openRoot(const std::string &rootName);
+
+    /**
+     * Read the next child element of the root
+     *
+     * @param element The complete text of the child element, from its start tag up to its end tag
+     *
+     * @return true when a child has been read, false at the end tag of the root or at the end of the input
+     *
+     * @pre
+     * REQUIRE(properlyInitialized(), "The stream must be properly initialized");
+     */
+    bool nextElement(std::string &element);
+
+    /**
+     * @return true when the input ended before the root element or one of its children was closed
+     */
+    bool isDamaged() const;
+
+    bool properlyInitialized() const;
+
+    static const unsigned int BLOCK_SIZE = 64 * 1024;
+
+private:
+    enum MarkupType {
+        startTag, endTag, emptyTag, otherMarkup
+    };
+
+    /**
+     * @return The next character of the input, with "\r\n" and "\r" converted to '\n', or -1 at the end of the input
+     */
+    int get();
+
+    /**
+     * Read a piece of markup of which the '<' has already been read, up to and including its closing '>'
+     *
+     * @param text The text of the markup is appended to it, when it's not NULL
+     * @param type The kind of markup that has been read
+     *
+     * @return false when the input ended inside the markup
+     */
+    bool readMarkup(std::string *text, MarkupType &type);
+
+    /**
+     * Read up to and including terminator, appending to text when it's not NULL
+     */
+    bool readUntil(const char *terminator, std::string *text);
+
+    std::istream *inStream; /**< NULL for a document in memory */
+    std::vector<char> buffer; /**< The last block read from inStream */
+    const char *block;
+    std::streamsize position;
+    std::streamsize blockSize;
+    bool previousWasCarriageReturn;
+    bool rootOpen; /**< Whether the start tag of the root has been read and its end tag not */
+    bool damaged;
+
+    XmlElementStream *_initCheck;
+
+    XmlElementStream(const XmlElementStream &);
+
+    XmlElementStream &operator=(const XmlElementStream &);
+};
+
+
+#endif //ANTROPSE_XMLELEMENTSTREAM_H